@@ -0,0 +1,33 @@
+/*
+ * Tryb wiersza poleceń (bez GUI, bez serwera wyświetlania)
+ *
+ *   qr-generator decode [--jobs N] [--decoders LISTA] KATALOG - wsadowe dekodowanie obrazów
+ *   qr-generator bench-decode [opcje] KORPUS - backendy dekodowania klatka po klatce
+ *   qr-generator scan-video [opcje] NAGRANIE - kody z pliku wideo (segmenty równolegle)
+ *   qr-generator encode [opcje] WEJŚCIE      - wsadowe generowanie z CSV/JSONL
+ *   qr-generator serial [opcje]              - seria etykiet z licznikiem
+ *   qr-generator verify-encoder [opcje]      - zgodność i wydajność koderów
+ */
+
+#ifndef CLI_COMMANDS_H
+#define CLI_COMMANDS_H
+
+namespace cli {
+
+// Czy argumenty wskazują polecenie trybu tekstowego (a nie uruchomienie GUI)
+bool isCliInvocation(int argc, char* argv[]);
+
+// Uruchamia polecenie; zwraca kod wyjścia procesu
+int run(int argc, char* argv[]);
+
+// Poszczególne polecenia (argv[1] to nazwa polecenia)
+int runDecode(int argc, char* argv[]);
+int runBenchDecode(int argc, char* argv[]);
+int runScanVideo(int argc, char* argv[]);
+int runEncode(int argc, char* argv[]);
+int runSerial(int argc, char* argv[]);
+int runVerifyEncoder(int argc, char* argv[]);
+
+} // namespace cli
+
+#endif // CLI_COMMANDS_H
@@ -0,0 +1,102 @@
+#ifndef QRCORE_ARCHIVE_WRITER_H
+#define QRCORE_ARCHIVE_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Strumieniowy zapis archiwum ZIP lub TAR bez plików tymczasowych.
+//
+// Wpis jest najpierw przygotowywany (CRC-32, ewentualna kompresja deflate)
+// przez prepare() - funkcję bez stanu, wołaną równolegle w wątkach roboczych.
+// add() jedynie dopisuje gotowe bajty na koniec strumienia, więc archiwum
+// może trafiać również do potoku (np. standardowe wyjście). Na końcu finish()
+// dopisuje indeks manifest.jsonl (nazwa, rozmiar, CRC, przesunięcie) oraz,
+// dla ZIP, katalog centralny (z rozszerzeniami ZIP64 powyżej 65535 wpisów
+// lub 4 GiB). Znaczniki czasu są stałe, więc wynik jest deterministyczny.
+class ArchiveWriter
+{
+public:
+    enum class Format {
+        Zip,
+        Tar
+    };
+
+    enum class Compression {
+        Store,
+        Deflate   // tylko ZIP; wpis jest zapisywany bez kompresji, jeśli się nie zmniejszy
+    };
+
+    struct PreparedEntry {
+        std::string name;
+        std::vector<uint8_t> data;     // bajty do zapisania (ew. skompresowane)
+        uint64_t uncompressedSize = 0;
+        uint32_t crc32 = 0;
+        bool deflated = false;
+    };
+
+    explicit ArchiveWriter(Format format);
+    ~ArchiveWriter();
+
+    ArchiveWriter(const ArchiveWriter&) = delete;
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+    // Ścieżka "-" oznacza standardowe wyjście
+    bool open(const std::string& path);
+
+    // Przygotowanie wpisu - bezpieczne wątkowo, bez dostępu do archiwum
+    static PreparedEntry prepare(const std::string& name, const uint8_t* data, size_t size,
+                                 Compression compression, Format format);
+
+    // Dopisanie przygotowanego wpisu (wywołania są szeregowane). Nazwa
+    // manifest.jsonl jest zarezerwowana dla indeksu - taki wpis trafia do
+    // archiwum jako _manifest.jsonl.
+    bool add(PreparedEntry entry);
+
+    // Manifest, katalog centralny i zamknięcie pliku
+    bool finish();
+
+    std::string errorString() const;
+    uint64_t entryCount() const;
+    Format format() const { return m_format; }
+
+    // Format archiwum na podstawie rozszerzenia (.zip, .tar); false dla innych
+    static bool formatForPath(const std::string& path, Format& format);
+
+private:
+    struct CentralRecord {
+        std::string name;
+        uint64_t offset;
+        uint64_t compressedSize;
+        uint64_t uncompressedSize;
+        uint32_t crc32;
+        bool deflated;
+    };
+
+    bool writeBytes(const void* data, size_t size);
+    bool addLocked(const PreparedEntry& entry);
+    bool writeZipLocalHeader(const PreparedEntry& entry);
+    bool writeTarHeader(const std::string& name, uint64_t size);
+    bool writeZipCentralDirectory();
+
+    Format m_format;
+    std::FILE* m_file = nullptr;
+    bool m_ownsFile = false;
+    uint64_t m_offset = 0;
+    std::vector<CentralRecord> m_records;
+    std::string m_error;
+    bool m_finished = false;
+    mutable std::mutex m_mutex;
+};
+
+// CRC-32 (wielomian IEEE, jak w ZIP/PNG/gzip)
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+
+} // namespace qrcore
+
+#endif // QRCORE_ARCHIVE_WRITER_H
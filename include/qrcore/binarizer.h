@@ -0,0 +1,77 @@
+#ifndef QRCORE_BINARIZER_H
+#define QRCORE_BINARIZER_H
+
+#include <opencv2/core.hpp>
+
+#include <string>
+
+namespace qrcore {
+
+// Metoda progowania lokalnego (obie liczone z obrazów całkowych, koszt
+// na piksel nie zależy od rozmiaru okna)
+enum class BinarizeMethod {
+    None,    // bez wstępnego progowania
+    Bradley, // ciemny, jeśli jaśniejszy niż średnia okna o mniej niż bradleyT
+    Sauvola  // próg ze średniej i odchylenia okna - odporny na odblaski i cienie
+};
+
+// Miejsce progowania w kaskadzie dekodowania
+enum class BinarizeStage {
+    Fallback, // dopiero gdy żaden backend nic nie odczytał ze skali szarości
+    Always    // zawsze, backendy dostają wyłącznie obraz binarny
+};
+
+struct BinarizeOptions {
+    BinarizeMethod method = BinarizeMethod::Sauvola;
+    BinarizeStage stage = BinarizeStage::Fallback;
+    int window = 0;          // bok okna w pikselach; 0 - 1/8 krótszego boku (min. 15)
+    // Wartości mniejsze niż typowe dla dokumentów (k = 0.2-0.5, t = 0.15):
+    // kod QR jest w połowie ciemny, a przy niskim kontraście moduły leżą tuż
+    // pod średnią okna i przy większych wartościach znikałyby
+    double sauvolaK = 0.05;  // czułość Sauvoli na odchylenie
+    double bradleyT = 0.05;  // próg Bradleya jako ułamek średniej
+
+    bool enabled() const { return method != BinarizeMethod::None; }
+};
+
+// Progowanie obrazu w skali szarości (CV_8UC1) do wartości 0/255.
+// Bufory pośrednie (obraz z marginesem, obrazy całkowe) są zachowywane
+// między wywołaniami. Obiekt nie jest bezpieczny wątkowo.
+class Binarizer
+{
+public:
+    Binarizer() = default;
+    explicit Binarizer(const BinarizeOptions& options) : m_options(options) {}
+
+    const BinarizeOptions& options() const { return m_options; }
+    void setOptions(const BinarizeOptions& options) { m_options = options; }
+
+    // Obraz binarny ważny do następnego wywołania; pusty dla nieobsługiwanego
+    // formatu wejścia albo metody None
+    const cv::Mat& apply(const cv::Mat& gray);
+
+private:
+    BinarizeOptions m_options;
+    cv::Mat m_padded;
+    cv::Mat m_sum;
+    cv::Mat m_squares;
+    cv::Mat m_binary;
+};
+
+// Jednorazowe progowanie (nowe bufory przy każdym wywołaniu)
+cv::Mat binarize(const cv::Mat& gray, const BinarizeOptions& options = BinarizeOptions());
+
+// Opis strategii: "off", "bradley", "sauvola", z dopiskiem ":always"
+// dla progowania przed każdym dekodowaniem (np. "sauvola:always");
+// false dla nieznanej nazwy - options pozostaje wtedy bez zmian
+bool parseBinarization(const std::string& text, BinarizeOptions& options);
+
+// Strategia kaskad tworzonych bez jawnych ustawień: ustawiona przez
+// setDefaultBinarization, w przeciwnym razie ze zmiennej środowiskowej
+// QRCORE_BINARIZE, a domyślnie Sauvola jako drugie podejście
+BinarizeOptions defaultBinarization();
+void setDefaultBinarization(const BinarizeOptions& options);
+
+} // namespace qrcore
+
+#endif // QRCORE_BINARIZER_H
@@ -0,0 +1,52 @@
+#ifndef QRCORE_BITMAP_WRITER_H
+#define QRCORE_BITMAP_WRITER_H
+
+#include "qrcore/qr_matrix.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace qrcore {
+
+// Format zapisu rastra 1-bitowego
+enum class BitmapFormat {
+    Png,   // 1 bit na piksel, paleta [biały, czarny], deflate
+    Tiff   // 1 bit na piksel, kompresja CCITT Group 4 (T.6)
+};
+
+// Parametry zapisu rastra
+struct BitmapOptions {
+    int scale = 8;     // liczba pikseli na moduł
+    int border = 4;    // strefa ciszy w modułach
+    double dpi = 0.0;  // rozdzielczość w metadanych (0 = brak pHYs w PNG, 72 w TIFF)
+    int compression = 6; // poziom deflate PNG 1-9; 6 jest ~5x szybszy od 9 przy ~10% większym pliku
+    int size = 0;      // bok w pikselach (0 = (moduły + 2 * border) * scale); dowolny, nie tylko wielokrotność
+    size_t memoryBudget = 32 * 1024 * 1024; // limit pamięci na przetwarzane pasy wierszy
+    bool parallel = true; // pasy kodowane równolegle (cv::parallel_for_)
+};
+
+// Zapisuje symbol jako 1-bitowy PNG lub TIFF G4 prosto z macierzy modułów.
+// Wiersze PNG powielające poprzedni wiersz pikseli są filtrowane filtrem Up
+// (same zera), pozostałe bez filtra - deflate widzi długie ciągi zer zamiast
+// powtórzonych wzorców. Raster powstaje pasami (StripRasterizer), więc
+// szczytowe zużycie pamięci ogranicza memoryBudget niezależnie od boku obrazu;
+// PNG jest zapisywany strumieniowo, z TIFF w pamięci zostają tylko
+// skompresowane pasy. Wynik jest deterministyczny (bez dat w metadanych,
+// podział na pasy niezależny od liczby wątków).
+bool writeBitmap(const QRMatrix& matrix, BitmapFormat format, std::ostream& output,
+                 const BitmapOptions& options = BitmapOptions());
+
+// Zapisuje gotowy raster Mono (MSB pierwszy, bit ustawiony = ciemny) o boku
+// size pikseli, np. utrzymywany przez rasterizeModules dla serii etykiet;
+// pola scale, border i size z options są pomijane
+bool writeBitmap(const uint8_t* raster, int size, size_t bytesPerLine, BitmapFormat format,
+                 std::ostream& output, const BitmapOptions& options = BitmapOptions());
+
+// Format na podstawie rozszerzenia pliku (.png, .tif, .tiff); false dla innych
+bool bitmapFormatForPath(const std::string& path, BitmapFormat& format);
+
+} // namespace qrcore
+
+#endif // QRCORE_BITMAP_WRITER_H
@@ -0,0 +1,116 @@
+#ifndef QRCORE_CAMERA_PIPELINE_H
+#define QRCORE_CAMERA_PIPELINE_H
+
+#include "qrcore/ring_buffer.h"
+#include "qrcore/structured_append.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtGui/QPolygonF>
+
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace qrcore {
+
+// Klatka przekazywana z wątku przechwytywania do dekoderów
+struct CapturedFrame {
+    cv::Mat image;
+    uint64_t index = 0;
+    std::chrono::steady_clock::time_point captured;
+};
+
+// Potok odczytu kodów z kamery:
+//
+//   wątek przechwytywania -> RingBuffer (porzuca najstarsze) -> N dekoderów
+//
+// Przechwytywanie działa z natywną częstotliwością kamery, a wyniki trafiają
+// do odbiorców sygnałami (połączenia kolejkowane do wątku odbiorcy), więc
+// wątek GUI nigdy nie czeka na dekodowanie. Części Structured Append są
+// zbierane z kolejnych klatek, a codeDecoded otrzymuje dopiero całą wiadomość.
+class CameraPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        uint64_t captured = 0;   // klatki odczytane z kamery
+        uint64_t dropped = 0;    // klatki porzucone przy pełnym buforze
+        uint64_t decoded = 0;    // klatki przetworzone przez dekodery
+        uint64_t found = 0;      // klatki z odczytanym kodem
+    };
+
+    explicit CameraPipeline(QObject* parent = nullptr);
+    ~CameraPipeline() override;
+
+    // Liczba wątków dekodujących (0 = liczba rdzeni - 1, min. 1)
+    void setWorkerCount(int count) { m_workerCount = count; }
+    // Pojemność bufora klatek (małe wartości = mniejsze opóźnienie)
+    void setBufferCapacity(size_t capacity) { m_bufferCapacity = capacity; }
+
+    // Otwiera kamerę i uruchamia wątki. Zwraca false, jeśli kamery nie da się otworzyć.
+    bool start(int deviceIndex = 0);
+    // Odtwarza plik wideo w miejsce kamery - z zapisaną częstotliwością
+    // klatek (domyślnie 30/s), więc dekodery widzą ten sam strumień co na
+    // żywo. Po ostatniej klatce potok zatrzymuje się z sygnałem sourceFinished.
+    bool startFile(const std::string& path);
+    // Zatrzymuje przechwytywanie i czeka na zakończenie wątków
+    void stop();
+    bool isRunning() const { return m_running.load(); }
+
+    Stats stats() const;
+
+signals:
+    // Odczytano kod (treść w postaci surowych bajtów)
+    void codeDecoded(const QByteArray& payload, const QPolygonF& corners);
+    // Odczytano część serii Structured Append (received z total części)
+    void structuredAppendProgress(int received, int total);
+    // Kamera przestała dostarczać klatki
+    void captureFailed(const QString& message);
+    // Odtwarzany plik wideo dobiegł końca
+    void sourceFinished();
+
+private:
+    void startThreads();
+    void captureLoop();
+    void decodeLoop();
+    void collectStructuredAppend(const cv::Mat& image, const DecodeResult& part);
+    void publish(const DecodeResult& result);
+
+    cv::VideoCapture m_capture;
+    bool m_fromFile = false;
+    std::chrono::steady_clock::duration m_frameInterval{}; // odstęp klatek pliku
+    std::unique_ptr<RingBuffer<CapturedFrame>> m_frames;
+    std::thread m_captureThread;
+    std::vector<std::thread> m_workers;
+
+    // Usypianie dekoderów przy pustym buforze (same dane idą bez blokad)
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+
+    // Części Structured Append wspólne dla wszystkich dekoderów
+    std::mutex m_structuredAppendMutex;
+    StructuredAppendCollector m_structuredAppend;
+
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_captured{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_decoded{0};
+    std::atomic<uint64_t> m_found{0};
+
+    int m_workerCount = 0;
+    size_t m_bufferCapacity = 4;
+};
+
+} // namespace qrcore
+
+#endif // QRCORE_CAMERA_PIPELINE_H
@@ -0,0 +1,32 @@
+#ifndef QRCORE_DECODE_RESULT_H
+#define QRCORE_DECODE_RESULT_H
+
+#include <opencv2/core.hpp>
+
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Nagłówek Structured Append odczytany z symbolu (index < 0 - symbol samodzielny)
+struct StructuredAppendInfo {
+    int index = -1;     // numer symbolu w serii, od 0
+    int total = 0;      // liczba symboli serii (1-16)
+    int parity = 0;     // parzystość całej wiadomości zapisana w nagłówku
+    int dataParity = 0; // XOR bajtów danych tego symbolu
+
+    bool isValid() const { return index >= 0; }
+};
+
+// Wynik dekodowania pojedynczego symbolu
+struct DecodeResult {
+    std::string text;                 // zdekodowana treść
+    std::vector<cv::Point2f> corners; // narożniki symbolu w układzie obrazu
+    StructuredAppendInfo structuredAppend; // część serii Structured Append
+
+    bool isValid() const { return !text.empty(); }
+};
+
+} // namespace qrcore
+
+#endif // QRCORE_DECODE_RESULT_H
@@ -0,0 +1,115 @@
+#ifndef QRCORE_DECODER_BACKEND_H
+#define QRCORE_DECODER_BACKEND_H
+
+#include "qrcore/binarizer.h"
+#include "qrcore/decode_result.h"
+
+#include <opencv2/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Backend dekodowania - odczyt kodów z obrazu w skali szarości (CV_8UC1).
+// Dostępne implementacje:
+//   "native" - własny detektor (finder_detector.h), najtańszy, zawsze dostępny;
+//              do 4 symboli na obraz, więc pomijany przy odczycie wielu kodów
+//   "quirc"  - libquirc, bardzo szybki, słabszy przy uszkodzonych symbolach
+//              (opcja CMake QRCORE_WITH_QUIRC)
+//   "zxing"  - ZXing-cpp, odporny na uszkodzenia i zniekształcenia
+//              (opcja CMake QRCORE_WITH_ZXING)
+//   "opencv" - cv::QRCodeDetector, zawsze dostępny
+// Obiekt backendu nie jest bezpieczny wątkowo - każdy wątek tworzy własny.
+class DecoderBackend
+{
+public:
+    virtual ~DecoderBackend() = default;
+
+    virtual const char* name() const = 0;
+
+    // Wszystkie kody obrazu (multiple) albo tylko pierwszy znaleziony;
+    // narożniki w układzie przekazanego obrazu
+    virtual std::vector<DecodeResult> decode(const cv::Mat& gray, bool multiple) = 0;
+};
+
+// Nazwy backendów wkompilowanych w bibliotekę, od najtańszego
+std::vector<std::string> availableDecoderBackends();
+
+// Nowy backend o danej nazwie; nullptr dla nieznanej lub niewkompilowanej
+std::unique_ptr<DecoderBackend> createDecoderBackend(const std::string& name);
+
+// Lista nazw rozdzielonych przecinkami ("quirc,opencv"); pusta, gdy któraś
+// nazwa jest nieznana albo backend nie został wkompilowany
+std::vector<std::string> parseDecoderBackends(const std::string& list);
+
+// Kaskada używana przez DecoderContext i decodeMulti: ustawiona przez
+// setDecoderCascade, w przeciwnym razie ze zmiennej środowiskowej
+// QRCORE_DECODERS (np. "quirc,opencv"), a domyślnie wszystkie dostępne
+// backendy od najtańszego
+std::vector<std::string> decoderCascade();
+
+// Ustawia kaskadę dla nowo tworzonych kontekstów (pusta lista - domyślna).
+// false, gdy lista zawiera nieznany backend; ustawienie się wtedy nie zmienia.
+bool setDecoderCascade(const std::vector<std::string>& names);
+
+// Statystyki backendu zbierane przez wszystkie kaskady procesu
+struct DecoderBackendStats {
+    std::string name;
+    uint64_t attempts = 0;     // obrazy przekazane backendowi
+    uint64_t successes = 0;    // obrazy, w których backend odczytał kod
+    uint64_t microseconds = 0; // łączny czas dekodowania
+
+    double successRate() const { return attempts ? static_cast<double>(successes) / attempts : 0.0; }
+    double meanMilliseconds() const { return attempts ? microseconds / 1000.0 / attempts : 0.0; }
+};
+
+// Migawka statystyk wszystkich wkompilowanych backendów
+std::vector<DecoderBackendStats> decoderBackendStats();
+void resetDecoderBackendStats();
+
+// Kaskada "najpierw tani": przy odczycie jednego kodu kolejny backend jest
+// wywoływany tylko wtedy, gdy poprzednie nic nie odczytały, więc typowa
+// klatka kosztuje tyle, ile najszybszy backend, a cięższe pracują tylko na
+// trudnych obrazach. Przy odczycie wszystkich kodów (multiple) pracują
+// wszystkie backendy - tani mógł odczytać tylko część symboli - a wyniki
+// są łączone przez mergeDuplicates; "native" (do 4 symboli) jest wtedy
+// pomijany, chyba że jest jedynym backendem kaskady.
+// Backendy są tworzone przy pierwszym użyciu. Przed backendami (albo po
+// porażce wszystkich) obraz może przejść progowanie lokalne - patrz
+// BinarizeOptions; domyślnie według defaultBinarization().
+// Kaskada nie jest bezpieczna wątkowo - każdy wątek używa własnej.
+class DecoderCascade
+{
+public:
+    // Kaskada według decoderCascade()
+    DecoderCascade();
+    // Nieznane nazwy są pomijane; pusta lista - kaskada według decoderCascade()
+    explicit DecoderCascade(const std::vector<std::string>& names);
+
+    std::vector<DecodeResult> decode(const cv::Mat& gray, bool multiple);
+
+    // Nazwy backendów w kolejności wywołań
+    std::vector<std::string> names() const;
+
+    const BinarizeOptions& binarization() const { return m_binarizer.options(); }
+    void setBinarization(const BinarizeOptions& options) { m_binarizer.setOptions(options); }
+
+private:
+    struct Stage {
+        size_t backend = 0; // indeks w tablicy wkompilowanych backendów
+        std::unique_ptr<DecoderBackend> instance;
+    };
+
+    std::vector<DecodeResult> decodeStages(const cv::Mat& gray, bool multiple);
+
+    std::vector<Stage> m_stages;
+    Binarizer m_binarizer;
+};
+
+} // namespace qrcore
+
+#endif // QRCORE_DECODER_BACKEND_H
@@ -0,0 +1,41 @@
+#ifndef QRCORE_FINDER_DETECTOR_H
+#define QRCORE_FINDER_DETECTOR_H
+
+#include "qrcore/decode_result.h"
+
+#include <opencv2/core.hpp>
+
+#include <vector>
+
+namespace qrcore {
+
+// Własny detektor kodów QR (backend "native"), pomyślany dla stanowisk
+// skanujących z pełną szybkością linii:
+//
+//   progi lokalne (bloki 32x32, SSE2) -> biegi wierszy 1:1:3:1:1 (SSE2)
+//   -> kontrola w kolumnie i ponownie w wierszu -> grupowanie kandydatów
+//   -> trójki wzorców (kąt prosty) -> wzorzec wyrównania -> homografia
+//   -> próbkowanie siatki (interpolacja dwuliniowa) -> readSymbol (RS)
+//
+// Nie wymaga cv::QRCodeDetector ani innych bibliotek; działa na obrazach
+// w skali szarości (CV_8UC1). Rozpoznaje symbole bez silnych zniekształceń
+// nieliniowych - trudniejsze obrazy zostają dla dalszych backendów kaskady.
+// Składa najwyżej 12 najlepszych wzorców (do 4 symboli), dlatego kaskada
+// używa go tylko przy odczycie jednego kodu (kamera, wideo, pojedyncze obrazy).
+
+// Środek wzorca wyszukiwania w układzie obrazu
+struct FinderPattern {
+    cv::Point2f center;
+    float moduleSize = 0.0f; // szacowany bok modułu w pikselach
+    int hits = 0;            // liczba wierszy, w których wzorzec potwierdzono
+};
+
+// Wzorce wyszukiwania znalezione w obrazie, od najczęściej potwierdzonych
+std::vector<FinderPattern> findFinderPatterns(const cv::Mat& gray);
+
+// Wyszukiwanie i odczyt symboli; przy multiple = false kończy na pierwszym
+std::vector<DecodeResult> detectAndDecodeNative(const cv::Mat& gray, bool multiple = false);
+
+} // namespace qrcore
+
+#endif // QRCORE_FINDER_DETECTOR_H
@@ -0,0 +1,122 @@
+#ifndef QRCORE_FOUNTAIN_H
+#define QRCORE_FOUNTAIN_H
+
+#include "qrcore/qr_encoder.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Transmisja animowana: wiadomość dzielona na K bloków i nadawana jako
+// nieskończony ciąg ramek kodu fontannowego LT (Luby Transform). Ramka
+// o numerze n < K niesie blok n wprost, dalsze - XOR bloków wylosowanych
+// (generator zależny tylko od numeru ramki) o stopniu z rozkładu solitonu
+// odpornego. Odbiorca składa wiadomość z dowolnego wystarczającego podzbioru
+// ramek (zwykle kilka procent więcej niż K), bez względu na kolejność
+// i zgubione klatki.
+//
+// Ramka to tekst "QF:" + Base45 (RFC 9285) nagłówka i danych - mieści się
+// w trybie alfanumerycznym (5,5 bitu na znak, ok. 8,25 bitu na bajt danych)
+// i przechodzi bez zmian przez każdy dekoder zwracający tekst.
+// Nagłówek (17 bajtów, big-endian): wersja formatu, identyfikator transmisji
+// (CRC-32 wiadomości), długość wiadomości, rozmiar bloku, numer ramki, stopień.
+
+// Rozmiar nagłówka ramki w bajtach (przed Base45)
+constexpr int kFountainHeaderSize = 17;
+
+// Największy plik transmisji - większe wymagałyby minut animacji
+constexpr size_t kMaxTransferFileSize = 16 * 1024 * 1024;
+
+// Największa wiadomość: plik z nagłówkiem nazwy (packTransferFile)
+constexpr size_t kMaxFountainMessageSize = kMaxTransferFileSize + 2 + 0xFFFF;
+
+// Największa liczba bloków (plik 16 MiB w blokach wersji 10). Odbiorca
+// odrzuca ramki z większą liczbą bloków przed przydzieleniem stanu -
+// nagłówek pochodzi z obrazu i nie może decydować o rozmiarze alokacji.
+constexpr int kMaxFountainBlocks = 1 << 17;
+
+class FountainEncoder
+{
+public:
+    FountainEncoder() = default;
+    // Koder pusty (isNull) dla wiadomości ponad kMaxFountainMessageSize
+    // albo podziału na więcej niż kMaxFountainBlocks bloków
+    FountainEncoder(const std::string& message, int blockSize);
+
+    bool isNull() const { return m_blockCount == 0; }
+    uint32_t transferId() const { return m_transferId; }
+    int blockCount() const { return m_blockCount; }
+    int blockSize() const { return m_blockSize; }
+    size_t messageSize() const { return m_messageSize; }
+
+    // Tekst ramki o danym numerze (kolejne numery = kolejne klatki animacji)
+    std::string frame(uint32_t seed) const;
+
+    // Największy blok, z którym ramka mieści się w symbolu danej wersji; 0, gdy żaden
+    static int blockSizeFor(int version, ErrorCorrection level);
+
+private:
+    std::string m_message; // dopełniona zerami do wielokrotności bloku
+    size_t m_messageSize = 0;
+    uint32_t m_transferId = 0;
+    int m_blockSize = 0;
+    int m_blockCount = 0;
+};
+
+class FountainDecoder
+{
+public:
+    enum class FrameStatus {
+        NotFountain,    // tekst nie jest ramką transmisji
+        OtherTransfer,  // ramka innej transmisji niż bieżąca
+        Duplicate,      // ramka już odebrana (np. ta sama klatka dwukrotnie)
+        Accepted
+    };
+
+    FrameStatus addFrame(const std::string& text);
+
+    bool isStarted() const { return m_blockCount > 0; }
+    bool isComplete() const { return isStarted() && m_resolved == m_blockCount; }
+    uint32_t transferId() const { return m_transferId; }
+    int blockCount() const { return m_blockCount; }
+    int blockSize() const { return m_blockSize; }
+    int resolvedBlocks() const { return m_resolved; }
+    size_t messageSize() const { return m_messageSize; }
+    size_t acceptedFrames() const { return m_seen.size(); }
+
+    // Złożona wiadomość; false przed ukończeniem lub przy niezgodnej sumie CRC-32
+    bool message(std::string& output) const;
+
+    void reset();
+
+private:
+    struct Pending {
+        std::vector<uint32_t> neighbors; // jeszcze nieznane bloki
+        std::string data;
+        bool done = false;
+    };
+
+    void resolve(uint32_t block, std::string data);
+
+    uint32_t m_transferId = 0;
+    size_t m_messageSize = 0;
+    int m_blockSize = 0;
+    int m_blockCount = 0;
+    int m_resolved = 0;
+
+    std::vector<uint32_t> m_seen;               // posortowane numery odebranych ramek
+    std::vector<std::string> m_blocks;          // bloki odtworzone (puste - nieznane)
+    std::vector<Pending> m_pending;             // ramki czekające na brakujące bloki
+    std::vector<std::vector<size_t>> m_waiting; // blok -> ramki, które go zawierają
+};
+
+// Plik w wiadomości transmisji: długość nazwy (2 bajty), nazwa bez ścieżki, zawartość
+std::string packTransferFile(const std::string& name, const std::string& contents);
+bool unpackTransferFile(const std::string& message, std::string& name, std::string& contents);
+
+} // namespace qrcore
+
+#endif // QRCORE_FOUNTAIN_H
@@ -0,0 +1,31 @@
+#ifndef QRCORE_IMAGE_BRIDGE_H
+#define QRCORE_IMAGE_BRIDGE_H
+
+#include "qrcore/qr_decoder.h"
+
+#include <QtGui/QImage>
+
+#include <opencv2/core.hpp>
+
+#include <vector>
+
+namespace qrcore {
+
+// Widok cv::Mat na bufor QImage - bez kopiowania pikseli.
+// Obraz musi żyć dłużej niż widok. Obsługiwane formaty:
+//   Format_RGB32 / Format_ARGB32(_Premultiplied) -> CV_8UC4 (kolejność BGRA)
+//   Format_Grayscale8                             -> CV_8UC1
+// Dla pozostałych formatów zwracana jest pusta macierz.
+cv::Mat wrapImage(const QImage& image);
+
+// Skala szarości w jednym przebiegu (np. BGRA -> gray bez pośredniego RGB888).
+// Formaty nieobsługiwane przez wrapImage() są najpierw konwertowane przez Qt.
+cv::Mat grayFromImage(const QImage& image);
+
+// Dekoduje równolegle kilka obrazów (np. zrzuty wszystkich ekranów).
+// Wynik i-ty odpowiada obrazowi i-temu; współrzędne w układzie danego obrazu.
+std::vector<std::vector<DecodeResult>> decodeImages(const std::vector<QImage>& images);
+
+} // namespace qrcore
+
+#endif // QRCORE_IMAGE_BRIDGE_H
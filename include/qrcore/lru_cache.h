@@ -0,0 +1,140 @@
+#ifndef QRCORE_LRU_CACHE_H
+#define QRCORE_LRU_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace qrcore {
+
+// Statystyki pamięci podręcznej
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t usedBytes = 0;
+    size_t budgetBytes = 0;
+
+    double hitRate() const
+    {
+        const uint64_t total = hits + misses;
+        return total ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+// Pamięć podręczna LRU ograniczona budżetem pamięci.
+// Koszt wpisu podaje wywołujący (w bajtach); po przekroczeniu budżetu
+// usuwane są najdawniej używane wpisy. Wszystkie metody są bezpieczne
+// wątkowo - z pamięci korzystają równocześnie wątki robocze.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache
+{
+public:
+    explicit LruCache(size_t budgetBytes) : m_budget(budgetBytes) {}
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    // Zwraca true i kopię wartości, jeśli klucz jest w pamięci
+    bool find(const Key& key, Value& value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            ++m_misses;
+            return false;
+        }
+
+        // Przesuń wpis na początek listy (najświeższy)
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        value = it->second->value;
+        ++m_hits;
+        return true;
+    }
+
+    // Wstawia lub podmienia wpis. Wpisy droższe niż cały budżet są pomijane.
+    void insert(const Key& key, Value value, size_t cost)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            m_used -= it->second->cost;
+            m_entries.erase(it->second);
+            m_index.erase(it);
+        }
+
+        if (cost > m_budget) {
+            return;
+        }
+
+        m_entries.push_front(Entry{key, std::move(value), cost});
+        m_index.emplace(key, m_entries.begin());
+        m_used += cost;
+        evict();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_index.clear();
+        m_used = 0;
+    }
+
+    void setBudget(size_t budgetBytes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_budget = budgetBytes;
+        evict();
+    }
+
+    CacheStats stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        CacheStats stats;
+        stats.hits = m_hits;
+        stats.misses = m_misses;
+        stats.evictions = m_evictions;
+        stats.entries = m_entries.size();
+        stats.usedBytes = m_used;
+        stats.budgetBytes = m_budget;
+        return stats;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        size_t cost;
+    };
+
+    // Wymaga zablokowanego m_mutex
+    void evict()
+    {
+        while (m_used > m_budget && !m_entries.empty()) {
+            const Entry& last = m_entries.back();
+            m_used -= last.cost;
+            m_index.erase(last.key);
+            m_entries.pop_back();
+            ++m_evictions;
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::list<Entry> m_entries;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> m_index;
+    size_t m_budget;
+    size_t m_used = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+};
+
+} // namespace qrcore
+
+#endif // QRCORE_LRU_CACHE_H
@@ -0,0 +1,32 @@
+#ifndef QRCORE_MULTI_DECODER_H
+#define QRCORE_MULTI_DECODER_H
+
+#include "qrcore/qr_decoder.h"
+
+#include <opencv2/core.hpp>
+
+#include <vector>
+
+namespace qrcore {
+
+// Parametry wyszukiwania wielu kodów na jednym obrazie
+struct MultiDecodeOptions {
+    int tileSize = 1024;   // bok kafelka w pikselach
+    int overlap = 256;     // zakładka kafelków - powinna przekraczać bok największego kodu
+    bool parallel = true;  // przeszukiwanie kafelków na wszystkich rdzeniach
+};
+
+// Dzieli obraz na zachodzące na siebie kafelki, przeszukuje je równolegle
+// (kaskada backendów, decoderCascade()) i usuwa duplikaty kodów znalezionych w zakładkach.
+// Zwraca wszystkie odczytane kody wraz z wielokątami w układzie całego obrazu,
+// posortowane od lewego górnego rogu.
+std::vector<DecodeResult> decodeMulti(const cv::Mat& image,
+                                      const MultiDecodeOptions& options = MultiDecodeOptions());
+
+// Łączy wyniki, usuwając powtórzenia tego samego kodu (ta sama treść,
+// nakładające się położenie). Przy powtórzeniu zostaje większy wielokąt.
+std::vector<DecodeResult> mergeDuplicates(std::vector<DecodeResult> results);
+
+} // namespace qrcore
+
+#endif // QRCORE_MULTI_DECODER_H
@@ -0,0 +1,37 @@
+#ifndef QRCORE_PAYLOAD_H
+#define QRCORE_PAYLOAD_H
+
+#include <QtCore/QString>
+
+namespace qrcore {
+
+// Dane kontaktowe zapisywane w formacie vCard 3.0
+struct ContactData {
+    QString firstName;
+    QString lastName;
+    QString phone;
+    QString email;
+    QString company;
+    QString website;
+};
+
+// Dane sieci WiFi (format WIFI:T:...;S:...;P:...;H:...;;)
+struct WiFiData {
+    QString ssid;
+    QString password;
+    QString security = "WPA";  // WPA, WEP, nopass
+    bool hidden = false;
+};
+
+// Adres URL z dodanym protokołem https://, jeśli go brakuje
+QString urlPayload(const QString& url);
+
+// vCard z niepustych pól (pusty tekst, gdy wszystkie pola są puste)
+QString vCardPayload(const ContactData& contact);
+
+// Tekst konfiguracji WiFi (pusty tekst, gdy brak SSID)
+QString wifiPayload(const WiFiData& wifi);
+
+} // namespace qrcore
+
+#endif // QRCORE_PAYLOAD_H
@@ -0,0 +1,55 @@
+#ifndef QRCORE_PHOTO_DECODER_H
+#define QRCORE_PHOTO_DECODER_H
+
+#include "qrcore/pyramid_decoder.h"
+
+#include <opencv2/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Parametry odczytu zdjęć z pliku (przyjmowanie zdjęć z telefonów, 12-48 Mpx)
+struct PhotoDecodeOptions {
+    bool reducedJpeg = true;   // JPEG najpierw w pomniejszeniu 1/2, 1/4 albo 1/8
+    int minReducedSide = 1500; // dłuższy bok pomniejszenia nie mniejszy niż ten
+    int minCodeSide = 120;     // kod o krótszym boku (w pikselach pomniejszenia)
+                               // wymusza przejście na większą rozdzielczość
+    PyramidOptions pyramid;    // dekodowanie przebiegu w pełnej rozdzielczości
+                               // (pomniejszone: jeden poziom, bez fullResolutionFallback)
+};
+
+// Przebieg odczytu - do raportów i pomiarów
+struct PhotoDecodeInfo {
+    cv::Size fullSize;         // rozmiar pełnego obrazu (pusty - nie wczytano)
+    int reduction = 1;         // najmniejsze pomniejszenie, w którym odczytano kod (1 - pełny)
+    int passes = 0;            // liczba dekompresji obrazu
+};
+
+// Wymiary obrazu JPEG z nagłówka SOF - bez dekompresji; false dla innych formatów
+bool jpegSize(const uint8_t* data, size_t size, cv::Size& imageSize);
+
+// Odczyt wszystkich kodów z zakodowanego obrazu (zawartość pliku).
+// Obraz jest dekompresowany tylko w skali szarości. JPEG jest najpierw
+// dekompresowany w pomniejszeniu (skalowanie w dziedzinie DCT - libjpeg
+// pomija większość IDCT), a kolejne, dwa razy większe przebiegi aż do
+// pełnej rozdzielczości są wykonywane tylko wtedy, gdy nie znaleziono kodu
+// albo któryś ze znalezionych jest mniejszy niż minCodeSide. Tylko ostatni
+// przebieg przeszukuje cały kadr w kafelkach (decodeMulti). Wyniki wszystkich
+// przebiegów są łączone bez powtórzeń (mergeDuplicates).
+// Narożniki są zawsze w układzie pełnego obrazu.
+std::vector<DecodeResult> decodePhoto(const std::vector<uint8_t>& data,
+                                      const PhotoDecodeOptions& options = PhotoDecodeOptions(),
+                                      PhotoDecodeInfo* info = nullptr);
+
+// Jak wyżej, dla pliku (wczytywanego do pamięci raz dla wszystkich przebiegów)
+std::vector<DecodeResult> decodePhotoFile(const std::string& path,
+                                          const PhotoDecodeOptions& options = PhotoDecodeOptions(),
+                                          PhotoDecodeInfo* info = nullptr);
+
+} // namespace qrcore
+
+#endif // QRCORE_PHOTO_DECODER_H
@@ -0,0 +1,42 @@
+#ifndef QRCORE_PYRAMID_DECODER_H
+#define QRCORE_PYRAMID_DECODER_H
+
+#include "qrcore/multi_decoder.h"
+
+#include <opencv2/core.hpp>
+
+#include <vector>
+
+namespace qrcore {
+
+// Parametry dekodowania piramidowego (duże zdjęcia, zrzuty 4K/8K)
+struct PyramidOptions {
+    int coarseSide = 1024;     // dłuższy bok najmniejszego poziomu piramidy
+    int maxLevels = 5;         // maksymalna liczba zmniejszeń o połowę
+    double cropPadding = 0.3;  // margines wycinka jako ułamek boku kandydata
+    bool parallel = true;      // równoległe dekodowanie wycinków
+    bool fullResolutionFallback = true; // gdy piramida nic nie znajdzie
+    bool findSmall = false;    // przeszukiwanie dokładniejszych poziomów także po
+                               // odczytaniu wszystkich kandydatów (małe kody obok dużych)
+    int minCodeSide = 0;       // najmniejszy szukany bok kodu w pikselach obrazu -
+                               // ogranicza najdokładniejszy poziom (0 - do 1/2)
+};
+
+// Liczba poziomów (zmniejszeń o połowę) dobrana do rozmiaru obrazu
+int pyramidLevels(const cv::Size& size, const PyramidOptions& options = PyramidOptions());
+
+// Dekodowanie "od zgrubnego do dokładnego": kandydaci (wzorce wyszukiwania)
+// są lokalizowani na pomniejszonym obrazie, a dekodowane są tylko odpowiadające
+// im wycinki w pełnej rozdzielczości. Wyszukiwanie zaczyna się od najmniejszego
+// poziomu i schodzi na dokładniejszy tylko wtedy, gdy zostali nieodczytani
+// kandydaci, gdy ustawiono findSmall albo gdy nic nie znaleziono, a nie będzie
+// przeszukania pełnej rozdzielczości - nie głębiej niż do poziomu, na którym
+// kod o boku minCodeSide jest jeszcze widoczny dla lokalizatora. Kody odczytane
+// na poziomie zgrubnym są zamalowywane na dokładniejszych. Gdy piramida nic nie
+// znajdzie - opcjonalnie pełna rozdzielczość w kafelkach (decodeMulti).
+std::vector<DecodeResult> decodePyramid(const cv::Mat& image,
+                                        const PyramidOptions& options = PyramidOptions());
+
+} // namespace qrcore
+
+#endif // QRCORE_PYRAMID_DECODER_H
@@ -0,0 +1,60 @@
+#ifndef QRCORE_QR_DECODER_H
+#define QRCORE_QR_DECODER_H
+
+#include "qrcore/decode_result.h"
+#include "qrcore/decoder_backend.h"
+
+#include <opencv2/core.hpp>
+
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Trwały kontekst dekodowania dla ciągłego skanowania (kamera, wideo).
+//
+// Kontekst przechowuje kaskadę backendów (DecoderCascade) i bufor skali
+// szarości między wywołaniami, konwertuje obraz do skali szarości tylko raz
+// i pamięta położenie ostatnio znalezionego symbolu. Kolejna klatka jest
+// najpierw przeszukiwana w obszarze wokół tego położenia, a dopiero po
+// porażce w całym kadrze.
+// Kontekst nie jest bezpieczny wątkowo - każdy wątek używa własnego.
+class DecoderContext
+{
+public:
+    DecoderContext() = default;
+    // Kontekst z własną kolejnością backendów zamiast decoderCascade()
+    explicit DecoderContext(const std::vector<std::string>& backends) : m_cascade(backends) {}
+
+    DecodeResult decode(const cv::Mat& image);
+
+    // Strategia progowania lokalnego (domyślnie defaultBinarization())
+    void setBinarization(const BinarizeOptions& options) { m_cascade.setBinarization(options); }
+
+    // Zapomina ostatnie położenie symbolu (np. po zmianie źródła obrazu)
+    void reset() { m_lastCorners.clear(); }
+
+    // Margines obszaru śledzenia jako ułamek boku ostatniego symbolu
+    void setRoiPadding(double padding) { m_roiPadding = padding; }
+
+    // Ile razy wynik pochodził z obszaru śledzenia (bez pełnego przeszukania)
+    uint64_t roiHits() const { return m_roiHits; }
+
+private:
+    const cv::Mat& toGray(const cv::Mat& image);
+    bool detectIn(const cv::Mat& gray, const cv::Rect& area, DecodeResult& result);
+
+    DecoderCascade m_cascade;
+    cv::Mat m_gray;
+    std::vector<cv::Point2f> m_lastCorners;
+    double m_roiPadding = 0.5;
+    uint64_t m_roiHits = 0;
+};
+
+// Dekoduje pierwszy znaleziony kod QR z obrazu (BGR, BGRA lub skala szarości).
+// Zwraca nieważny wynik, jeśli kodu nie znaleziono.
+DecodeResult decode(const cv::Mat& image);
+
+} // namespace qrcore
+
+#endif // QRCORE_QR_DECODER_H
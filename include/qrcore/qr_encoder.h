@@ -0,0 +1,71 @@
+#ifndef QRCORE_QR_ENCODER_H
+#define QRCORE_QR_ENCODER_H
+
+#include "qrcore/qr_matrix.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Poziom korekcji błędów (L ~7%, M ~15%, Q ~25%, H ~30%)
+enum class ErrorCorrection {
+    Low,
+    Medium,
+    Quartile,
+    High
+};
+
+// Implementacja kodera
+enum class EncoderBackend {
+    LibQrencode,  // libqrencode (QRcode_encodeString / QRinput)
+    Native        // wbudowany koder qrcore (tablice GF(256) w czasie kompilacji)
+};
+
+// Parametry kodowania symbolu
+struct EncodeOptions {
+    ErrorCorrection ecLevel = ErrorCorrection::Medium;
+    int version = 0;            // 0 = automatyczny dobór wersji
+    bool caseSensitive = true;
+    EncoderBackend backend = EncoderBackend::LibQrencode;
+    bool parallelMasks = false; // ocena ośmiu masek równolegle (tylko Native)
+    bool optimizeSegments = true; // optymalny podział na tryby; false = QR_MODE_8 jak dawniej
+    bool allowKanji = false;    // tryb Kanji (Shift JIS) dla znaków japońskich
+};
+
+// Tryb segmentu danych
+enum class SegmentMode {
+    Numeric,       // cyfry 0-9
+    Alphanumeric,  // 0-9, A-Z, spacja, $%*+-./:
+    Byte,          // dowolne bajty
+    Kanji,         // znaki dwubajtowe Shift JIS (0x8140-0x9FFC, 0xE040-0xEBBF)
+    StructuredAppend // nagłówek Structured Append (musi być pierwszym segmentem)
+};
+
+// Segment danych w jednym trybie; data zawiera bajty/znaki ASCII segmentu
+// (dla Kanji - pary bajtów Shift JIS, dla StructuredAppend - trzy bajty:
+// liczba symboli 1-16, numer symbolu od 1, parzystość - jak w libqrencode)
+struct Segment {
+    SegmentMode mode = SegmentMode::Byte;
+    std::string data;
+};
+
+// Porównanie i skrót parametrów - wykorzystywane jako część klucza cache.
+// Nowe pola EncodeOptions muszą zostać uwzględnione w obu funkcjach.
+bool operator==(const EncodeOptions& a, const EncodeOptions& b);
+inline bool operator!=(const EncodeOptions& a, const EncodeOptions& b) { return !(a == b); }
+size_t hashValue(const EncodeOptions& options);
+
+// Koduje dane (UTF-8) do macierzy modułów.
+// Zwraca pustą macierz (isNull()), jeśli danych nie da się zakodować.
+QRMatrix encode(const std::string& data, const EncodeOptions& options = EncodeOptions());
+
+// Koduje gotowy podział na segmenty (bez automatycznego doboru trybów).
+// Oba backendy dostają identyczny strumień bitów, więc ich wyniki można
+// porównywać moduł po module. Pole caseSensitive jest tu ignorowane.
+QRMatrix encodeSegments(const std::vector<Segment>& segments, const EncodeOptions& options = EncodeOptions());
+
+} // namespace qrcore
+
+#endif // QRCORE_QR_ENCODER_H
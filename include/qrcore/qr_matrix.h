@@ -0,0 +1,59 @@
+#ifndef QRCORE_QR_MATRIX_H
+#define QRCORE_QR_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace qrcore {
+
+// Macierz modułów symbolu QR (bez strefy ciszy).
+// Moduł "ciemny" odpowiada czarnemu pikselowi na wydruku.
+//
+// Moduły są upakowane bitowo: każdy wiersz zajmuje wordsPerRow() słów
+// 64-bitowych, moduł x leży w bicie (x % 64) słowa (x / 64). Bity poza
+// szerokością symbolu są zawsze wyzerowane, co pozwala rasteryzatorowi
+// wyszukiwać ciągi modułów operacjami na całych słowach.
+class QRMatrix
+{
+public:
+    QRMatrix() = default;
+    QRMatrix(int size, int version);
+
+    bool isNull() const { return m_size == 0; }
+    int size() const { return m_size; }
+    int version() const { return m_version; }
+    int wordsPerRow() const { return m_wordsPerRow; }
+
+    bool module(int x, int y) const
+    {
+        return (row(y)[x >> 6] >> (x & 63)) & 1u;
+    }
+
+    void setModule(int x, int y, bool dark)
+    {
+        uint64_t& word = m_words[static_cast<size_t>(y) * m_wordsPerRow + (x >> 6)];
+        const uint64_t bit = uint64_t(1) << (x & 63);
+        word = dark ? (word | bit) : (word & ~bit);
+    }
+
+    // Bezpośredni dostęp do upakowanego wiersza
+    const uint64_t* row(int y) const { return m_words.data() + static_cast<size_t>(y) * m_wordsPerRow; }
+    uint64_t* row(int y) { return m_words.data() + static_cast<size_t>(y) * m_wordsPerRow; }
+
+    // Rozmiar danych macierzy w bajtach (np. do rozliczania pamięci cache)
+    size_t byteSize() const { return m_words.size() * sizeof(uint64_t); }
+
+    bool operator==(const QRMatrix& other) const;
+    bool operator!=(const QRMatrix& other) const { return !(*this == other); }
+
+private:
+    int m_size = 0;
+    int m_version = 0;
+    int m_wordsPerRow = 0;
+    std::vector<uint64_t> m_words;
+};
+
+} // namespace qrcore
+
+#endif // QRCORE_QR_MATRIX_H
@@ -0,0 +1,82 @@
+#ifndef QRCORE_QR_RASTERIZER_H
+#define QRCORE_QR_RASTERIZER_H
+
+#include "qrcore/qr_matrix.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace qrcore {
+
+// Format pikseli generowanego rastra
+enum class PixelFormat {
+    Mono,   // 1 bit na piksel, MSB pierwszy, bit ustawiony = moduł ciemny
+    Gray8,  // 8 bitów na piksel, 0x00 = ciemny, 0xFF = jasny
+    RGB32   // 32 bity na piksel (0xAARRGGBB), zgodny z QImage::Format_RGB32
+};
+
+// Parametry rasteryzacji symbolu
+struct RasterOptions {
+    int scale = 8;   // liczba pikseli na moduł
+    int border = 4;  // strefa ciszy w modułach
+};
+
+// Położenie modułu w macierzy (x - kolumna, y - wiersz)
+struct ModulePosition {
+    int x = 0;
+    int y = 0;
+};
+
+// Bok rastra w pikselach (0 dla pustej macierzy lub błędnych parametrów)
+int rasterSize(const QRMatrix& matrix, const RasterOptions& options);
+
+// Minimalna liczba bajtów na wiersz rastra w danym formacie
+size_t rasterBytesPerLine(int width, PixelFormat format);
+
+// Rasteryzuje macierz do bufora o boku rasterSize() pikseli.
+// Każdy wiersz modułów jest rysowany raz - ciemne ciągi modułów są
+// wyszukiwane na słowach 64-bitowych i wypełniane całymi odcinkami -
+// a następnie kopiowany (memcpy) na pozostałe scale-1 wierszy pikseli.
+// Zwraca false przy błędnych parametrach lub zbyt małym kroku wiersza.
+bool rasterize(const QRMatrix& matrix, const RasterOptions& options, PixelFormat format,
+               uint8_t* destination, size_t bytesPerLine);
+
+// Przerysowuje w rastrze utworzonym wcześniej przez rasterize() (te same
+// parametry i format) tylko wskazane moduły, w ich bieżącym kolorze z macierzy.
+// Pozwala odświeżyć obraz po zmianie kilku modułów bez rysowania całości.
+bool rasterizeModules(const QRMatrix& matrix, const std::vector<ModulePosition>& modules,
+                      const RasterOptions& options, PixelFormat format,
+                      uint8_t* destination, size_t bytesPerLine);
+
+// Rasteryzacja 1-bitowa (Mono) pasami wierszy, dla dowolnego boku wyjściowego.
+// Granice modułów leżą w pikselach floor(i * size / n), więc bok nie musi być
+// wielokrotnością liczby modułów. Obiekt jest niezmienny - pasy mogą być
+// generowane równolegle, a pamięć zależy tylko od wysokości pasa.
+// Macierz musi istnieć przez cały czas życia obiektu.
+class StripRasterizer
+{
+public:
+    // outputSize <= 0 oznacza bok (moduły + 2 * border) * scale
+    StripRasterizer(const QRMatrix& matrix, const RasterOptions& options, int outputSize = 0);
+
+    bool isNull() const { return m_size == 0; }
+    int size() const { return m_size; }
+    size_t bytesPerLine() const { return rasterBytesPerLine(m_size, PixelFormat::Mono); }
+
+    // Wiersze [firstRow, firstRow + rowCount) do bufora o kroku bytesPerLine
+    void render(int firstRow, int rowCount, uint8_t* destination, size_t bytesPerLine) const;
+
+private:
+    // Wiersz modułów (licząc ze strefą ciszy) zawierający wiersz pikseli y
+    int moduleRowAt(int y) const;
+
+    const QRMatrix& m_matrix;
+    int m_border = 0;
+    int m_size = 0;
+    std::vector<int> m_edges; // granice modułów w pikselach, n + 1 wartości
+};
+
+} // namespace qrcore
+
+#endif // QRCORE_QR_RASTERIZER_H
@@ -0,0 +1,28 @@
+#ifndef QRCORE_QR_RENDERER_H
+#define QRCORE_QR_RENDERER_H
+
+#include "qrcore/qr_matrix.h"
+#include "qrcore/qr_rasterizer.h"
+
+#include <QtGui/QImage>
+
+namespace qrcore {
+
+// Parametry renderowania symbolu do QImage
+struct RenderOptions {
+    int scale = 8;                            // liczba pikseli na moduł
+    int border = 4;                           // strefa ciszy w modułach
+    PixelFormat format = PixelFormat::RGB32;  // Mono / Grayscale8 / RGB32
+};
+
+// Dobiera skalę tak, aby symbol z ramką zmieścił się w zadanym rozmiarze (min. 1)
+int scaleForSize(const QRMatrix& matrix, int size, int border = 4);
+
+// Rasteryzuje macierz do obrazu w żądanym formacie (Format_Mono,
+// Format_Grayscale8 lub Format_RGB32). QImage nie wymaga QGuiApplication,
+// więc funkcja działa również w procesach bez serwera wyświetlania.
+QImage renderImage(const QRMatrix& matrix, const RenderOptions& options = RenderOptions());
+
+} // namespace qrcore
+
+#endif // QRCORE_QR_RENDERER_H
@@ -0,0 +1,183 @@
+#ifndef QRCORE_QR_TABLES_H
+#define QRCORE_QR_TABLES_H
+
+#include "qrcore/qr_encoder.h"
+
+#include <array>
+#include <cstdint>
+
+namespace qrcore {
+
+// Stałe specyfikacji QR (ISO/IEC 18004) dostępne w czasie kompilacji
+namespace qrspec {
+
+constexpr int kMinVersion = 1;
+constexpr int kMaxVersion = 40;
+
+constexpr int symbolSize(int version)
+{
+    return version * 4 + 17;
+}
+
+constexpr int levelIndex(ErrorCorrection level)
+{
+    return static_cast<int>(level);  // Low, Medium, Quartile, High
+}
+
+// Słowa korekcyjne na blok [poziom][wersja]
+inline constexpr int8_t kEcCodewordsPerBlock[4][41] = {
+    {-1,  7, 10, 15, 20, 26, 18, 20, 24, 30, 18, 20, 24, 26, 30, 22, 24, 28, 30, 28, 28, 28, 28, 30, 30, 26, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+    {-1, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26, 30, 22, 22, 24, 24, 28, 28, 26, 26, 26, 26, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28},
+    {-1, 13, 22, 18, 26, 18, 24, 18, 22, 20, 24, 28, 26, 24, 20, 30, 24, 28, 28, 26, 30, 28, 30, 30, 30, 30, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+    {-1, 17, 28, 22, 16, 22, 28, 26, 26, 24, 28, 24, 28, 22, 24, 24, 30, 28, 28, 26, 28, 30, 24, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+};
+
+// Liczba bloków korekcyjnych [poziom][wersja]
+inline constexpr int8_t kEcBlocks[4][41] = {
+    {-1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 4, 4, 4, 4, 4, 6, 6, 6, 6, 7, 8, 8, 9, 9, 10, 12, 12, 12, 13, 14, 15, 16, 17, 18, 19, 19, 20, 21, 22, 24, 25},
+    {-1, 1, 1, 1, 2, 2, 4, 4, 4, 5, 5, 5, 8, 9, 9, 10, 10, 11, 13, 14, 16, 17, 17, 18, 20, 21, 23, 25, 26, 28, 29, 31, 33, 35, 37, 38, 40, 43, 45, 47, 49},
+    {-1, 1, 1, 2, 2, 4, 4, 6, 6, 8, 8, 8, 10, 12, 16, 12, 17, 16, 18, 21, 20, 23, 23, 25, 27, 29, 34, 34, 35, 38, 40, 43, 45, 48, 51, 53, 56, 59, 62, 65, 68},
+    {-1, 1, 1, 2, 4, 4, 4, 5, 6, 8, 8, 11, 11, 16, 16, 18, 16, 19, 21, 25, 25, 25, 34, 30, 32, 35, 37, 40, 42, 45, 48, 51, 54, 57, 60, 63, 66, 70, 74, 77, 81},
+};
+
+// Liczba modułów danych (słowa danych i korekcyjne oraz bity resztowe)
+constexpr int rawDataModules(int version)
+{
+    int result = (16 * version + 128) * version + 64;
+    if (version >= 2) {
+        const int alignments = version / 7 + 2;
+        result -= (25 * alignments - 10) * alignments - 55;
+        if (version >= 7) {
+            result -= 36;
+        }
+    }
+    return result;
+}
+
+constexpr int totalCodewords(int version)
+{
+    return rawDataModules(version) / 8;
+}
+
+constexpr int dataCodewords(int version, ErrorCorrection level)
+{
+    const int index = levelIndex(level);
+    return totalCodewords(version) - kEcCodewordsPerBlock[index][version] * kEcBlocks[index][version];
+}
+
+// Pojemność w bitach danych [poziom][wersja] - pozwala wyznaczyć wersję
+// z długości strumienia bitów bez próbnego kodowania
+struct CapacityTable {
+    int32_t bits[4][41]{};
+};
+
+constexpr CapacityTable makeCapacityTable()
+{
+    CapacityTable table;
+    for (int level = 0; level < 4; level++) {
+        for (int version = kMinVersion; version <= kMaxVersion; version++) {
+            table.bits[level][version] = dataCodewords(version, static_cast<ErrorCorrection>(level)) * 8;
+        }
+    }
+    return table;
+}
+
+inline constexpr CapacityTable kDataCapacityBits = makeCapacityTable();
+
+// Zakresy wersji o tej samej długości pól liczby znaków: 1-9, 10-26, 27-40
+constexpr int kVersionRanges = 3;
+inline constexpr int kVersionRangeFirst[kVersionRanges] = {1, 10, 27};
+inline constexpr int kVersionRangeLast[kVersionRanges] = {9, 26, 40};
+
+constexpr int versionRange(int version)
+{
+    return version <= 9 ? 0 : (version <= 26 ? 1 : 2);
+}
+
+// Długość pola liczby znaków dla trybu i wersji
+constexpr int characterCountBits(SegmentMode mode, int version)
+{
+    const int range = versionRange(version);
+    switch (mode) {
+        case SegmentMode::Numeric:      return 10 + 2 * range;
+        case SegmentMode::Alphanumeric: return 9 + 2 * range;
+        case SegmentMode::Byte:         return range == 0 ? 8 : 16;
+        case SegmentMode::Kanji:        return 8 + 2 * range;
+        case SegmentMode::StructuredAppend: return 0;
+    }
+    return 0;
+}
+
+// Najmniejsza wersja z przedziału [first, last] mieszcząca bits bitów
+// danych na danym poziomie; 0, gdy żadna
+constexpr int smallestVersion(long bits, ErrorCorrection level, int first, int last)
+{
+    const int index = levelIndex(level);
+    for (int version = first; version <= last; version++) {
+        if (bits <= kDataCapacityBits.bits[index][version]) {
+            return version;
+        }
+    }
+    return 0;
+}
+
+// Środki wzorców wyrównania (ta sama lista dla wierszy i kolumn)
+struct AlignmentPositions {
+    std::array<int, 7> positions{};
+    int count = 0;
+};
+
+constexpr AlignmentPositions alignmentPositions(int version)
+{
+    AlignmentPositions result;
+    if (version == 1) {
+        return result;
+    }
+
+    const int count = version / 7 + 2;
+    const int step = version == 32 ? 26 : (version * 4 + count * 2 + 1) / (count * 2 - 2) * 2;
+    result.count = count;
+    result.positions[0] = 6;
+    for (int i = count - 1, position = symbolSize(version) - 7; i >= 1; i--, position -= step) {
+        result.positions[i] = position;
+    }
+    return result;
+}
+
+// 15-bitowe słowo formatu (BCH(15,5) z maską 0x5412) dla poziomu i maski
+constexpr uint32_t formatBits(ErrorCorrection level, int mask)
+{
+    // Kody poziomów w słowie formatu: L = 01, M = 00, Q = 11, H = 10
+    constexpr uint32_t levelBits[4] = {1, 0, 3, 2};
+    const uint32_t data = levelBits[levelIndex(level)] << 3 | static_cast<uint32_t>(mask);
+    uint32_t remainder = data;
+    for (int i = 0; i < 10; i++) {
+        remainder = (remainder << 1) ^ ((remainder >> 9) * 0x537);
+    }
+    return (data << 10 | remainder) ^ 0x5412;
+}
+
+// 18-bitowe słowo wersji (BCH(18,6)), tylko dla wersji >= 7
+constexpr uint32_t versionBits(int version)
+{
+    uint32_t remainder = static_cast<uint32_t>(version);
+    for (int i = 0; i < 12; i++) {
+        remainder = (remainder << 1) ^ ((remainder >> 11) * 0x1F25);
+    }
+    return static_cast<uint32_t>(version) << 12 | remainder;
+}
+
+static_assert(dataCodewords(1, ErrorCorrection::Medium) == 16, "tablice QR: wersja 1-M");
+static_assert(dataCodewords(40, ErrorCorrection::Low) == 2956, "tablice QR: wersja 40-L");
+static_assert(dataCodewords(40, ErrorCorrection::High) == 1276, "tablice QR: wersja 40-H");
+static_assert(kDataCapacityBits.bits[3][40] == 1276 * 8, "tablica pojemności 40-H");
+static_assert(smallestVersion(128, ErrorCorrection::Medium, 1, 9) == 1, "wersja dla 16 bajtów M");
+static_assert(smallestVersion(129, ErrorCorrection::Medium, 1, 9) == 2, "wersja dla 129 bitów M");
+static_assert(formatBits(ErrorCorrection::Medium, 0) == 0x5412, "słowo formatu M/0");
+static_assert(versionBits(7) == 0x07C94, "słowo wersji 7");
+
+} // namespace qrspec
+
+} // namespace qrcore
+
+#endif // QRCORE_QR_TABLES_H
@@ -0,0 +1,53 @@
+/*
+ * qrcore - biblioteka kodowania i dekodowania kodów QR
+ *
+ * Biblioteka nie zależy od QtWidgets ani od QApplication, dzięki czemu
+ * może być linkowana do procesów serwerowych (bez X/Wayland) oraz
+ * do narzędzi mierzących wydajność poszczególnych etapów:
+ *
+ *   dane -> encode() -> QRMatrix -> renderImage() -> QImage
+ *                               -> rasterize()   -> bufor 1/8/32 bpp
+ *   cv::Mat -> decode() -> DecodeResult (kaskada backendów: native, quirc, ZXing, OpenCV)
+ *   cv::Mat -> decodeMulti() -> std::vector<DecodeResult> (wiele kodów)
+ *   plik JPEG -> decodePhotoFile() -> pomniejszenie DCT 1/8-1/2 -> pełny obraz (w razie potrzeby)
+ *   plik wideo -> decodeVideoFile() -> segmenty na wątkach -> rekordy (czas, treść, położenie)
+ *   dane -> encodeStructuredAppend() -> seria QRMatrix (do 16 symboli)
+ *   std::vector<DecodeResult> -> mergeStructuredAppend() -> złożone wiadomości
+ *   plik -> FountainEncoder::frame() -> ramki animacji -> FountainDecoder
+ */
+
+#ifndef QRCORE_QRCORE_H
+#define QRCORE_QRCORE_H
+
+#include "qrcore/qr_matrix.h"
+#include "qrcore/qr_encoder.h"
+#include "qrcore/qr_rasterizer.h"
+#include "qrcore/qr_renderer.h"
+#include "qrcore/decode_result.h"
+#include "qrcore/binarizer.h"
+#include "qrcore/decoder_backend.h"
+#include "qrcore/finder_detector.h"
+#include "qrcore/qr_decoder.h"
+#include "qrcore/multi_decoder.h"
+#include "qrcore/pyramid_decoder.h"
+#include "qrcore/photo_decoder.h"
+#include "qrcore/video_decoder.h"
+#include "qrcore/image_bridge.h"
+#include "qrcore/lru_cache.h"
+#include "qrcore/symbol_cache.h"
+#include "qrcore/ring_buffer.h"
+#include "qrcore/camera_pipeline.h"
+#include "qrcore/thread_pool.h"
+#include "qrcore/payload.h"
+#include "qrcore/archive_writer.h"
+#include "qrcore/vector_writer.h"
+#include "qrcore/bitmap_writer.h"
+#include "qrcore/reed_solomon.h"
+#include "qrcore/qr_tables.h"
+#include "qrcore/segmenter.h"
+#include "qrcore/serial_encoder.h"
+#include "qrcore/structured_append.h"
+#include "qrcore/symbol_reader.h"
+#include "qrcore/fountain.h"
+
+#endif // QRCORE_QRCORE_H
@@ -0,0 +1,110 @@
+#ifndef QRCORE_REED_SOLOMON_H
+#define QRCORE_REED_SOLOMON_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace qrcore {
+
+// Arytmetyka GF(256) z wielomianem pierwotnym x^8 + x^4 + x^3 + x^2 + 1 (0x11D),
+// tablice wyliczane w czasie kompilacji
+namespace gf256 {
+
+struct Tables {
+    std::array<uint8_t, 512> exp{};  // podwojona - mnożenie bez operacji modulo
+    std::array<uint8_t, 256> log{};
+};
+
+constexpr Tables makeTables()
+{
+    Tables tables;
+    unsigned value = 1;
+    for (int i = 0; i < 255; i++) {
+        tables.exp[i] = static_cast<uint8_t>(value);
+        tables.log[value] = static_cast<uint8_t>(i);
+        value <<= 1;
+        if (value & 0x100) {
+            value ^= 0x11D;
+        }
+    }
+    for (int i = 255; i < 512; i++) {
+        tables.exp[i] = tables.exp[i - 255];
+    }
+    return tables;
+}
+
+inline constexpr Tables kTables = makeTables();
+
+constexpr uint8_t multiply(uint8_t a, uint8_t b)
+{
+    return (a == 0 || b == 0) ? 0 : kTables.exp[kTables.log[a] + kTables.log[b]];
+}
+
+constexpr uint8_t divide(uint8_t a, uint8_t b)
+{
+    return a == 0 ? 0 : kTables.exp[kTables.log[a] + 255 - kTables.log[b]];
+}
+
+constexpr uint8_t power(int exponent)
+{
+    return kTables.exp[((exponent % 255) + 255) % 255];
+}
+
+} // namespace gf256
+
+// Największa liczba słów korekcyjnych w bloku QR (wersje 1-40)
+constexpr int kMaxEcCodewords = 30;
+
+// Wielomian generujący stopnia degree: współczynniki bez wiodącej jedynki,
+// od najwyższej potęgi - iloczyn (x - 2^0)(x - 2^1)...(x - 2^(degree-1))
+template <int Degree>
+constexpr std::array<uint8_t, Degree> makeGenerator()
+{
+    std::array<uint8_t, Degree> result{};
+    result[Degree - 1] = 1;
+    uint8_t root = 1;
+    for (int i = 0; i < Degree; i++) {
+        for (int j = 0; j < Degree; j++) {
+            result[j] = gf256::multiply(result[j], root);
+            if (j + 1 < Degree) {
+                result[j] ^= result[j + 1];
+            }
+        }
+        root = gf256::multiply(root, 0x02);
+    }
+    return result;
+}
+
+// Wiersze iloczynów generatora przez każdy możliwy współczynnik, wyrównane
+// do 32 bajtów: krok kodowania to przesunięcie rejestru i XOR całego
+// 32-bajtowego wiersza - pętla o stałej długości, wektoryzowana przez kompilator
+using GeneratorProducts = std::array<std::array<uint8_t, 32>, 256>;
+
+template <int Degree>
+constexpr GeneratorProducts makeGeneratorProducts()
+{
+    static_assert(Degree >= 1 && Degree <= kMaxEcCodewords, "stopień poza zakresem QR");
+    constexpr std::array<uint8_t, Degree> generator = makeGenerator<Degree>();
+    GeneratorProducts products{};
+    for (int factor = 0; factor < 256; factor++) {
+        for (int j = 0; j < Degree; j++) {
+            products[factor][j] = gf256::multiply(generator[j], static_cast<uint8_t>(factor));
+        }
+    }
+    return products;
+}
+
+// Słowa korekcyjne (ecLength <= kMaxEcCodewords) dla bloku danych.
+// Zwraca false dla długości, której nie używa żaden poziom QR.
+bool rsEncode(const uint8_t* data, size_t length, int ecLength, uint8_t* ec);
+
+// Korekcja bloku (dane + ecLength słów korekcyjnych, length <= 255) w miejscu:
+// syndromy, Berlekamp-Massey, przeszukiwanie Chiena i wzór Forneya.
+// Zwraca liczbę poprawionych słów albo -1, gdy błędów jest więcej,
+// niż kod potrafi poprawić (blok pozostaje wtedy bez zmian).
+int rsDecode(uint8_t* codeword, size_t length, int ecLength);
+
+} // namespace qrcore
+
+#endif // QRCORE_REED_SOLOMON_H
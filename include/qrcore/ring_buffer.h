@@ -0,0 +1,120 @@
+#ifndef QRCORE_RING_BUFFER_H
+#define QRCORE_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace qrcore {
+
+// Ograniczony bufor cykliczny bez blokad (wielu producentów/konsumentów).
+// Każda komórka ma licznik sekwencji, który rozstrzyga, czy komórka jest
+// wolna do zapisu, czy gotowa do odczytu - producenci i konsumenci
+// rezerwują pozycje pojedynczą operacją compare_exchange.
+template <typename T>
+class RingBuffer
+{
+public:
+    // Pojemność jest zaokrąglana w górę do potęgi dwójki (min. 2)
+    explicit RingBuffer(size_t capacity)
+    {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+
+        m_mask = rounded - 1;
+        m_cells.reset(new Cell[rounded]);
+        for (size_t i = 0; i < rounded; i++) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    // Wstawia element; przy pełnym buforze zwraca false (value pozostaje nietknięte)
+    bool tryPush(T& value)
+    {
+        Cell* cell;
+        size_t position = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[position & m_mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (m_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pobiera najstarszy element; przy pustym buforze zwraca false
+    bool tryPop(T& value)
+    {
+        Cell* cell;
+        size_t position = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[position & m_mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (m_dequeuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->value);
+        cell->value = T();
+        cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Wstawia element, a przy pełnym buforze porzuca najstarsze elementy.
+    // Zwraca liczbę porzuconych elementów.
+    size_t pushDropOldest(T value)
+    {
+        size_t dropped = 0;
+        while (!tryPush(value)) {
+            T oldest;
+            if (tryPop(oldest)) {
+                ++dropped;
+            }
+        }
+        return dropped;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    // Liczniki na osobnych liniach pamięci podręcznej (bez false sharing)
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<size_t> m_dequeuePos{0};
+    alignas(64) std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+};
+
+} // namespace qrcore
+
+#endif // QRCORE_RING_BUFFER_H
@@ -0,0 +1,33 @@
+#ifndef QRCORE_SEGMENTER_H
+#define QRCORE_SEGMENTER_H
+
+#include "qrcore/qr_encoder.h"
+
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Wynik podziału danych na segmenty
+struct SegmentPlan {
+    std::vector<Segment> segments;
+    int version = 0;   // najmniejsza wersja mieszcząca segmenty (0 = brak / puste dane)
+    long bits = 0;     // długość strumienia bitów (wskaźniki trybów, liczniki, dane)
+};
+
+// Podział tekstu UTF-8 na segmenty Numeric/Alphanumeric/Byte/Kanji o
+// najkrótszym strumieniu bitów. Programowanie dynamiczne po znakach
+// (koszt w 1/6 bitu, stan = tryb bieżącego segmentu) jest liczone osobno
+// dla każdego zakresu wersji (1-9, 10-26, 27-40), bo od zakresu zależą
+// długości pól liczby znaków; wersja wynika z tablicy pojemności
+// (qrspec::kDataCapacityBits) bez próbnego kodowania. Przy options.version
+// > 0 brany jest tylko zakres tej wersji. Kanji (options.allowKanji)
+// wymaga konwertera Shift JIS w Qt (ICU) - bez niego tryb jest pomijany.
+// reservedBits - bity segmentów dokładanych przed planem (np. nagłówek
+// Structured Append), uwzględniane tylko przy doborze wersji.
+SegmentPlan planSegments(const std::string& data, const EncodeOptions& options = EncodeOptions(),
+                         long reservedBits = 0);
+
+} // namespace qrcore
+
+#endif // QRCORE_SEGMENTER_H
@@ -0,0 +1,67 @@
+#ifndef QRCORE_SERIAL_ENCODER_H
+#define QRCORE_SERIAL_ENCODER_H
+
+#include "qrcore/qr_encoder.h"
+#include "qrcore/qr_matrix.h"
+#include "qrcore/qr_rasterizer.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Koder serii etykiet "prefiks + licznik" (np. PREFIX-000001, PREFIX-000002...).
+// Wersja, podział na segmenty, maska i słowo formatu są ustalane raz dla
+// całej serii (maska - na podstawie pierwszej etykiety), więc kolejny numer
+// zmienia jedynie słowa danych kodujące licznik. Słowa korekcyjne są
+// aktualizowane z liniowości kodu RS: EC(d ^ e) = EC(d) ^ EC(e), gdzie EC(e)
+// dla pojedynczego bajtu na danej pozycji bloku jest tablicowane z góry.
+// Przestawiane są tylko moduły tych słów kodowych, a lista zmienionych
+// modułów pozwala przerysować jedynie fragment rastra (rasterizeModules).
+// Wynik jest poprawnym symbolem QR - różni się od encode() najwyżej maską.
+// Obiekt nie jest bezpieczny wątkowo (jedna seria = jeden wątek).
+class SerialEncoder
+{
+public:
+    SerialEncoder(const std::string& prefix, int digits, const EncodeOptions& options = EncodeOptions());
+
+    bool isNull() const { return m_symbol.isNull(); }
+    int digits() const { return m_digits; }
+    int mask() const { return m_mask; }
+
+    // Treść etykiety dla numeru (licznik dopełniony zerami do digits cyfr)
+    std::string text(uint64_t number) const;
+
+    // Przechodzi do etykiety o danym numerze; changed (opcjonalnie) otrzymuje
+    // moduły, które zmieniły kolor względem poprzedniej etykiety.
+    // false, gdy numer ma więcej niż digits cyfr.
+    bool encode(uint64_t number, std::vector<ModulePosition>* changed = nullptr);
+
+    // Bieżący symbol (pierwszy numer serii to 0, dopóki nie wywołano encode)
+    const QRMatrix& matrix() const { return m_symbol; }
+
+private:
+    void setCodeword(int index, uint8_t value, std::vector<ModulePosition>* changed);
+
+    std::string m_prefix;
+    int m_digits = 0;
+    EncodeOptions m_options;
+    int m_version = 0;
+    int m_mask = 0;
+    int m_ecLength = 0;
+
+    std::vector<Segment> m_segments;  // segmenty z licznikiem na końcu
+    std::vector<uint8_t> m_data;      // bieżące słowa danych
+    std::vector<uint8_t> m_ec;        // bieżące słowa korekcyjne, blok po bloku
+    std::vector<int> m_dataBlock;     // blok słowa danych
+    std::vector<int> m_dataDistance;  // odległość słowa danych od końca bloku
+    std::vector<int> m_dataPosition;  // pozycja słowa danych po przeplocie
+    std::vector<int> m_ecPosition;    // pozycja słowa korekcyjnego po przeplocie
+    std::vector<uint8_t> m_unitEc;    // EC jedynki w odległości d od końca bloku, [d * ecLength + j]
+    QRMatrix m_symbol;
+};
+
+} // namespace qrcore
+
+#endif // QRCORE_SERIAL_ENCODER_H
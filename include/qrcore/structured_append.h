@@ -0,0 +1,79 @@
+#ifndef QRCORE_STRUCTURED_APPEND_H
+#define QRCORE_STRUCTURED_APPEND_H
+
+#include "qrcore/qr_decoder.h"
+#include "qrcore/qr_encoder.h"
+#include "qrcore/qr_matrix.h"
+#include "qrcore/segmenter.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qrcore {
+
+// Structured Append (ISO/IEC 18004, 8): wiadomość rozdzielona na 2-16
+// symboli, z których każdy niesie numer, liczbę symboli serii i wspólną
+// parzystość (XOR wszystkich bajtów danych wiadomości).
+constexpr int kMaxStructuredAppendSymbols = 16;
+constexpr int kStructuredAppendHeaderBits = 20;
+
+// Podział danych (UTF-8) na części, z których każda - razem z nagłówkiem -
+// mieści się w wersji maxVersion. Granice części wypadają między znakami
+// UTF-8, a każda część jest optymalnie dzielona na tryby (planSegments;
+// pole optimizeSegments jest tu ignorowane). Każdy plan zaczyna się
+// segmentem StructuredAppend, a jego wersja to najmniejsza mieszcząca część.
+// Pusty wynik, gdy potrzeba więcej niż 16 symboli.
+std::vector<SegmentPlan> splitStructuredAppend(const std::string& data, int maxVersion,
+                                               const EncodeOptions& options = EncodeOptions());
+
+// Koduje dane jako serię symboli Structured Append nie większych niż
+// maxVersion. Symbole są kodowane równolegle (cv::parallel_for_), kolejność
+// wyniku odpowiada numerom w serii. Pusty wynik, gdy danych nie da się
+// podzielić albo zakodować którejkolwiek części.
+std::vector<QRMatrix> encodeStructuredAppend(const std::string& data, int maxVersion,
+                                             const EncodeOptions& options = EncodeOptions(),
+                                             bool parallel = true);
+
+// Składanie wiadomości z części odczytanych z jednego lub wielu obrazów
+// (np. z kolejnych klatek kamery). Serie są rozróżniane liczbą symboli
+// i parzystością; powtórnie odczytana część jest pomijana.
+// Obiekt nie jest bezpieczny wątkowo.
+class StructuredAppendCollector
+{
+public:
+    // Stan serii po dodaniu części
+    struct Progress {
+        int received = 0;
+        int total = 0;
+    };
+
+    // Dodaje wynik dekodowania; dla symbolu spoza serii zwraca {0, 0}
+    Progress add(const DecodeResult& result);
+
+    // Zwraca i usuwa pierwszą kompletną serię: treść złożona z części
+    // w kolejności numerów, narożniki pierwszej części. Seria, której
+    // parzystość nie zgadza się z danymi, jest odrzucana.
+    bool takeComplete(DecodeResult& message);
+
+    void clear() { m_series.clear(); }
+
+private:
+    struct Series {
+        std::vector<DecodeResult> parts;
+        int received = 0;
+    };
+
+    std::map<std::pair<int, int>, Series> m_series; // (liczba symboli, parzystość)
+};
+
+// Zastępuje komplety części Structured Append złożonymi wiadomościami
+// (w miejscu pierwszej części); pozostałe wyniki, w tym części
+// niekompletnych serii, zostają bez zmian
+std::vector<DecodeResult> mergeStructuredAppend(const std::vector<DecodeResult>& results);
+
+} // namespace qrcore
+
+#endif // QRCORE_STRUCTURED_APPEND_H
@@ -0,0 +1,56 @@
+#ifndef QRCORE_SYMBOL_CACHE_H
+#define QRCORE_SYMBOL_CACHE_H
+
+#include "qrcore/lru_cache.h"
+#include "qrcore/qr_encoder.h"
+#include "qrcore/qr_matrix.h"
+
+#include <memory>
+#include <string>
+
+namespace qrcore {
+
+// Klucz zakodowanego symbolu: treść + wszystkie parametry kodowania
+struct SymbolKey {
+    std::string payload;
+    EncodeOptions options;
+
+    bool operator==(const SymbolKey& other) const
+    {
+        return payload == other.payload && options == other.options;
+    }
+};
+
+struct SymbolKeyHash {
+    size_t operator()(const SymbolKey& key) const
+    {
+        return std::hash<std::string>()(key.payload) ^ (hashValue(key.options) * 0x9E3779B97F4A7C15ull);
+    }
+};
+
+// Pamięć podręczna zakodowanych macierzy (wspólna dla wątków).
+// Powtarzające się treści (przełączanie zakładek, wczytywanie zapisanych
+// sieci WiFi, wsadowe generowanie) nie przechodzą ponownie przez koder.
+class SymbolCache
+{
+public:
+    static constexpr size_t DefaultBudget = 16 * 1024 * 1024;
+
+    explicit SymbolCache(size_t budgetBytes = DefaultBudget);
+
+    // Zwraca macierz z pamięci lub koduje ją i zapamiętuje.
+    // Pusty wskaźnik oznacza, że danych nie da się zakodować.
+    std::shared_ptr<const QRMatrix> encode(const std::string& data,
+                                           const EncodeOptions& options = EncodeOptions());
+
+    void clear() { m_cache.clear(); }
+    void setBudget(size_t budgetBytes) { m_cache.setBudget(budgetBytes); }
+    CacheStats stats() const { return m_cache.stats(); }
+
+private:
+    LruCache<SymbolKey, std::shared_ptr<const QRMatrix>, SymbolKeyHash> m_cache;
+};
+
+} // namespace qrcore
+
+#endif // QRCORE_SYMBOL_CACHE_H
@@ -0,0 +1,42 @@
+#ifndef QRCORE_SYMBOL_READER_H
+#define QRCORE_SYMBOL_READER_H
+
+#include "qrcore/qr_decoder.h"
+#include "qrcore/qr_encoder.h"
+#include "qrcore/qr_matrix.h"
+
+#include <opencv2/core.hpp>
+
+#include <string>
+
+namespace qrcore {
+
+// Treść odczytana z siatki modułów
+struct SymbolContent {
+    std::string text;       // treść w UTF-8 (znaki Kanji przekodowane z Shift JIS)
+    int version = 0;
+    ErrorCorrection ecLevel = ErrorCorrection::Medium;
+    int mask = -1;
+    int correctedCodewords = 0;              // słowa poprawione przez korekcję RS
+    StructuredAppendInfo structuredAppend;   // nagłówek, jeśli symbol należy do serii
+};
+
+// Siatka modułów z obrazu "straight" detektora OpenCV (jeden piksel na
+// moduł, ciemny < 128); pusta macierz, gdy rozmiar nie odpowiada żadnej wersji
+QRMatrix gridFromStraight(const cv::Mat& straight);
+
+// Dekodowanie siatki modułów (bez strefy ciszy): słowo formatu (najbliższe
+// z 32 poprawnych, do 3 błędnych bitów), zdjęcie maski, rozplecenie bloków,
+// korekcja Reeda-Solomona i rozbiór segmentów (Numeric, Alphanumeric, Byte,
+// Kanji, ECI, FNC1, Structured Append). Siatka odbita lustrzanie jest
+// czytana po transpozycji. false, gdy symbolu nie da się odczytać.
+bool readSymbol(const QRMatrix& grid, SymbolContent& content);
+
+// Uzupełnia wynik detektora OpenCV o nagłówek Structured Append, którego
+// OpenCV nie udostępnia: siatka straight jest odczytywana ponownie i przy
+// symbolu z nagłówkiem treść zastępowana treścią tej części.
+void readStructuredAppend(const cv::Mat& straight, DecodeResult& result);
+
+} // namespace qrcore
+
+#endif // QRCORE_SYMBOL_READER_H
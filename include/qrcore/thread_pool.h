@@ -0,0 +1,78 @@
+#ifndef QRCORE_THREAD_POOL_H
+#define QRCORE_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace qrcore {
+
+// Pula wątków z podkradaniem zadań (work stealing) dla przetwarzania wsadowego.
+//
+// Każdy wątek ma własną kolejkę: zadania zlecane z wnętrza puli trafiają do
+// kolejki bieżącego wątku i są pobierane od końca (LIFO - ciepła pamięć
+// podręczna), a bezczynne wątki podkradają zadania z początku cudzych kolejek.
+// Zadania z zewnątrz są rozdzielane po kolei między kolejki.
+class ThreadPool
+{
+public:
+    // threads <= 0 oznacza liczbę rdzeni procesora
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int threadCount() const { return static_cast<int>(m_threads.size()); }
+
+    // Dodaje zadanie do kolejki. Wyjątek rzucony przez zadanie jest
+    // przechwytywany i liczony (failedCount) - nie przerywa pracy puli.
+    void submit(std::function<void()> task);
+
+    // Czeka, aż wszystkie zlecone zadania zostaną wykonane.
+    // Nie wolno wywoływać z wnętrza zadania tej samej puli.
+    void wait();
+
+    // Liczba zadań wykonanych po podkradnięciu z cudzej kolejki
+    uint64_t stolenCount() const { return m_stolen.load(); }
+
+    // Liczba zadań zakończonych wyjątkiem
+    uint64_t failedCount() const { return m_failed.load(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, std::function<void()>& task);
+    bool steal(size_t thief, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::atomic<size_t> m_nextQueue{0};
+    std::atomic<size_t> m_queued{0};   // zadania czekające w kolejkach
+    std::atomic<size_t> m_pending{0};  // zadania zlecone i niezakończone
+    std::atomic<uint64_t> m_stolen{0};
+    std::atomic<uint64_t> m_failed{0};
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    bool m_stopping = false;
+};
+
+// Liczba wątków domyślnie używana przez narzędzia wsadowe
+int defaultThreadCount();
+
+} // namespace qrcore
+
+#endif // QRCORE_THREAD_POOL_H
@@ -0,0 +1,53 @@
+#ifndef QRCORE_VECTOR_WRITER_H
+#define QRCORE_VECTOR_WRITER_H
+
+#include "qrcore/qr_matrix.h"
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Format wyjścia wektorowego
+enum class VectorFormat {
+    Svg,
+    Pdf,
+    Eps
+};
+
+// Parametry wyjścia wektorowego
+struct VectorOptions {
+    int border = 4;           // strefa ciszy w modułach
+    double moduleSize = 8.0;  // bok modułu: piksele SVG lub punkty PDF/EPS (1/72")
+    bool background = true;   // białe tło pod symbolem
+};
+
+// Wierzchołek konturu we współrzędnych modułów (bez strefy ciszy)
+struct OutlinePoint {
+    int x;
+    int y;
+};
+
+// Śledzenie konturów ciemnych obszarów macierzy. Każdy obszar jest zwracany
+// jako zamknięty wielokąt o krawędziach poziomych i pionowych, z samymi
+// narożnikami (współliniowe odcinki scalone). Obrysy zewnętrzne mają kierunek
+// zgodny z ruchem wskazówek zegara (oś Y w dół), otwory - przeciwny, więc
+// wypełnienie regułą nonzero i even-odd daje ten sam wynik. Wielokąty są
+// przekazywane do callbacka w miarę śledzenia, w ustalonej kolejności.
+void traceOutlines(const QRMatrix& matrix,
+                   const std::function<void(const std::vector<OutlinePoint>&)>& polygon);
+
+// Zapisuje symbol jako SVG, PDF lub EPS prosto z macierzy - bez rastra
+// pośredniego, strumieniowo. Wynik zależy wyłącznie od macierzy i opcji
+// (bez dat i identyfikatorów), więc nadaje się do cache'owania po skrócie.
+bool writeVector(const QRMatrix& matrix, VectorFormat format, std::ostream& output,
+                 const VectorOptions& options = VectorOptions());
+
+// Format na podstawie rozszerzenia pliku (.svg, .pdf, .eps); false dla innych
+bool vectorFormatForPath(const std::string& path, VectorFormat& format);
+
+} // namespace qrcore
+
+#endif // QRCORE_VECTOR_WRITER_H
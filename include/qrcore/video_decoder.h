@@ -0,0 +1,69 @@
+#ifndef QRCORE_VIDEO_DECODER_H
+#define QRCORE_VIDEO_DECODER_H
+
+#include "qrcore/decode_result.h"
+
+#include <opencv2/core.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace qrcore {
+
+// Wystąpienie kodu w nagraniu: kolejne klatki z tą samą treścią (z przerwami
+// nie dłuższymi niż VideoDecodeOptions::mergeGap) tworzą jeden rekord
+struct VideoCodeRecord {
+    double timestamp = 0.0;           // sekundy od początku nagrania - pierwsza klatka
+    double lastSeen = 0.0;            // sekundy - ostatnia klatka z kodem
+    int64_t frame = 0;                // numer pierwszej klatki
+    int frames = 0;                   // liczba klatek, w których odczytano kod
+    std::string payload;
+    std::vector<cv::Point2f> polygon; // położenie w pierwszej klatce
+};
+
+struct VideoDecodeOptions {
+    int threads = 0;            // wątki (segmenty dekodowane równolegle); 0 - liczba rdzeni
+    double segmentSeconds = 10; // minimalna długość segmentu (każdy otwiera plik i przewija)
+    int frameStep = 1;          // dekodowanie co N-tej klatki (pozostałe są tylko rozpakowywane)
+    double mergeGap = 1.0;      // sekundy bez kodu, po których ta sama treść jest nowym rekordem
+                                // (nie mniej niż odstęp dekodowanych klatek)
+    bool multiple = true;       // wszystkie kody klatki zamiast pierwszego
+
+    // Postęp: zakończone i wszystkie segmenty; false przerywa dekodowanie.
+    // Wywoływane z wątków roboczych.
+    std::function<bool(int done, int total)> progress;
+
+    // Flaga przerwania sprawdzana przed każdą klatką (np. przycisk "Przerwij"
+    // albo zamknięcie okna); nullptr - tylko przez progress
+    const std::atomic<bool>* cancel = nullptr;
+};
+
+struct VideoDecodeStats {
+    int64_t frames = 0;         // klatki rozpakowane (bez klatek przewijania)
+    int64_t decodedFrames = 0;  // klatki przekazane dekoderom
+    double duration = 0.0;      // długość nagrania w sekundach
+    int segments = 0;
+    double seconds = 0.0;       // czas przetwarzania
+    bool cancelled = false;
+};
+
+// Odczyt wszystkich kodów z pliku wideo.
+//
+// Nagranie jest dzielone na segmenty o zbliżonej liczbie klatek, zaczynające
+// się od klatek kluczowych (z pakietów kontenera; bez nich - tam, gdzie stanęło
+// próbne przewinięcie). Każdy wątek otwiera własny cv::VideoCapture i przewija
+// do początku segmentu, więc przepustowość rośnie z liczbą rdzeni. Nagranie,
+// którego nie da się przewinąć, jest czytane po kolei jednym segmentem.
+// Kody widoczne w kolejnych klatkach są łączone w jeden rekord - także na
+// granicy segmentów. Rekordy są posortowane według czasu.
+// Pusty wynik i stats.frames == 0 oznaczają, że pliku nie da się otworzyć.
+std::vector<VideoCodeRecord> decodeVideoFile(const std::string& path,
+                                             const VideoDecodeOptions& options = VideoDecodeOptions(),
+                                             VideoDecodeStats* stats = nullptr);
+
+} // namespace qrcore
+
+#endif // QRCORE_VIDEO_DECODER_H
@@ -2,7 +2,7 @@
  * QR Code Generator - Aplikacja Qt/C++ dla Linux
  * 
  * Wymagane biblioteki:
- * - Qt5 lub Qt6 (Core, Widgets, GUI)
+ * - Qt5 lub Qt6 (Core, Widgets, GUI, Concurrent)
  * - libqrencode (dla generowania kodów QR)
  * - OpenCV (dla odczytu kodów QR z kamery/obrazów)
  * 
@@ -30,6 +30,7 @@
 #include <QtWidgets/QTextEdit>
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QCheckBox>
+#include <QtWidgets/QSpinBox>
 #include <QtWidgets/QPushButton>
 #include <QtWidgets/QListWidget>
 #include <QtWidgets/QGroupBox>
@@ -39,6 +40,7 @@
 #include <QtWidgets/QProgressBar>
 #include <QtWidgets/QSplitter>
 #include <QtGui/QPixmap>
+#include <QtGui/QPainter>
 #include <QtGui/QClipboard>
 #include <QtGui/QScreen>
 #include <QtGui/QGuiApplication>
@@ -50,13 +52,21 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QCryptographicHash>
 #include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QDebug>
+#include <QtCore/QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 // Zewnętrzne biblioteki
-#include <qrencode.h>
 #include <opencv2/opencv.hpp>
 #include <opencv2/objdetect.hpp>
 
+// Silnik kodowania/dekodowania (bez zależności od QtWidgets)
+#include "qrcore/qrcore.h"
+
+#include <atomic>
 #include <memory>
 #include <map>
 #include <string>
@@ -92,6 +102,26 @@ struct WiFiNetwork {
     }
 };
 
+// Wynik renderowania podglądu wykonanego w wątku roboczym
+struct PreviewResult {
+    quint64 requestId = 0;  // numer żądania, dla którego powstał wynik
+    QImage fullImage;       // symbol w skali 8 (do zapisu/kopiowania)
+    QImage scaledImage;     // symbol dopasowany do rozmiaru podglądu
+    std::shared_ptr<const qrcore::QRMatrix> matrix; // macierz do zapisu wektorowego
+    int symbolCount = 1;    // > 1 - seria Structured Append (obraz złożony, bez macierzy)
+    bool cancelled = false; // przerwano, bo pojawiło się nowsze żądanie
+};
+
+// Wynik analizy nagrania wykonanej w wątku roboczym
+struct VideoScanResult {
+    QString fileName;
+    std::vector<qrcore::VideoCodeRecord> records;
+    qrcore::VideoDecodeStats stats;
+};
+
+// Pamięć wyrenderowanych podglądów (klucz: rozmiar docelowy, maks. wersja + treść)
+using PreviewImageCache = qrcore::LruCache<std::string, PreviewResult>;
+
 class QRGenerator : public QMainWindow
 {
     Q_OBJECT
@@ -119,12 +149,30 @@ private slots:
     void readQRFromFile();
     void readQRFromCamera();
     void readQRFromScreen();
+    void readQRFromVideo();
+    void onVideoScanFinished();
     
     // Sloty dla akcji z kodem QR
     void saveQRImage();
     void copyToClipboard();
     void clearQR();
     void copyResult();
+    
+    // Odbiór wyniku asynchronicznego podglądu
+    void onPreviewFinished();
+    
+    // Wyniki potoku kamery (dostarczane kolejkowo z wątków dekodujących)
+    void onCameraCodeDecoded(const QByteArray& payload, const QPolygonF& corners);
+    void onCameraStructuredAppendProgress(int received, int total);
+    void onCameraFailed(const QString& message);
+    void onCameraSourceFinished();
+    
+    // Sloty transmisji animowanej (kod fontannowy)
+    void chooseTransferFile();
+    void toggleTransferSending();
+    void showNextTransferFrame();
+    void receiveTransferFromCamera();
+    void receiveTransferFromRecording();
 
 private:
     // Metody inicjalizacji interfejsu
@@ -134,10 +182,15 @@ private:
     void setupContactTab();
     void setupWiFiTab();
     void setupReaderTab();
+    void setupTransferTab();
     void setupQRPanel(QWidget* parent);
     
     // Metody generowania kodów QR
     void generateQRCode(const QString& data);
+    void startPreviewJob();
+    static PreviewResult renderPreview(const QString& data, const QSize& targetSize, int maxVersion,
+                                       quint64 requestId, const std::atomic<quint64>* latestRequest,
+                                       qrcore::SymbolCache* symbolCache, PreviewImageCache* imageCache);
     QPixmap createQRImage(const QString& data, int size = 300);
     
     // Metody obsługi WiFi
@@ -149,7 +202,16 @@ private:
     
     // Metody odczytu QR
     QString decodeQRFromImage(const cv::Mat& image);
+    void stopCamera();
     void displayQRResult(const QString& result, const QString& type = "");
+    void displayQRResults(const std::vector<qrcore::DecodeResult>& results, const QString& type);
+    
+    // Metody transmisji animowanej
+    void stopTransferSending();
+    bool startTransferReceiving(const QString& recordingPath);
+    void handleTransferFrame(const QByteArray& payload);
+    void updateTransferStatus();
+    void finishTransfer();
     
     // Pomocnicze metody
     QString generateVCard() const;
@@ -161,7 +223,20 @@ private:
     // Główne komponenty UI
     QTabWidget* m_tabWidget;
     QLabel* m_qrLabel;
+    QSpinBox* m_maxVersionSpin;
     QPixmap m_currentQR;
+    std::shared_ptr<const qrcore::QRMatrix> m_currentMatrix;
+    
+    // Asynchroniczny podgląd (wygrywa najnowsze żądanie)
+    QFutureWatcher<PreviewResult>* m_previewWatcher;
+    std::atomic<quint64> m_previewRequestId;
+    QString m_pendingPreviewData;
+    QString m_previewData;  // treść bieżącego podglądu (ponowne renderowanie po zmianie ustawień)
+    bool m_previewPending;
+    
+    // Pamięć podręczna zakodowanych symboli i gotowych podglądów
+    qrcore::SymbolCache m_symbolCache;
+    PreviewImageCache m_previewCache;
     
     // Zakładka URL
     QLineEdit* m_urlEdit;
@@ -191,6 +266,30 @@ private:
     QPushButton* m_readFileButton;
     QPushButton* m_readCameraButton;
     QPushButton* m_readScreenButton;
+    QPushButton* m_readVideoButton;
+    
+    // Analiza nagrania w tle (segmenty dekodowane równolegle)
+    QFutureWatcher<VideoScanResult>* m_videoWatcher;
+    std::atomic<bool> m_videoScanCancelled;
+    
+    // Zakładka Transmisja - nadawanie
+    QLineEdit* m_transferFileEdit;
+    QSpinBox* m_transferVersionSpin;
+    QSpinBox* m_transferFpsSpin;
+    QPushButton* m_transferSendButton;
+    QLabel* m_transferFrameLabel;
+    QTimer* m_transferTimer;
+    qrcore::FountainEncoder m_fountainEncoder;
+    quint32 m_transferSeed;
+    
+    // Zakładka Transmisja - odbiór
+    QPushButton* m_transferCameraButton;
+    QPushButton* m_transferRecordingButton;
+    QProgressBar* m_transferProgress;
+    QLabel* m_transferStatusLabel;
+    qrcore::FountainDecoder m_fountainDecoder;
+    bool m_transferReceiving;       // potok kamery zasila dekoder fontannowy
+    QElapsedTimer m_transferClock;  // od pierwszej przyjętej ramki
     
     // Przyciski akcji
     QPushButton* m_saveImageButton;
@@ -203,9 +302,8 @@ private:
     QString m_wifiFile;
     QString m_encryptionKey;
     
-    // OpenCV dla kamery
-    cv::VideoCapture m_camera;
-    QTimer* m_cameraTimer;
+    // Wielowątkowy potok kamery (przechwytywanie + dekodery)
+    qrcore::CameraPipeline* m_cameraPipeline;
 };
 
 #endif // QRGENERATOR_H
@@ -0,0 +1,254 @@
+#include "cli_commands.h"
+#include "cli_support.h"
+
+#include "qrcore/binarizer.h"
+#include "qrcore/decoder_backend.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace cli {
+
+namespace {
+
+// Wyniki jednego backendu na całym korpusie
+struct BackendRun {
+    std::string name;
+    std::unique_ptr<qrcore::DecoderBackend> backend;
+    std::vector<double> milliseconds; // najlepszy czas z powtórzeń dla każdej klatki
+    size_t found = 0;
+    size_t agreed = 0;                // klatki z tym samym wynikiem co opencv
+};
+
+double percentile(std::vector<double> values, double fraction)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * (values.size() - 1) + 0.5));
+    return values[index];
+}
+
+double mean(const std::vector<double>& values)
+{
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+    return values.empty() ? 0.0 : sum / values.size();
+}
+
+// Pierwsza odczytana treść - porównanie backendów klatka po klatce
+std::string firstText(const std::vector<qrcore::DecodeResult>& results)
+{
+    return results.empty() ? std::string() : results.front().text;
+}
+
+// Klatki korpusu w skali szarości: obrazy katalogu (rekurencyjnie),
+// pojedynczy obraz albo kolejne klatki nagrania; false, gdy źródła nie da się otworzyć
+bool forEachFrame(const fs::path& source, size_t limit, const std::function<void(const cv::Mat&, const std::string&)>& visit)
+{
+    std::error_code error;
+    size_t count = 0;
+
+    if (fs::is_directory(source, error)) {
+        std::vector<fs::path> paths;
+        for (fs::recursive_directory_iterator it(source, fs::directory_options::skip_permission_denied, error), end;
+             it != end; it.increment(error)) {
+            if (error) {
+                break;
+            }
+            if (it->is_regular_file(error) && isImageFile(it->path())) {
+                paths.push_back(it->path());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        for (const fs::path& path : paths) {
+            if (limit && count >= limit) {
+                break;
+            }
+            const cv::Mat image = cv::imread(path.string(), cv::IMREAD_GRAYSCALE);
+            if (!image.empty()) {
+                visit(image, path.string());
+                ++count;
+            }
+        }
+        return true;
+    }
+
+    if (isImageFile(source)) {
+        const cv::Mat image = cv::imread(source.string(), cv::IMREAD_GRAYSCALE);
+        if (image.empty()) {
+            return false;
+        }
+        visit(image, source.string());
+        return true;
+    }
+
+    cv::VideoCapture capture(source.string());
+    if (!capture.isOpened()) {
+        return false;
+    }
+    cv::Mat frame;
+    cv::Mat gray;
+    while ((!limit || count < limit) && capture.read(frame)) {
+        if (frame.channels() == 1) {
+            gray = frame;
+        } else {
+            cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+        }
+        visit(gray, source.string() + "#" + std::to_string(count));
+        ++count;
+    }
+    return true;
+}
+
+} // namespace
+
+int runBenchDecode(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Porównanie backendów dekodowania klatka po klatce na tym samym korpusie.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("bench-decode", "Nazwa polecenia.");
+    parser.addPositionalArgument("korpus", "Katalog obrazów (rekurencyjnie), pojedynczy obraz albo nagranie wideo.");
+
+    QCommandLineOption decodersOption("decoders",
+        QString("Porównywane backendy (domyślnie wszystkie: %1).")
+            .arg(QString::fromStdString(joinNames(qrcore::availableDecoderBackends()))), "LISTA");
+    QCommandLineOption repeatOption("repeat", "Powtórzenia każdej klatki - liczy się najlepszy czas (domyślnie 3).", "N", "3");
+    QCommandLineOption framesOption("frames", "Najwyżej N klatek korpusu (domyślnie wszystkie).", "N", "0");
+    QCommandLineOption multipleOption("multi", "Odczyt wszystkich kodów klatki zamiast pierwszego.");
+    QCommandLineOption binarizeOption("binarize",
+        "Progowanie lokalne jak w kaskadzie (off, bradley, sauvola, z :always - przed backendem); "
+        "czas progowania wlicza się do czasu backendu (domyślnie off).", "STRATEGIA", "off");
+    QCommandLineOption verboseOption("per-frame", "Czasy i wyniki każdej klatki na standardowym wyjściu.");
+    parser.addOptions({decodersOption, repeatOption, framesOption, multipleOption, binarizeOption, verboseOption});
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 2) {
+        parser.showHelp(1);
+    }
+
+    std::vector<std::string> names = qrcore::availableDecoderBackends();
+    if (parser.isSet(decodersOption)) {
+        names = qrcore::parseDecoderBackends(parser.value(decodersOption).toStdString());
+        if (names.empty()) {
+            std::fprintf(stderr, "Nieznany backend dekodowania: %s\n", qPrintable(parser.value(decodersOption)));
+            return 1;
+        }
+    }
+
+    std::vector<BackendRun> runs;
+    size_t reference = names.size(); // indeks opencv - punkt odniesienia, jeśli jest na liście
+    for (const std::string& name : names) {
+        if (name == "opencv") {
+            reference = runs.size();
+        }
+        runs.push_back(BackendRun{name, qrcore::createDecoderBackend(name), {}, 0, 0});
+    }
+
+    qrcore::BinarizeOptions binarize;
+    if (!qrcore::parseBinarization(parser.value(binarizeOption).toStdString(), binarize)) {
+        std::fprintf(stderr, "Nieznana strategia progowania: %s\n", qPrintable(parser.value(binarizeOption)));
+        return 1;
+    }
+    qrcore::Binarizer binarizer(binarize);
+
+    const int repeat = std::max(1, parser.value(repeatOption).toInt());
+    const size_t limit = static_cast<size_t>(std::max(0, parser.value(framesOption).toInt()));
+    const bool multiple = parser.isSet(multipleOption);
+    const bool verbose = parser.isSet(verboseOption);
+
+    // Pomiar czasu pojedynczego backendu - bez wątków OpenCV konkurujących o rdzenie
+    cv::setNumThreads(1);
+
+    size_t frameCount = 0;
+    std::vector<std::string> texts(runs.size());
+    const bool opened = forEachFrame(fs::path(positional.at(1).toStdString()), limit,
+                                     [&](const cv::Mat& gray, const std::string& label) {
+        for (size_t i = 0; i < runs.size(); i++) {
+            BackendRun& run = runs[i];
+            std::vector<qrcore::DecodeResult> results;
+            double best = 0.0;
+            for (int attempt = 0; attempt < repeat; attempt++) {
+                const Clock::time_point start = Clock::now();
+                try {
+                    if (!binarize.enabled()) {
+                        results = run.backend->decode(gray, multiple);
+                    } else if (binarize.stage == qrcore::BinarizeStage::Always) {
+                        results = run.backend->decode(binarizer.apply(gray), multiple);
+                    } else {
+                        results = run.backend->decode(gray, multiple);
+                        if (results.empty()) {
+                            results = run.backend->decode(binarizer.apply(gray), multiple);
+                        }
+                    }
+                } catch (const std::exception& e) {
+                    results.clear();
+                    std::fprintf(stderr, "%s: błąd backendu %s: %s\n", label.c_str(), run.name.c_str(), e.what());
+                }
+                const double elapsed = millisecondsSince(start);
+                best = attempt == 0 ? elapsed : std::min(best, elapsed);
+            }
+            run.milliseconds.push_back(best);
+            run.found += results.empty() ? 0 : 1;
+            texts[i] = firstText(results);
+            if (verbose) {
+                std::printf("%s\t%s\t%.3f ms\t%zu\n", label.c_str(), run.name.c_str(), best, results.size());
+            }
+        }
+        if (reference < runs.size()) {
+            for (size_t i = 0; i < runs.size(); i++) {
+                runs[i].agreed += texts[i] == texts[reference] ? 1 : 0;
+            }
+        }
+        ++frameCount;
+    });
+
+    if (!opened) {
+        std::fprintf(stderr, "Nie można otworzyć korpusu: %s\n", qPrintable(positional.at(1)));
+        return 1;
+    }
+    if (frameCount == 0) {
+        std::fprintf(stderr, "Korpus nie zawiera obrazów\n");
+        return 1;
+    }
+
+    const double referenceMean = reference < runs.size() ? mean(runs[reference].milliseconds) : 0.0;
+    std::printf("Klatki: %zu, powtórzenia: %d\n", frameCount, repeat);
+    std::printf("%-8s %10s %10s %10s %10s %10s %10s\n", "backend", "odczyty", "śr. ms", "p50 ms", "p95 ms",
+                "przysp.", "zgodność");
+    for (const BackendRun& run : runs) {
+        const double meanMs = mean(run.milliseconds);
+        std::printf("%-8s %9.1f%% %10.2f %10.2f %10.2f", run.name.c_str(), 100.0 * run.found / frameCount, meanMs,
+                    percentile(run.milliseconds, 0.5), percentile(run.milliseconds, 0.95));
+        if (reference < runs.size() && meanMs > 0) {
+            std::printf(" %9.1fx %9.1f%%\n", referenceMean / meanMs, 100.0 * run.agreed / frameCount);
+        } else {
+            std::printf(" %10s %10s\n", "-", "-");
+        }
+    }
+    return 0;
+}
+
+} // namespace cli
@@ -0,0 +1,66 @@
+#include "cli_commands.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace cli {
+
+namespace {
+
+struct Command {
+    const char* name;
+    int (*handler)(int, char*[]);
+    const char* description;
+};
+
+const Command kCommands[] = {
+    {"decode", runDecode, "wsadowe dekodowanie obrazów z katalogu (wynik JSONL)"},
+    {"bench-decode", runBenchDecode, "porównanie czasu i skuteczności backendów dekodowania"},
+    {"scan-video", runScanVideo, "odczyt kodów z pliku wideo (wystąpienia z czasem, JSONL)"},
+    {"encode", runEncode, "wsadowe generowanie kodów z pliku CSV lub JSONL"},
+    {"serial", runSerial, "seria etykiet PREFIKS + licznik kodowana przyrostowo"},
+    {"verify-encoder", runVerifyEncoder, "porównanie wbudowanego kodera z libqrencode"},
+};
+
+void printUsage()
+{
+    std::fprintf(stderr, "Użycie: qr-generator <polecenie> [opcje]\n\nPolecenia:\n");
+    for (const Command& command : kCommands) {
+        std::fprintf(stderr, "  %-15s %s\n", command.name, command.description);
+    }
+    std::fprintf(stderr, "\nBez polecenia uruchamiany jest interfejs graficzny.\n");
+}
+
+} // namespace
+
+bool isCliInvocation(int argc, char* argv[])
+{
+    if (argc < 2) {
+        return false;
+    }
+
+    if (!std::strcmp(argv[1], "help") || !std::strcmp(argv[1], "--help-cli")) {
+        return true;
+    }
+
+    for (const Command& command : kCommands) {
+        if (!std::strcmp(argv[1], command.name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int run(int argc, char* argv[])
+{
+    for (const Command& command : kCommands) {
+        if (argc >= 2 && !std::strcmp(argv[1], command.name)) {
+            return command.handler(argc, argv);
+        }
+    }
+
+    printUsage();
+    return 1;
+}
+
+} // namespace cli
@@ -0,0 +1,94 @@
+#ifndef CLI_SUPPORT_H
+#define CLI_SUPPORT_H
+
+#include "qrcore/qr_encoder.h"
+
+#include <QtCore/QString>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace cli {
+
+using Clock = std::chrono::steady_clock;
+
+inline double millisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Czy rozszerzenie pliku wskazuje obraz czytany przez OpenCV
+inline bool isImageFile(const std::filesystem::path& path)
+{
+    static const std::set<std::string> extensions = {
+        ".png", ".jpg", ".jpeg", ".bmp", ".gif", ".tif", ".tiff", ".webp", ".pbm", ".pgm", ".ppm"
+    };
+
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extensions.count(extension) > 0;
+}
+
+// Nazwy rozdzielone przecinkami (np. lista backendów w opisie opcji)
+inline std::string joinNames(const std::vector<std::string>& names)
+{
+    std::string joined;
+    for (const std::string& name : names) {
+        joined += (joined.empty() ? "" : ",") + name;
+    }
+    return joined;
+}
+
+// Poziom korekcji z litery L/M/Q/H; false dla innej wartości
+inline bool parseErrorCorrection(const QString& value, qrcore::ErrorCorrection& level)
+{
+    const QString upper = value.trimmed().toUpper();
+    if (upper == "L") { level = qrcore::ErrorCorrection::Low; return true; }
+    if (upper == "M") { level = qrcore::ErrorCorrection::Medium; return true; }
+    if (upper == "Q") { level = qrcore::ErrorCorrection::Quartile; return true; }
+    if (upper == "H") { level = qrcore::ErrorCorrection::High; return true; }
+    return false;
+}
+
+// Ogranicza liczbę elementów w drodze (wczytanych, a nie zapisanych).
+// Producent blokuje się w acquire(), dopóki robotnicy nie nadrobią zaległości,
+// dzięki czemu zużycie pamięci nie zależy od wielkości wsadu.
+class InFlightLimiter
+{
+public:
+    explicit InFlightLimiter(size_t limit) : m_limit(limit > 0 ? limit : 1) {}
+
+    void acquire()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_released.wait(lock, [this]() { return m_count < m_limit; });
+        ++m_count;
+    }
+
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_count;
+        }
+        m_released.notify_one();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+    size_t m_count = 0;
+    size_t m_limit;
+};
+
+} // namespace cli
+
+#endif // CLI_SUPPORT_H
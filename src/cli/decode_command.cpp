@@ -0,0 +1,279 @@
+#include "cli_commands.h"
+#include "cli_support.h"
+
+#include "qrcore/binarizer.h"
+#include "qrcore/decoder_backend.h"
+#include "qrcore/photo_decoder.h"
+#include "qrcore/thread_pool.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <opencv2/core.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace cli {
+
+namespace {
+
+// Przejście drzewa katalogów, które nie kończy się na pierwszym błędzie:
+// nieczytelny podkatalog albo plik usunięty w trakcie przebiegu jest
+// zgłaszany na stderr i pomijany. Dowiązania do katalogów nie są śledzone
+// (jak w recursive_directory_iterator). Zwraca liczbę zgłoszonych błędów.
+size_t walkDirectory(const fs::path& root, const std::function<void(const fs::path&)>& visit)
+{
+    size_t errors = 0;
+    auto report = [&](const fs::path& path, const std::error_code& error) {
+        std::fprintf(stderr, "Pominięto %s: %s\n", path.string().c_str(), error.message().c_str());
+        ++errors;
+    };
+
+    std::vector<fs::path> pending{root};
+    while (!pending.empty()) {
+        const fs::path directory = std::move(pending.back());
+        pending.pop_back();
+
+        std::error_code error;
+        fs::directory_iterator it(directory, fs::directory_options::skip_permission_denied, error);
+        for (const fs::directory_iterator end; !error && it != end; it.increment(error)) {
+            std::error_code entryError;
+            const fs::file_status status = it->symlink_status(entryError);
+            if (!entryError && fs::is_directory(status)) {
+                pending.push_back(it->path());
+            } else if (!entryError && it->is_regular_file(entryError)) {
+                visit(it->path());
+            }
+            if (entryError) {
+                report(it->path(), entryError);
+            }
+        }
+        if (error) {
+            report(directory, error);
+        }
+    }
+    return errors;
+}
+
+bool readFile(const fs::path& path, std::vector<uchar>& data)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+
+    const std::streamsize size = file.tellg();
+    if (size <= 0) {
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), size));
+}
+
+// Jeden wiersz JSONL z wynikiem dla pliku
+QByteArray resultLine(const std::string& path, const std::vector<qrcore::DecodeResult>& results, int reduction,
+                      double readMs, double decodeMs, const QString& error)
+{
+    QJsonObject line;
+    line["path"] = QString::fromStdString(path);
+
+    QJsonArray payloads;
+    for (const qrcore::DecodeResult& result : results) {
+        QJsonArray polygon;
+        for (const cv::Point2f& point : result.corners) {
+            polygon.append(QJsonArray{qRound(point.x * 10) / 10.0, qRound(point.y * 10) / 10.0});
+        }
+
+        QJsonObject payload;
+        payload["text"] = QString::fromUtf8(result.text.data(), static_cast<int>(result.text.size()));
+        payload["polygon"] = polygon;
+        payloads.append(payload);
+    }
+    line["payloads"] = payloads;
+    line["reduction"] = reduction;
+    line["read_ms"] = qRound(readMs * 100) / 100.0;
+    line["decode_ms"] = qRound(decodeMs * 100) / 100.0;
+
+    if (!error.isEmpty()) {
+        line["error"] = error;
+    }
+
+    return QJsonDocument(line).toJson(QJsonDocument::Compact) + '\n';
+}
+
+} // namespace
+
+int runDecode(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Wsadowe dekodowanie kodów QR. Wyniki (JSONL) trafiają na standardowe wyjście.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("decode", "Nazwa polecenia.");
+    parser.addPositionalArgument("katalog", "Katalog przeszukiwany rekurencyjnie (lub pojedynczy plik).");
+
+    QCommandLineOption jobsOption({"j", "jobs"}, "Liczba wątków dekodujących (domyślnie: liczba rdzeni).", "N");
+    QCommandLineOption prefetchOption("prefetch", "Liczba plików wczytywanych z wyprzedzeniem na wątek (domyślnie 2).", "N", "2");
+    QCommandLineOption decodersOption("decoders",
+        QString("Kaskada backendów dekodowania, od najtańszego (dostępne: %1).")
+            .arg(QString::fromStdString(joinNames(qrcore::availableDecoderBackends()))), "LISTA");
+    QCommandLineOption binarizeOption("binarize",
+        "Progowanie lokalne: off, bradley, sauvola (drugie podejście po porażce backendów) "
+        "lub z dopiskiem :always - przed każdym dekodowaniem (domyślnie sauvola).", "STRATEGIA");
+    QCommandLineOption fullResolutionOption("full-resolution",
+        "JPEG zawsze w pełnej rozdzielczości (bez wstępnego odczytu pomniejszenia 1/2-1/8).");
+    QCommandLineOption statsOption("backend-stats", "Statystyki backendów (skuteczność, czas) na wyjściu błędów.");
+    parser.addOption(jobsOption);
+    parser.addOption(prefetchOption);
+    parser.addOption(decodersOption);
+    parser.addOption(binarizeOption);
+    parser.addOption(fullResolutionOption);
+    parser.addOption(statsOption);
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 2) {
+        parser.showHelp(1);
+    }
+
+    const fs::path root = fs::path(positional.at(1).toStdString());
+    std::error_code error;
+    if (!fs::exists(root, error)) {
+        std::fprintf(stderr, "Nie znaleziono: %s\n", root.string().c_str());
+        return 1;
+    }
+
+    const int jobs = parser.isSet(jobsOption) ? parser.value(jobsOption).toInt() : qrcore::defaultThreadCount();
+    const int prefetch = std::max(1, parser.value(prefetchOption).toInt());
+    
+    if (parser.isSet(decodersOption)) {
+        const std::vector<std::string> backends =
+            qrcore::parseDecoderBackends(parser.value(decodersOption).toStdString());
+        if (backends.empty() || !qrcore::setDecoderCascade(backends)) {
+            std::fprintf(stderr, "Nieznany backend dekodowania: %s\n", qPrintable(parser.value(decodersOption)));
+            return 1;
+        }
+    }
+
+    if (parser.isSet(binarizeOption)) {
+        qrcore::BinarizeOptions binarize;
+        if (!qrcore::parseBinarization(parser.value(binarizeOption).toStdString(), binarize)) {
+            std::fprintf(stderr, "Nieznana strategia progowania: %s\n", qPrintable(parser.value(binarizeOption)));
+            return 1;
+        }
+        qrcore::setDefaultBinarization(binarize);
+    }
+
+    qrcore::PhotoDecodeOptions photoOptions;
+    photoOptions.reducedJpeg = !parser.isSet(fullResolutionOption);
+    photoOptions.pyramid.parallel = false;
+
+    // Równoległość zapewniają pliki - wewnętrzne wątki OpenCV tylko by ze sobą konkurowały
+    cv::setNumThreads(1);
+
+    qrcore::ThreadPool pool(jobs);
+    InFlightLimiter limiter(static_cast<size_t>(pool.threadCount()) * prefetch);
+    std::mutex outputMutex;
+    size_t fileCount = 0;
+    size_t foundCount = 0;
+    const Clock::time_point batchStart = Clock::now();
+
+    auto process = [&](const fs::path& path) {
+        // Wczytanie pliku (prefetch) w wątku przeglądającym katalog
+        limiter.acquire();
+        const Clock::time_point readStart = Clock::now();
+        auto data = std::make_shared<std::vector<uchar>>();
+        const bool readOk = readFile(path, *data);
+        const double readMs = millisecondsSince(readStart);
+        ++fileCount;
+
+        pool.submit([&, path, data, readOk, readMs]() {
+            std::vector<qrcore::DecodeResult> results;
+            qrcore::PhotoDecodeInfo info;
+            QString errorMessage;
+            const Clock::time_point decodeStart = Clock::now();
+
+            if (!readOk) {
+                errorMessage = "Nie można odczytać pliku";
+            } else {
+                try {
+                    // Skala szarości już przy dekompresji - bez konwersji kolorów;
+                    // JPEG najpierw w pomniejszeniu (DCT), pełny tylko w razie potrzeby
+                    results = qrcore::decodePhoto(*data, photoOptions, &info);
+                    data->clear();
+                    data->shrink_to_fit();
+                    if (info.fullSize.empty()) {
+                        errorMessage = "Nieobsługiwany format obrazu";
+                    }
+                } catch (const std::exception& e) {
+                    errorMessage = QString::fromUtf8(e.what());
+                }
+            }
+
+            const QByteArray line = resultLine(path.string(), results, info.reduction, readMs,
+                                               millisecondsSince(decodeStart), errorMessage);
+            {
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::fwrite(line.constData(), 1, static_cast<size_t>(line.size()), stdout);
+                if (!results.empty()) {
+                    ++foundCount;
+                }
+            }
+            limiter.release();
+        });
+    };
+
+    size_t walkErrors = 0;
+    if (fs::is_directory(root, error)) {
+        walkErrors = walkDirectory(root, [&](const fs::path& path) {
+            if (isImageFile(path)) {
+                process(path);
+            }
+        });
+    } else {
+        process(root);
+    }
+
+    pool.wait();
+    std::fflush(stdout);
+
+    const double seconds = millisecondsSince(batchStart) / 1000.0;
+    std::fprintf(stderr, "Przetworzono %zu plików (%zu z kodami) w %.2f s - %.1f plików/s, %d wątków\n",
+                 fileCount, foundCount, seconds, seconds > 0 ? fileCount / seconds : 0.0, pool.threadCount());
+    
+    if (parser.isSet(statsOption)) {
+        // Próby backendu = obrazy (wycinki, kafelki), które do niego dotarły w kaskadzie
+        std::fprintf(stderr, "Kaskada: %s\n", joinNames(qrcore::decoderCascade()).c_str());
+        for (const qrcore::DecoderBackendStats& stats : qrcore::decoderBackendStats()) {
+            std::fprintf(stderr, "  %-8s prób: %8llu  odczytów: %8llu (%5.1f%%)  śr. czas: %8.2f ms\n",
+                         stats.name.c_str(), static_cast<unsigned long long>(stats.attempts),
+                         static_cast<unsigned long long>(stats.successes), stats.successRate() * 100.0,
+                         stats.meanMilliseconds());
+        }
+    }
+
+    // Niepełny przebieg nie może wyglądać na udany (zadania nocne)
+    if (walkErrors > 0) {
+        std::fprintf(stderr, "Nie udało się odczytać %zu ścieżek - wynik jest niepełny\n", walkErrors);
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace cli
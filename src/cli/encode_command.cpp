@@ -0,0 +1,324 @@
+#include "cli_commands.h"
+#include "cli_support.h"
+#include "output_sink.h"
+#include "record_reader.h"
+
+#include "qrcore/bitmap_writer.h"
+#include "qrcore/payload.h"
+#include "qrcore/symbol_cache.h"
+#include "qrcore/thread_pool.h"
+#include "qrcore/vector_writer.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFileInfo>
+
+#include <atomic>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+namespace cli {
+
+namespace {
+
+bool isTrue(const QString& value)
+{
+    const QString lower = value.trimmed().toLower();
+    return lower == "true" || lower == "1" || lower == "yes" || lower == "tak";
+}
+
+// Treść symbolu z rekordu. Kolumna "type" (url/text/vcard/wifi) jest opcjonalna -
+// bez niej typ wynika z wypełnionych pól (jak w zakładkach GUI).
+QString payloadForRecord(const Record& record, QString* error)
+{
+    QString type = record.value("type").trimmed().toLower();
+    auto has = [&](const char* key) { return !record.value(key).trimmed().isEmpty(); };
+
+    if (type.isEmpty()) {
+        if (has("ssid")) {
+            type = "wifi";
+        } else if (has("first_name") || has("last_name") || has("phone") || has("email") || has("company")) {
+            type = "vcard";
+        } else if (has("url")) {
+            type = "url";
+        } else {
+            type = "text";
+        }
+    }
+
+    if (type == "url") {
+        return qrcore::urlPayload(record.value("url").trimmed());
+    }
+
+    if (type == "text") {
+        return (has("text") ? record.value("text") : record.value("data")).trimmed();
+    }
+
+    if (type == "vcard" || type == "contact") {
+        qrcore::ContactData contact;
+        contact.firstName = record.value("first_name").trimmed();
+        contact.lastName = record.value("last_name").trimmed();
+        contact.phone = record.value("phone").trimmed();
+        contact.email = record.value("email").trimmed();
+        contact.company = record.value("company").trimmed();
+        contact.website = record.value("website").trimmed();
+        return qrcore::vCardPayload(contact);
+    }
+
+    if (type == "wifi") {
+        qrcore::WiFiData wifi;
+        wifi.ssid = record.value("ssid").trimmed();
+        wifi.password = record.value("password");
+        if (has("security")) {
+            wifi.security = record.value("security").trimmed();
+        }
+        wifi.hidden = isTrue(record.value("hidden"));
+        return qrcore::wifiPayload(wifi);
+    }
+
+    if (error) {
+        *error = "Nieznany typ rekordu: " + type;
+    }
+    return QString();
+}
+
+// Nazwa pliku z kolumny "id"/"name" (bez znaków niedozwolonych) lub numeru wiersza
+QString baseNameForRecord(const Record& record, qint64 number)
+{
+    QString name = record.value("id").trimmed();
+    if (name.isEmpty()) {
+        name = record.value("name").trimmed();
+    }
+
+    QString safe;
+    for (const QChar c : name) {
+        safe += (c.isLetterOrNumber() || c == '-' || c == '_' || c == '.') ? c : QChar('_');
+    }
+    if (safe.isEmpty() || safe.startsWith('.')) {
+        safe = QString("row_%1").arg(number, 6, 10, QChar('0'));
+    }
+    return safe;
+}
+
+} // namespace
+
+int runEncode(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Wsadowe generowanie kodów QR z plików CSV lub JSONL.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("encode", "Nazwa polecenia.");
+    parser.addPositionalArgument("wejscie", "Plik CSV/JSONL (\"-\" = standardowe wejście).");
+
+    QCommandLineOption outputOption({"o", "output"},
+        "Katalog wyjściowy lub archiwum *.zip / *.tar (\"-\" = TAR na standardowe wyjście; domyślnie: qr_output).",
+        "ścieżka", "qr_output");
+    QCommandLineOption compressOption("compress", "Kompresja deflate wpisów archiwum ZIP (liczona w wątkach roboczych).");
+    QCommandLineOption formatOption("format", "Format wejścia: csv lub jsonl (domyślnie wg rozszerzenia).", "format");
+    QCommandLineOption scalesOption("scales", "Skale (piksele na moduł) rozdzielone przecinkami, np. 4,8,16.", "lista", "8");
+    QCommandLineOption sizeOption("size",
+        "Bok rastra w pikselach zamiast --scales (dowolny, np. plakat 40000; pamięć ograniczona pasami).", "px");
+    QCommandLineOption imageFormatOption("image-format", "Format rastrów 1-bitowych: png lub tiff (CCITT G4; domyślnie png).",
+        "format", "png");
+    QCommandLineOption dpiOption("dpi", "Rozdzielczość zapisana w metadanych PNG/TIFF.", "DPI");
+    QCommandLineOption vectorOption("vector",
+        "Dodatkowe pliki wektorowe rozdzielone przecinkami: svg, pdf, eps (moduł = pierwsza skala w px/pt).", "lista");
+    QCommandLineOption borderOption("border", "Strefa ciszy w modułach (domyślnie 4).", "N", "4");
+    QCommandLineOption ecOption("ec", "Poziom korekcji błędów: L, M, Q, H (domyślnie M).", "poziom", "M");
+    QCommandLineOption backendOption("backend", "Koder: libqrencode lub native (wbudowany; domyślnie libqrencode).",
+        "nazwa", "libqrencode");
+    QCommandLineOption byteModeOption("byte-mode", "Cała treść jednym segmentem bajtowym (bez optymalnego podziału na tryby).");
+    QCommandLineOption kanjiOption("kanji", "Znaki japońskie w trybie Kanji (13 bitów zamiast 24 w UTF-8).");
+    QCommandLineOption jobsOption({"j", "jobs"}, "Liczba wątków (domyślnie: liczba rdzeni).", "N");
+    QCommandLineOption queueOption("queue", "Maksymalna liczba wierszy w drodze na wątek (domyślnie 8).", "N", "8");
+    parser.addOptions({outputOption, compressOption, formatOption, scalesOption, sizeOption, imageFormatOption, dpiOption, vectorOption, borderOption, ecOption, backendOption, byteModeOption, kanjiOption, jobsOption, queueOption});
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 2) {
+        parser.showHelp(1);
+    }
+    const QString inputPath = positional.at(1);
+
+    // Format wejścia
+    QString format = parser.value(formatOption).toLower();
+    if (format.isEmpty()) {
+        format = QFileInfo(inputPath).suffix().toLower() == "csv" ? "csv" : "jsonl";
+    }
+    if (format != "csv" && format != "jsonl") {
+        std::fprintf(stderr, "Nieobsługiwany format wejścia: %s\n", qPrintable(format));
+        return 1;
+    }
+
+    // Parametry symboli
+    qrcore::EncodeOptions encodeOptions;
+    if (!parseErrorCorrection(parser.value(ecOption), encodeOptions.ecLevel)) {
+        std::fprintf(stderr, "Nieznany poziom korekcji błędów: %s\n", qPrintable(parser.value(ecOption)));
+        return 1;
+    }
+
+    encodeOptions.optimizeSegments = !parser.isSet(byteModeOption);
+    encodeOptions.allowKanji = parser.isSet(kanjiOption);
+
+    const QString backend = parser.value(backendOption).trimmed().toLower();
+    if (backend == "native") {
+        encodeOptions.backend = qrcore::EncoderBackend::Native;
+    } else if (backend != "libqrencode") {
+        std::fprintf(stderr, "Nieznany koder: %s\n", qPrintable(backend));
+        return 1;
+    }
+
+    std::vector<int> scales;
+    for (const QString& value : parser.value(scalesOption).split(',', Qt::SkipEmptyParts)) {
+        const int scale = value.trimmed().toInt();
+        if (scale < 1) {
+            std::fprintf(stderr, "Niepoprawna skala: %s\n", qPrintable(value));
+            return 1;
+        }
+        scales.push_back(scale);
+    }
+    if (scales.empty()) {
+        scales.push_back(8);
+    }
+    const int border = qMax(0, parser.value(borderOption).toInt());
+
+    const QString imageExtension = parser.value(imageFormatOption).trimmed().toLower();
+    qrcore::BitmapFormat imageFormat;
+    if (!qrcore::bitmapFormatForPath(("." + imageExtension).toStdString(), imageFormat)) {
+        std::fprintf(stderr, "Nieobsługiwany format rastra: %s\n", qPrintable(imageExtension));
+        return 1;
+    }
+    const double dpi = parser.isSet(dpiOption) ? parser.value(dpiOption).toDouble() : 0.0;
+    const int outputSize = parser.isSet(sizeOption) ? parser.value(sizeOption).toInt() : 0;
+    if (parser.isSet(sizeOption) && outputSize < 1) {
+        std::fprintf(stderr, "Niepoprawny bok rastra: %s\n", qPrintable(parser.value(sizeOption)));
+        return 1;
+    }
+    if (outputSize > 0) {
+        // Jeden raster o zadanym boku zamiast listy skal
+        scales.resize(1);
+    }
+
+    std::vector<std::pair<qrcore::VectorFormat, QString>> vectorFormats;
+    for (const QString& value : parser.value(vectorOption).split(',', Qt::SkipEmptyParts)) {
+        const QString extension = value.trimmed().toLower();
+        qrcore::VectorFormat vectorFormat;
+        if (!qrcore::vectorFormatForPath(("." + extension).toStdString(), vectorFormat)) {
+            std::fprintf(stderr, "Nieobsługiwany format wektorowy: %s\n", qPrintable(value));
+            return 1;
+        }
+        vectorFormats.emplace_back(vectorFormat, extension);
+    }
+
+    RecordReader reader;
+    if (!reader.open(inputPath, format == "csv" ? RecordReader::Format::Csv : RecordReader::Format::JsonLines)) {
+        std::fprintf(stderr, "Nie można otworzyć wejścia: %s\n", qPrintable(reader.errorString()));
+        return 1;
+    }
+
+    QString sinkError;
+    std::unique_ptr<OutputSink> sink = createOutputSink(parser.value(outputOption), parser.isSet(compressOption), &sinkError);
+    if (!sink) {
+        std::fprintf(stderr, "%s\n", qPrintable(sinkError));
+        return 1;
+    }
+
+    const int jobs = parser.isSet(jobsOption) ? parser.value(jobsOption).toInt() : qrcore::defaultThreadCount();
+    qrcore::ThreadPool pool(jobs);
+    InFlightLimiter limiter(static_cast<size_t>(pool.threadCount()) * qMax(1, parser.value(queueOption).toInt()));
+    qrcore::SymbolCache cache;
+
+    std::atomic<qint64> written{0};
+    std::atomic<qint64> failed{0};
+    const Clock::time_point start = Clock::now();
+
+    auto reportError = [&](qint64 row, const QString& message) {
+        std::fprintf(stderr, "Wiersz %lld: %s\n", static_cast<long long>(row), qPrintable(message));
+        ++failed;
+    };
+
+    Record record;
+    while (reader.next(record)) {
+        const qint64 row = reader.recordNumber();
+        if (!reader.errorString().isEmpty()) {
+            reportError(row, reader.errorString());
+            continue;
+        }
+
+        QString error;
+        const QString payload = payloadForRecord(record, &error);
+        if (payload.isEmpty()) {
+            reportError(row, error.isEmpty() ? "Brak danych do zakodowania" : error);
+            continue;
+        }
+        const QString baseName = baseNameForRecord(record, row);
+
+        // Ograniczenie liczby wierszy w drodze - odczyt czeka na wolne miejsce
+        limiter.acquire();
+        pool.submit([&, row, payload, baseName]() {
+            // Jedno kodowanie na wiersz, wspólne dla wszystkich rozdzielczości
+            std::shared_ptr<const qrcore::QRMatrix> matrix = cache.encode(payload.toUtf8().toStdString(), encodeOptions);
+            if (!matrix) {
+                reportError(row, "Nie można zakodować danych (zbyt długie?)");
+                limiter.release();
+                return;
+            }
+
+            for (int scale : scales) {
+                qrcore::BitmapOptions bitmapOptions;
+                bitmapOptions.scale = scale;
+                bitmapOptions.border = border;
+                bitmapOptions.dpi = dpi;
+                bitmapOptions.size = outputSize;
+                // Równoległość zapewniają wiersze wejścia rozdzielone w puli
+                bitmapOptions.parallel = false;
+
+                // 1-bitowy PNG/TIFF prosto z macierzy, bez QImage
+                std::ostringstream stream;
+                const QString name = scales.size() == 1 ? baseName + "." + imageExtension
+                                                        : QString("%1@%2x.%3").arg(baseName).arg(scale).arg(imageExtension);
+                if (!qrcore::writeBitmap(*matrix, imageFormat, stream, bitmapOptions) ||
+                    !sink->write(name, QByteArray::fromStdString(stream.str()))) {
+                    reportError(row, "Nie można zapisać " + name);
+                } else {
+                    ++written;
+                }
+            }
+
+            // Wektory powstają z tej samej macierzy, niezależnie od skali rastra
+            for (const auto& [vectorFormat, extension] : vectorFormats) {
+                qrcore::VectorOptions vectorOptions;
+                vectorOptions.border = border;
+                vectorOptions.moduleSize = scales.front();
+
+                std::ostringstream stream;
+                const QString name = baseName + "." + extension;
+                if (!qrcore::writeVector(*matrix, vectorFormat, stream, vectorOptions) ||
+                    !sink->write(name, QByteArray::fromStdString(stream.str()))) {
+                    reportError(row, "Nie można zapisać " + name);
+                } else {
+                    ++written;
+                }
+            }
+            limiter.release();
+        });
+    }
+
+    pool.wait();
+    const bool finished = sink->finish();
+    if (!finished) {
+        std::fprintf(stderr, "Błąd zamykania wyjścia: %s\n", qPrintable(sink->errorString()));
+    }
+
+    const double seconds = millisecondsSince(start) / 1000.0;
+    std::fprintf(stderr, "Zapisano %lld plików z %lld wierszy (%lld błędów) w %.2f s - %.0f wierszy/s, %d wątków\n",
+                 static_cast<long long>(written.load()), static_cast<long long>(reader.recordNumber()),
+                 static_cast<long long>(failed.load()), seconds,
+                 seconds > 0 ? reader.recordNumber() / seconds : 0.0, pool.threadCount());
+    return (failed.load() == 0 && finished) ? 0 : 2;
+}
+
+} // namespace cli
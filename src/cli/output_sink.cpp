@@ -0,0 +1,86 @@
+#include "output_sink.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+namespace cli {
+
+DirectorySink::DirectorySink(const QString& directory)
+    : m_directory(directory)
+{
+}
+
+bool DirectorySink::write(const QString& name, const QByteArray& data)
+{
+    const QString path = m_directory + '/' + name;
+    if (name.contains('/')) {
+        QDir().mkpath(QFileInfo(path).absolutePath());
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
+ArchiveSink::ArchiveSink(qrcore::ArchiveWriter::Format format, qrcore::ArchiveWriter::Compression compression)
+    : m_writer(format), m_compression(compression)
+{
+}
+
+bool ArchiveSink::open(const QString& path)
+{
+    return m_writer.open(path == "-" ? std::string("-") : QFile::encodeName(path).toStdString());
+}
+
+bool ArchiveSink::write(const QString& name, const QByteArray& data)
+{
+    // Kosztowna część (CRC, deflate) poza blokadą archiwum
+    qrcore::ArchiveWriter::PreparedEntry entry = qrcore::ArchiveWriter::prepare(
+        name.toUtf8().toStdString(), reinterpret_cast<const uint8_t*>(data.constData()),
+        static_cast<size_t>(data.size()), m_compression, m_writer.format());
+    return m_writer.add(std::move(entry));
+}
+
+bool ArchiveSink::finish()
+{
+    return m_writer.finish();
+}
+
+QString ArchiveSink::errorString() const
+{
+    return QString::fromStdString(m_writer.errorString());
+}
+
+std::unique_ptr<OutputSink> createOutputSink(const QString& path, bool compress, QString* error)
+{
+    qrcore::ArchiveWriter::Format format;
+    const bool toStdout = (path == "-");
+    if (toStdout || qrcore::ArchiveWriter::formatForPath(path.toStdString(), format)) {
+        if (toStdout) {
+            format = qrcore::ArchiveWriter::Format::Tar;
+        }
+
+        std::unique_ptr<ArchiveSink> sink(new ArchiveSink(
+            format, compress ? qrcore::ArchiveWriter::Compression::Deflate : qrcore::ArchiveWriter::Compression::Store));
+        if (!sink->open(path)) {
+            if (error) {
+                *error = sink->errorString();
+            }
+            return nullptr;
+        }
+        return sink;
+    }
+
+    if (!QDir().mkpath(path)) {
+        if (error) {
+            *error = "Nie można utworzyć katalogu: " + path;
+        }
+        return nullptr;
+    }
+    return std::unique_ptr<OutputSink>(new DirectorySink(path));
+}
+
+} // namespace cli
@@ -0,0 +1,64 @@
+#ifndef CLI_OUTPUT_SINK_H
+#define CLI_OUTPUT_SINK_H
+
+#include "qrcore/archive_writer.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <memory>
+
+namespace cli {
+
+// Miejsce docelowe plików generowanych wsadowo.
+// write() jest wywoływane równocześnie z wielu wątków roboczych.
+class OutputSink
+{
+public:
+    virtual ~OutputSink() = default;
+
+    // Zapisuje plik o ścieżce względnej name; false przy błędzie
+    virtual bool write(const QString& name, const QByteArray& data) = 0;
+
+    // Domyka wyjście (np. indeks archiwum); wywoływane raz, po ostatnim write()
+    virtual bool finish() { return true; }
+
+    virtual QString errorString() const { return QString(); }
+};
+
+// Zwykłe pliki w katalogu
+class DirectorySink : public OutputSink
+{
+public:
+    explicit DirectorySink(const QString& directory);
+
+    bool write(const QString& name, const QByteArray& data) override;
+
+private:
+    QString m_directory;
+};
+
+// Strumieniowe archiwum ZIP/TAR - jeden plik zamiast milionów małych.
+// Kompresja (i CRC) liczone są w wątku wołającym write(), zapis jest szeregowany.
+class ArchiveSink : public OutputSink
+{
+public:
+    ArchiveSink(qrcore::ArchiveWriter::Format format, qrcore::ArchiveWriter::Compression compression);
+
+    bool open(const QString& path);
+    bool write(const QString& name, const QByteArray& data) override;
+    bool finish() override;
+    QString errorString() const override;
+
+private:
+    qrcore::ArchiveWriter m_writer;
+    qrcore::ArchiveWriter::Compression m_compression;
+};
+
+// Tworzy wyjście na podstawie ścieżki docelowej: *.zip / *.tar (lub "-" = TAR
+// na standardowe wyjście) to archiwum, każda inna ścieżka - katalog
+std::unique_ptr<OutputSink> createOutputSink(const QString& path, bool compress, QString* error);
+
+} // namespace cli
+
+#endif // CLI_OUTPUT_SINK_H
@@ -0,0 +1,131 @@
+#include "record_reader.h"
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <cstdio>
+
+namespace cli {
+
+bool RecordReader::open(const QString& path, Format format)
+{
+    m_format = format;
+    m_file.reset(new QFile());
+
+    bool opened = false;
+    if (path == "-") {
+        opened = m_file->open(stdin, QIODevice::ReadOnly);
+    } else {
+        m_file->setFileName(path);
+        opened = m_file->open(QIODevice::ReadOnly);
+    }
+    if (!opened) {
+        m_error = m_file->errorString();
+        return false;
+    }
+
+    if (m_format == Format::Csv) {
+        if (!readCsvFields(m_header)) {
+            m_error = "Brak wiersza nagłówka CSV";
+            return false;
+        }
+        for (QString& name : m_header) {
+            name = name.trimmed().toLower();
+        }
+    }
+    return true;
+}
+
+bool RecordReader::readCsvFields(QStringList& fields)
+{
+    fields.clear();
+    QString field;
+    bool inQuotes = false;
+    bool anyData = false;
+
+    // Pole w cudzysłowie może zawierać przecinki i znaki nowego wiersza
+    while (!m_file->atEnd()) {
+        const QString line = QString::fromUtf8(m_file->readLine());
+        anyData = true;
+
+        for (int i = 0; i < line.size(); i++) {
+            const QChar c = line.at(i);
+            if (inQuotes) {
+                if (c == '"') {
+                    if (i + 1 < line.size() && line.at(i + 1) == '"') {
+                        field += '"';
+                        i++;
+                    } else {
+                        inQuotes = false;
+                    }
+                } else {
+                    field += c;
+                }
+            } else if (c == '"') {
+                inQuotes = true;
+            } else if (c == ',') {
+                fields << field;
+                field.clear();
+            } else if (c != '\r' && c != '\n') {
+                field += c;
+            }
+        }
+
+        if (!inQuotes) {
+            fields << field;
+            return true;
+        }
+    }
+
+    if (anyData) {
+        fields << field; // niezamknięty cudzysłów na końcu pliku
+    }
+    return anyData;
+}
+
+bool RecordReader::next(Record& record)
+{
+    record.clear();
+    m_error.clear();
+
+    if (m_format == Format::Csv) {
+        QStringList fields;
+        do {
+            if (!readCsvFields(fields)) {
+                return false;
+            }
+        } while (fields.size() == 1 && fields.first().trimmed().isEmpty()); // puste wiersze
+
+        ++m_recordNumber;
+        for (int i = 0; i < fields.size() && i < m_header.size(); i++) {
+            record.insert(m_header.at(i), fields.at(i));
+        }
+        return true;
+    }
+
+    QByteArray line;
+    do {
+        if (m_file->atEnd()) {
+            return false;
+        }
+        line = m_file->readLine().trimmed();
+    } while (line.isEmpty());
+
+    ++m_recordNumber;
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(line, &error);
+    if (error.error != QJsonParseError::NoError || !document.isObject()) {
+        m_error = "Niepoprawny JSON: " + error.errorString();
+        return true;
+    }
+
+    const QJsonObject object = document.object();
+    for (auto it = object.begin(); it != object.end(); ++it) {
+        const QJsonValue value = it.value();
+        record.insert(it.key().toLower(), value.isBool() ? (value.toBool() ? "true" : "false")
+                                                         : value.toVariant().toString());
+    }
+    return true;
+}
+
+} // namespace cli
@@ -0,0 +1,49 @@
+#ifndef CLI_RECORD_READER_H
+#define CLI_RECORD_READER_H
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <memory>
+
+namespace cli {
+
+// Jeden wiersz wejścia: nazwa kolumny/klucza -> wartość
+using Record = QHash<QString, QString>;
+
+// Strumieniowy odczyt rekordów z CSV (pierwszy wiersz = nagłówek, RFC 4180)
+// lub JSONL (jeden obiekt JSON na wiersz). W pamięci jest tylko bieżący wiersz.
+class RecordReader
+{
+public:
+    enum class Format {
+        Csv,
+        JsonLines
+    };
+
+    // Ścieżka "-" oznacza standardowe wejście
+    bool open(const QString& path, Format format);
+    QString errorString() const { return m_error; }
+
+    // Zwraca false na końcu danych; błędny wiersz zgłasza przez errorString()
+    // i zwraca pusty rekord, aby wywołujący mógł go pominąć
+    bool next(Record& record);
+
+    // Numer ostatnio odczytanego rekordu (od 1, bez nagłówka CSV)
+    qint64 recordNumber() const { return m_recordNumber; }
+
+private:
+    bool readCsvFields(QStringList& fields);
+
+    std::unique_ptr<QFile> m_file;
+    Format m_format = Format::Csv;
+    QStringList m_header;
+    QString m_error;
+    qint64 m_recordNumber = 0;
+};
+
+} // namespace cli
+
+#endif // CLI_RECORD_READER_H
@@ -0,0 +1,129 @@
+#include "cli_commands.h"
+#include "cli_support.h"
+
+#include "qrcore/binarizer.h"
+#include "qrcore/decoder_backend.h"
+#include "qrcore/thread_pool.h"
+#include "qrcore/video_decoder.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <opencv2/core.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace cli {
+
+namespace {
+
+// Jeden wiersz JSONL z wystąpieniem kodu w nagraniu
+QByteArray recordLine(const qrcore::VideoCodeRecord& record)
+{
+    QJsonArray polygon;
+    for (const cv::Point2f& point : record.polygon) {
+        polygon.append(QJsonArray{qRound(point.x * 10) / 10.0, qRound(point.y * 10) / 10.0});
+    }
+
+    QJsonObject line;
+    line["timestamp"] = qRound(record.timestamp * 1000) / 1000.0;
+    line["last_seen"] = qRound(record.lastSeen * 1000) / 1000.0;
+    line["frame"] = static_cast<qint64>(record.frame);
+    line["frames"] = record.frames;
+    line["text"] = QString::fromUtf8(record.payload.data(), static_cast<int>(record.payload.size()));
+    line["polygon"] = polygon;
+    return QJsonDocument(line).toJson(QJsonDocument::Compact) + '\n';
+}
+
+} // namespace
+
+int runScanVideo(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Odczyt kodów QR z pliku wideo. Wystąpienia kodów (JSONL) trafiają na standardowe wyjście.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("scan-video", "Nazwa polecenia.");
+    parser.addPositionalArgument("nagranie", "Plik wideo (dowolny format obsługiwany przez OpenCV/FFmpeg).");
+
+    QCommandLineOption jobsOption({"j", "jobs"}, "Liczba segmentów dekodowanych równolegle (domyślnie: liczba rdzeni).", "N");
+    QCommandLineOption stepOption("step", "Dekodowanie co N-tej klatki (domyślnie 1 - każdej).", "N", "1");
+    QCommandLineOption gapOption("gap", "Sekundy bez kodu, po których ta sama treść jest nowym wystąpieniem (domyślnie 1).", "S", "1");
+    QCommandLineOption segmentOption("segment", "Minimalna długość segmentu w sekundach (domyślnie 10).", "S", "10");
+    QCommandLineOption decodersOption("decoders",
+        QString("Kaskada backendów dekodowania, od najtańszego (dostępne: %1).")
+            .arg(QString::fromStdString(joinNames(qrcore::availableDecoderBackends()))), "LISTA");
+    QCommandLineOption binarizeOption("binarize",
+        "Progowanie lokalne: off, bradley, sauvola (drugie podejście po porażce backendów) "
+        "lub z dopiskiem :always - przed każdym dekodowaniem (domyślnie sauvola).", "STRATEGIA");
+    parser.addOption(jobsOption);
+    parser.addOption(stepOption);
+    parser.addOption(gapOption);
+    parser.addOption(segmentOption);
+    parser.addOption(decodersOption);
+    parser.addOption(binarizeOption);
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 2) {
+        parser.showHelp(1);
+    }
+
+    if (parser.isSet(decodersOption)) {
+        const std::vector<std::string> backends =
+            qrcore::parseDecoderBackends(parser.value(decodersOption).toStdString());
+        if (backends.empty() || !qrcore::setDecoderCascade(backends)) {
+            std::fprintf(stderr, "Nieznany backend dekodowania: %s\n", qPrintable(parser.value(decodersOption)));
+            return 1;
+        }
+    }
+
+    if (parser.isSet(binarizeOption)) {
+        qrcore::BinarizeOptions binarize;
+        if (!qrcore::parseBinarization(parser.value(binarizeOption).toStdString(), binarize)) {
+            std::fprintf(stderr, "Nieznana strategia progowania: %s\n", qPrintable(parser.value(binarizeOption)));
+            return 1;
+        }
+        qrcore::setDefaultBinarization(binarize);
+    }
+
+    qrcore::VideoDecodeOptions options;
+    options.threads = parser.isSet(jobsOption) ? parser.value(jobsOption).toInt() : qrcore::defaultThreadCount();
+    options.frameStep = std::max(1, parser.value(stepOption).toInt());
+    options.mergeGap = std::max(0.0, parser.value(gapOption).toDouble());
+    options.segmentSeconds = std::max(1.0, parser.value(segmentOption).toDouble());
+
+    // Równoległość zapewniają segmenty - wewnętrzne wątki OpenCV tylko by ze sobą konkurowały
+    cv::setNumThreads(1);
+
+    const std::string path = positional.at(1).toStdString();
+    qrcore::VideoDecodeStats stats;
+    const std::vector<qrcore::VideoCodeRecord> records = qrcore::decodeVideoFile(path, options, &stats);
+    if (stats.frames == 0) {
+        std::fprintf(stderr, "Nie można odczytać nagrania: %s\n", path.c_str());
+        return 1;
+    }
+
+    for (const qrcore::VideoCodeRecord& record : records) {
+        const QByteArray line = recordLine(record);
+        std::fwrite(line.constData(), 1, static_cast<size_t>(line.size()), stdout);
+    }
+    std::fflush(stdout);
+
+    std::fprintf(stderr,
+                 "Przetworzono %lld klatek (%.1f s nagrania, dekodowanych %lld) w %.2f s - %.1fx czasu rzeczywistego, "
+                 "%d segmentów, %zu wystąpień kodów\n",
+                 static_cast<long long>(stats.frames), stats.duration, static_cast<long long>(stats.decodedFrames),
+                 stats.seconds, stats.seconds > 0 ? stats.duration / stats.seconds : 0.0, stats.segments,
+                 records.size());
+    return 0;
+}
+
+} // namespace cli
@@ -0,0 +1,165 @@
+#include "cli_commands.h"
+#include "cli_support.h"
+#include "output_sink.h"
+
+#include "qrcore/bitmap_writer.h"
+#include "qrcore/qr_rasterizer.h"
+#include "qrcore/serial_encoder.h"
+#include "qrcore/thread_pool.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+
+#include <atomic>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+namespace cli {
+
+int runSerial(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Seria etykiet PREFIKS + licznik kodowana przyrostowo.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("serial", "Nazwa polecenia.");
+
+    QCommandLineOption prefixOption("prefix", "Stała część treści, np. PREFIX-.", "tekst");
+    QCommandLineOption startOption("start", "Pierwszy numer (domyślnie 1).", "N", "1");
+    QCommandLineOption countOption("count", "Liczba etykiet (domyślnie 1000).", "N", "1000");
+    QCommandLineOption digitsOption("digits", "Liczba cyfr licznika, dopełniana zerami (domyślnie 6).", "N", "6");
+    QCommandLineOption outputOption({"o", "output"},
+        "Katalog wyjściowy lub archiwum *.zip / *.tar (\"-\" = TAR na standardowe wyjście; domyślnie: qr_serial).",
+        "ścieżka", "qr_serial");
+    QCommandLineOption compressOption("compress", "Kompresja deflate wpisów archiwum ZIP.");
+    QCommandLineOption scaleOption("scale", "Piksele na moduł (domyślnie 8).", "N", "8");
+    QCommandLineOption borderOption("border", "Strefa ciszy w modułach (domyślnie 4).", "N", "4");
+    QCommandLineOption imageFormatOption("image-format", "Format rastrów 1-bitowych: png lub tiff (domyślnie png).",
+        "format", "png");
+    QCommandLineOption dpiOption("dpi", "Rozdzielczość zapisana w metadanych PNG/TIFF.", "DPI");
+    QCommandLineOption ecOption("ec", "Poziom korekcji błędów: L, M, Q, H (domyślnie M).", "poziom", "M");
+    QCommandLineOption jobsOption({"j", "jobs"}, "Liczba wątków zapisu (domyślnie: liczba rdzeni).", "N");
+    parser.addOptions({prefixOption, startOption, countOption, digitsOption, outputOption, compressOption,
+                       scaleOption, borderOption, imageFormatOption, dpiOption, ecOption, jobsOption});
+    parser.process(app);
+
+    qrcore::EncodeOptions encodeOptions;
+    if (!parseErrorCorrection(parser.value(ecOption), encodeOptions.ecLevel)) {
+        std::fprintf(stderr, "Nieznany poziom korekcji błędów: %s\n", qPrintable(parser.value(ecOption)));
+        return 1;
+    }
+
+    qrcore::BitmapFormat imageFormat = qrcore::BitmapFormat::Png;
+    const QString imageExtension = parser.value(imageFormatOption).trimmed().toLower();
+    if (!qrcore::bitmapFormatForPath(("." + imageExtension).toStdString(), imageFormat)) {
+        std::fprintf(stderr, "Nieobsługiwany format rastra: %s\n", qPrintable(imageExtension));
+        return 1;
+    }
+
+    const qint64 first = parser.value(startOption).toLongLong();
+    const qint64 count = parser.value(countOption).toLongLong();
+    const int digits = parser.value(digitsOption).toInt();
+    qrcore::SerialEncoder encoder(parser.value(prefixOption).toUtf8().toStdString(), digits, encodeOptions);
+    if (first < 0 || count < 1 || encoder.isNull()) {
+        std::fprintf(stderr, "Niepoprawne parametry serii (prefiks za długi lub licznik poza 1-19 cyfr?)\n");
+        return 1;
+    }
+
+    qrcore::RasterOptions rasterOptions;
+    rasterOptions.scale = qMax(1, parser.value(scaleOption).toInt());
+    rasterOptions.border = qMax(0, parser.value(borderOption).toInt());
+    const int size = qrcore::rasterSize(encoder.matrix(), rasterOptions);
+    const size_t bytesPerLine = qrcore::rasterBytesPerLine(size, qrcore::PixelFormat::Mono);
+    std::vector<uint8_t> raster(bytesPerLine * size);
+    qrcore::rasterize(encoder.matrix(), rasterOptions, qrcore::PixelFormat::Mono, raster.data(), bytesPerLine);
+
+    qrcore::BitmapOptions bitmapOptions;
+    bitmapOptions.dpi = parser.isSet(dpiOption) ? parser.value(dpiOption).toDouble() : 0.0;
+    bitmapOptions.parallel = false;
+
+    QString sinkError;
+    std::unique_ptr<OutputSink> sink = createOutputSink(parser.value(outputOption), parser.isSet(compressOption), &sinkError);
+    if (!sink) {
+        std::fprintf(stderr, "%s\n", qPrintable(sinkError));
+        return 1;
+    }
+
+    const int jobs = parser.isSet(jobsOption) ? parser.value(jobsOption).toInt() : qrcore::defaultThreadCount();
+    qrcore::ThreadPool pool(jobs);
+    InFlightLimiter limiter(static_cast<size_t>(pool.threadCount()) * 8);
+
+    std::atomic<qint64> written{0};
+    std::atomic<qint64> failed{0};
+    double encodeMs = 0.0;
+    qint64 changedModules = 0;
+    const Clock::time_point start = Clock::now();
+
+    // Kodowanie i przerysowanie rastra są sekwencyjne (każda etykieta zmienia
+    // poprzednią), kompresja PNG/TIFF gotowych kopii rastra trafia do puli
+    std::vector<qrcore::ModulePosition> changed;
+    for (qint64 i = 0; i < count; i++) {
+        const uint64_t number = static_cast<uint64_t>(first + i);
+        changed.clear();
+        const Clock::time_point encodeStart = Clock::now();
+        const bool encoded = encoder.encode(number, &changed);
+        if (encoded) {
+            qrcore::rasterizeModules(encoder.matrix(), changed, rasterOptions, qrcore::PixelFormat::Mono,
+                                     raster.data(), bytesPerLine);
+        }
+        encodeMs += millisecondsSince(encodeStart);
+        if (!encoded) {
+            std::fprintf(stderr, "Numer %llu nie mieści się w %d cyfrach\n",
+                         static_cast<unsigned long long>(number), digits);
+            ++failed;
+            break;
+        }
+        changedModules += static_cast<qint64>(changed.size());
+
+        limiter.acquire();
+        const QString name = QString("%1.%2").arg(static_cast<qulonglong>(number), digits, 10, QChar('0')).arg(imageExtension);
+        pool.submit([&, name, snapshot = raster]() {
+            std::ostringstream stream;
+            if (!qrcore::writeBitmap(snapshot.data(), size, bytesPerLine, imageFormat, stream, bitmapOptions) ||
+                !sink->write(name, QByteArray::fromStdString(stream.str()))) {
+                std::fprintf(stderr, "Nie można zapisać %s\n", qPrintable(name));
+                ++failed;
+            } else {
+                ++written;
+            }
+            limiter.release();
+        });
+    }
+
+    pool.wait();
+    const bool finished = sink->finish();
+    if (!finished) {
+        std::fprintf(stderr, "Błąd zamykania wyjścia: %s\n", qPrintable(sink->errorString()));
+    }
+
+    const double seconds = millisecondsSince(start) / 1000.0;
+
+    // Dla porównania: pełne kodowanie i rasteryzacja kilku etykiet serii
+    const int samples = static_cast<int>(qMin<qint64>(count, 100));
+    const Clock::time_point fullStart = Clock::now();
+    for (int i = 0; i < samples; i++) {
+        const qrcore::QRMatrix matrix = qrcore::encode(encoder.text(static_cast<uint64_t>(first + i)), encodeOptions);
+        const int fullSize = qrcore::rasterSize(matrix, rasterOptions);
+        std::vector<uint8_t> full(qrcore::rasterBytesPerLine(fullSize, qrcore::PixelFormat::Mono) * fullSize);
+        qrcore::rasterize(matrix, rasterOptions, qrcore::PixelFormat::Mono, full.data(),
+                          qrcore::rasterBytesPerLine(fullSize, qrcore::PixelFormat::Mono));
+    }
+    const double fullMs = millisecondsSince(fullStart);
+
+    std::fprintf(stderr, "Zapisano %lld etykiet (%lld błędów) w %.2f s, wersja %d, maska %d\n",
+                 static_cast<long long>(written.load()), static_cast<long long>(failed.load()), seconds,
+                 encoder.matrix().version(), encoder.mask());
+    std::fprintf(stderr, "Kodowanie przyrostowe: %.2f us/etykietę (średnio %.1f zmienionych modułów), "
+                         "pełne kodowanie: %.2f us/etykietę\n",
+                 encodeMs * 1000.0 / count, static_cast<double>(changedModules) / count,
+                 samples > 0 ? fullMs * 1000.0 / samples : 0.0);
+    return (failed.load() == 0 && finished) ? 0 : 2;
+}
+
+} // namespace cli
@@ -0,0 +1,142 @@
+#include "cli_commands.h"
+#include "cli_support.h"
+
+#include "qrcore/qr_encoder.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace cli {
+
+namespace {
+
+const char kAlphanumeric[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+
+// Losowy zestaw segmentów we wszystkich trybach (łącznie do maxLength znaków)
+std::vector<qrcore::Segment> randomSegments(std::mt19937& random, int maxLength)
+{
+    std::vector<qrcore::Segment> segments;
+    int remaining = 1 + static_cast<int>(random() % static_cast<unsigned>(maxLength));
+    while (remaining > 0) {
+        qrcore::Segment segment;
+        segment.mode = static_cast<qrcore::SegmentMode>(random() % 4);
+        const int length = 1 + static_cast<int>(random() % static_cast<unsigned>(remaining));
+        for (int i = 0; i < length; i++) {
+            switch (segment.mode) {
+                case qrcore::SegmentMode::Numeric:
+                    segment.data += static_cast<char>('0' + random() % 10);
+                    break;
+                case qrcore::SegmentMode::Alphanumeric:
+                    segment.data += kAlphanumeric[random() % 45];
+                    break;
+                case qrcore::SegmentMode::Byte:
+                    segment.data += static_cast<char>(random() % 256);
+                    break;
+                case qrcore::SegmentMode::Kanji: {
+                    // Kod z pierwszego zakresu Shift JIS (0x8140-0x9FFC)
+                    const unsigned code = 0x8140 + random() % (0x9FFC - 0x8140 + 1);
+                    segment.data += static_cast<char>(code >> 8);
+                    segment.data += static_cast<char>(code & 0xFF);
+                    break;
+                }
+                case qrcore::SegmentMode::StructuredAppend:
+                    break;
+            }
+        }
+        segments.push_back(segment);
+        remaining -= length;
+    }
+
+    // Co czwarty zestaw jako część symbolu Structured Append
+    if (random() % 4 == 0) {
+        const int total = 1 + static_cast<int>(random() % 16);
+        const int number = 1 + static_cast<int>(random() % static_cast<unsigned>(total));
+        const char header[] = {static_cast<char>(total), static_cast<char>(number), static_cast<char>(random() % 256)};
+        segments.insert(segments.begin(), qrcore::Segment{qrcore::SegmentMode::StructuredAppend, std::string(header, 3)});
+    }
+    return segments;
+}
+
+} // namespace
+
+int runVerifyEncoder(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Porównanie wbudowanego kodera z libqrencode (zgodność modułów i czas).");
+    parser.addHelpOption();
+    parser.addPositionalArgument("verify-encoder", "Nazwa polecenia.");
+
+    QCommandLineOption countOption("count", "Liczba losowych symboli (domyślnie 2000).", "N", "2000");
+    QCommandLineOption lengthOption("max-length", "Maksymalna długość danych w znakach (domyślnie 300).", "N", "300");
+    QCommandLineOption seedOption("seed", "Ziarno generatora losowego (domyślnie 1).", "N", "1");
+    QCommandLineOption parallelOption("parallel-masks", "Ocena masek równolegle w koderze wbudowanym.");
+    parser.addOptions({countOption, lengthOption, seedOption, parallelOption});
+    parser.process(app);
+
+    const int count = qMax(1, parser.value(countOption).toInt());
+    const int maxLength = qMax(1, parser.value(lengthOption).toInt());
+    std::mt19937 random(parser.value(seedOption).toUInt());
+
+    // Identyczne segmenty dla obu koderów - różnice mogą wynikać wyłącznie
+    // z wersji, słów kodowych, rozmieszczenia lub wyboru maski
+    std::vector<std::vector<qrcore::Segment>> inputs;
+    std::vector<qrcore::EncodeOptions> options;
+    for (int i = 0; i < count; i++) {
+        inputs.push_back(randomSegments(random, maxLength));
+        qrcore::EncodeOptions option;
+        option.ecLevel = static_cast<qrcore::ErrorCorrection>(i % 4);
+        option.parallelMasks = parser.isSet(parallelOption);
+        options.push_back(option);
+    }
+
+    auto encodeAll = [&](qrcore::EncoderBackend backend, std::vector<qrcore::QRMatrix>& results) {
+        results.clear();
+        results.reserve(inputs.size());
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < inputs.size(); i++) {
+            qrcore::EncodeOptions option = options[i];
+            option.backend = backend;
+            results.push_back(qrcore::encodeSegments(inputs[i], option));
+        }
+        return millisecondsSince(start);
+    };
+
+    std::vector<qrcore::QRMatrix> reference;
+    std::vector<qrcore::QRMatrix> native;
+    const double referenceMs = encodeAll(qrcore::EncoderBackend::LibQrencode, reference);
+    const double nativeMs = encodeAll(qrcore::EncoderBackend::Native, native);
+
+    int mismatches = 0;
+    int tooLong = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (reference[i].isNull() && native[i].isNull()) {
+            ++tooLong;
+            continue;
+        }
+        if (reference[i] == native[i]) {
+            continue;
+        }
+
+        if (++mismatches <= 10) {
+            std::fprintf(stderr, "Różnica #%zu: %zu segmentów, poziom %d, wersja %d / %d\n",
+                         i, inputs[i].size(), static_cast<int>(options[i].ecLevel),
+                         reference[i].version(), native[i].version());
+        }
+    }
+
+    const int compared = count - tooLong;
+    std::printf("Symbole: %d (pominięte za długie: %d), zgodne: %d, różne: %d\n",
+                compared, tooLong, compared - mismatches, mismatches);
+    std::printf("libqrencode: %.1f us/symbol, wbudowany: %.1f us/symbol (x%.2f)\n",
+                referenceMs * 1000.0 / count, nativeMs * 1000.0 / count,
+                nativeMs > 0 ? referenceMs / nativeMs : 0.0);
+    return mismatches == 0 ? 0 : 2;
+}
+
+} // namespace cli
@@ -0,0 +1,449 @@
+#include "qrcore/archive_writer.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace qrcore {
+
+namespace {
+
+// Stała data modyfikacji (1980-01-01 00:00 w formacie MS-DOS) - wynik deterministyczny
+constexpr uint16_t kDosTime = 0;
+constexpr uint16_t kDosDate = (0 << 9) | (1 << 5) | 1;
+
+constexpr uint16_t kFlagUtf8 = 0x0800;
+constexpr uint16_t kMethodStore = 0;
+constexpr uint16_t kMethodDeflate = 8;
+constexpr uint16_t kVersionDefault = 20;
+constexpr uint16_t kVersionZip64 = 45;
+constexpr uint16_t kVersionMadeBy = (3 << 8) | 45; // UNIX, specyfikacja 4.5
+
+constexpr uint32_t kMax32 = 0xFFFFFFFFu;
+constexpr uint16_t kMax16 = 0xFFFFu;
+
+const char* const kManifestName = "manifest.jsonl";
+const char* const kRenamedManifestName = "_manifest.jsonl"; // wpis użytkownika o nazwie indeksu
+
+// Bufor rekordów w little-endian
+class ByteWriter
+{
+public:
+    void u16(uint16_t value)
+    {
+        m_bytes.push_back(static_cast<uint8_t>(value));
+        m_bytes.push_back(static_cast<uint8_t>(value >> 8));
+    }
+    void u32(uint32_t value)
+    {
+        u16(static_cast<uint16_t>(value));
+        u16(static_cast<uint16_t>(value >> 16));
+    }
+    void u64(uint64_t value)
+    {
+        u32(static_cast<uint32_t>(value));
+        u32(static_cast<uint32_t>(value >> 32));
+    }
+    void bytes(const std::string& text) { m_bytes.insert(m_bytes.end(), text.begin(), text.end()); }
+
+    const std::vector<uint8_t>& data() const { return m_bytes; }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+bool deflateRaw(const uint8_t* data, size_t size, std::vector<uint8_t>& output)
+{
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    // Ujemny windowBits = surowy deflate (bez nagłówka zlib), jak wymaga ZIP
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    output.resize(deflateBound(&stream, static_cast<uLong>(size)));
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = output.data();
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    const int status = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    return status == Z_STREAM_END;
+}
+
+// Pole liczbowe nagłówka TAR: ósemkowo, dopełnione zerami, zakończone NUL
+void tarOctal(char* field, size_t width, uint64_t value)
+{
+    std::memset(field, '0', width - 1);
+    field[width - 1] = '\0';
+    for (size_t i = width - 1; i-- > 0 && value > 0; value >>= 3) {
+        field[i] = static_cast<char>('0' + (value & 7));
+    }
+}
+
+std::string jsonString(const std::string& text)
+{
+    std::string escaped = "\"";
+    for (unsigned char c : text) {
+        switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    escaped += buffer;
+                } else {
+                    escaped += static_cast<char>(c);
+                }
+        }
+    }
+    return escaped + "\"";
+}
+
+} // namespace
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc)
+{
+    uLong value = crc;
+    while (size > 0) {
+        const uInt chunk = static_cast<uInt>(std::min<size_t>(size, 1u << 30));
+        value = ::crc32(value, data, chunk);
+        data += chunk;
+        size -= chunk;
+    }
+    return static_cast<uint32_t>(value);
+}
+
+ArchiveWriter::ArchiveWriter(Format format)
+    : m_format(format)
+{
+}
+
+ArchiveWriter::~ArchiveWriter()
+{
+    if (m_file && !m_finished) {
+        finish();
+    }
+}
+
+bool ArchiveWriter::formatForPath(const std::string& path, Format& format)
+{
+    auto endsWith = [&](const char* suffix) {
+        const size_t length = std::strlen(suffix);
+        if (path.size() < length) {
+            return false;
+        }
+        std::string tail = path.substr(path.size() - length);
+        std::transform(tail.begin(), tail.end(), tail.begin(), ::tolower);
+        return tail == suffix;
+    };
+
+    if (endsWith(".zip")) {
+        format = Format::Zip;
+        return true;
+    }
+    if (endsWith(".tar")) {
+        format = Format::Tar;
+        return true;
+    }
+    return false;
+}
+
+bool ArchiveWriter::open(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (path == "-") {
+        m_file = stdout;
+        m_ownsFile = false;
+    } else {
+        m_file = std::fopen(path.c_str(), "wb");
+        m_ownsFile = true;
+    }
+
+    if (!m_file) {
+        m_error = "Nie można utworzyć archiwum: " + path;
+        return false;
+    }
+
+    // Duży bufor - wpisy są małe, a zapis sekwencyjny
+    std::setvbuf(m_file, nullptr, _IOFBF, 1 << 20);
+    return true;
+}
+
+ArchiveWriter::PreparedEntry ArchiveWriter::prepare(const std::string& name, const uint8_t* data, size_t size,
+                                                    Compression compression, Format format)
+{
+    PreparedEntry entry;
+    entry.name = name;
+    entry.uncompressedSize = size;
+    entry.crc32 = crc32(data, size);
+
+    if (compression == Compression::Deflate && format == Format::Zip && size > 0) {
+        std::vector<uint8_t> compressed;
+        if (deflateRaw(data, size, compressed) && compressed.size() < size) {
+            entry.data = std::move(compressed);
+            entry.deflated = true;
+            return entry;
+        }
+    }
+
+    entry.data.assign(data, data + size);
+    return entry;
+}
+
+bool ArchiveWriter::writeBytes(const void* data, size_t size)
+{
+    if (size > 0 && std::fwrite(data, 1, size, m_file) != size) {
+        m_error = "Błąd zapisu archiwum";
+        return false;
+    }
+    m_offset += size;
+    return true;
+}
+
+bool ArchiveWriter::writeZipLocalHeader(const PreparedEntry& entry)
+{
+    // Rozmiary i CRC są znane z góry - bez deskryptora danych
+    ByteWriter header;
+    header.u32(0x04034b50);
+    header.u16(kVersionDefault);
+    header.u16(kFlagUtf8);
+    header.u16(entry.deflated ? kMethodDeflate : kMethodStore);
+    header.u16(kDosTime);
+    header.u16(kDosDate);
+    header.u32(entry.crc32);
+    header.u32(static_cast<uint32_t>(entry.data.size()));
+    header.u32(static_cast<uint32_t>(entry.uncompressedSize));
+    header.u16(static_cast<uint16_t>(entry.name.size()));
+    header.u16(0);
+    header.bytes(entry.name);
+    return writeBytes(header.data().data(), header.data().size());
+}
+
+bool ArchiveWriter::writeTarHeader(const std::string& name, uint64_t size)
+{
+    // Nagłówek ustar; dłuższe nazwy dzielone na prefiks (155) i nazwę (100)
+    char header[512];
+    std::memset(header, 0, sizeof(header));
+
+    std::string prefix;
+    std::string shortName = name;
+    if (name.size() > 100) {
+        const size_t split = name.rfind('/', 155);
+        if (split == std::string::npos || name.size() - split - 1 > 100 || split == 0) {
+            m_error = "Zbyt długa nazwa wpisu TAR: " + name;
+            return false;
+        }
+        prefix = name.substr(0, split);
+        shortName = name.substr(split + 1);
+    }
+
+    std::memcpy(header, shortName.data(), shortName.size());
+    tarOctal(header + 100, 8, 0644);      // mode
+    tarOctal(header + 108, 8, 0);         // uid
+    tarOctal(header + 116, 8, 0);         // gid
+    tarOctal(header + 124, 12, size);     // size
+    tarOctal(header + 136, 12, 0);        // mtime (stały)
+    header[156] = '0';                    // zwykły plik
+    std::memcpy(header + 257, "ustar", 6);
+    std::memcpy(header + 263, "00", 2);
+    std::memcpy(header + 345, prefix.data(), prefix.size());
+
+    // Suma kontrolna liczona ze spacjami w polu sumy
+    std::memset(header + 148, ' ', 8);
+    unsigned checksum = 0;
+    for (unsigned char c : header) {
+        checksum += c;
+    }
+    tarOctal(header + 148, 7, checksum);
+    header[155] = ' ';
+
+    return writeBytes(header, sizeof(header));
+}
+
+bool ArchiveWriter::addLocked(const PreparedEntry& entry)
+{
+    if (!m_file || m_finished) {
+        m_error = "Archiwum nie jest otwarte";
+        return false;
+    }
+
+    CentralRecord record;
+    record.name = entry.name;
+    record.offset = m_offset;
+    record.compressedSize = entry.data.size();
+    record.uncompressedSize = entry.uncompressedSize;
+    record.crc32 = entry.crc32;
+    record.deflated = entry.deflated;
+
+    if (m_format == Format::Zip) {
+        if (entry.data.size() >= kMax32 || entry.name.size() > kMax16) {
+            m_error = "Wpis zbyt duży dla ZIP: " + entry.name;
+            return false;
+        }
+        if (!writeZipLocalHeader(entry) || !writeBytes(entry.data.data(), entry.data.size())) {
+            return false;
+        }
+    } else {
+        static const char padding[512] = {};
+        const size_t tail = (512 - entry.data.size() % 512) % 512;
+        if (!writeTarHeader(entry.name, entry.data.size()) ||
+            !writeBytes(entry.data.data(), entry.data.size()) ||
+            !writeBytes(padding, tail)) {
+            return false;
+        }
+    }
+
+    m_records.push_back(std::move(record));
+    return true;
+}
+
+bool ArchiveWriter::add(PreparedEntry entry)
+{
+    // Nazwa indeksu jest zarezerwowana - inaczej archiwum miałoby dwa wpisy
+    // manifest.jsonl, a rozpakowanie nadpisałoby jeden z nich
+    if (entry.name == kManifestName) {
+        entry.name = kRenamedManifestName;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return addLocked(entry);
+}
+
+bool ArchiveWriter::writeZipCentralDirectory()
+{
+    const uint64_t directoryOffset = m_offset;
+
+    for (const CentralRecord& record : m_records) {
+        // Przesunięcia powyżej 4 GiB trafiają do pola dodatkowego ZIP64
+        const bool zip64Offset = record.offset >= kMax32;
+
+        ByteWriter header;
+        header.u32(0x02014b50);
+        header.u16(kVersionMadeBy);
+        header.u16(zip64Offset ? kVersionZip64 : kVersionDefault);
+        header.u16(kFlagUtf8);
+        header.u16(record.deflated ? kMethodDeflate : kMethodStore);
+        header.u16(kDosTime);
+        header.u16(kDosDate);
+        header.u32(record.crc32);
+        header.u32(static_cast<uint32_t>(record.compressedSize));
+        header.u32(static_cast<uint32_t>(record.uncompressedSize));
+        header.u16(static_cast<uint16_t>(record.name.size()));
+        header.u16(zip64Offset ? 12 : 0);   // długość pola dodatkowego
+        header.u16(0);                      // komentarz
+        header.u16(0);                      // numer dysku
+        header.u16(0);                      // atrybuty wewnętrzne
+        header.u32(0100644u << 16);         // zwykły plik, rw-r--r--
+        header.u32(zip64Offset ? kMax32 : static_cast<uint32_t>(record.offset));
+        header.bytes(record.name);
+        if (zip64Offset) {
+            header.u16(0x0001);
+            header.u16(8);
+            header.u64(record.offset);
+        }
+
+        if (!writeBytes(header.data().data(), header.data().size())) {
+            return false;
+        }
+    }
+
+    const uint64_t directorySize = m_offset - directoryOffset;
+    const uint64_t count = m_records.size();
+    const bool zip64 = count >= kMax16 || directoryOffset >= kMax32 || directorySize >= kMax32;
+
+    ByteWriter end;
+    if (zip64) {
+        const uint64_t zip64EndOffset = m_offset;
+        end.u32(0x06064b50);
+        end.u64(44);                // rozmiar rekordu bez pierwszych 12 bajtów
+        end.u16(kVersionMadeBy);
+        end.u16(kVersionZip64);
+        end.u32(0);
+        end.u32(0);
+        end.u64(count);
+        end.u64(count);
+        end.u64(directorySize);
+        end.u64(directoryOffset);
+
+        end.u32(0x07064b50);        // lokalizator ZIP64
+        end.u32(0);
+        end.u64(zip64EndOffset);
+        end.u32(1);
+    }
+
+    end.u32(0x06054b50);
+    end.u16(0);
+    end.u16(0);
+    end.u16(zip64 ? kMax16 : static_cast<uint16_t>(count));
+    end.u16(zip64 ? kMax16 : static_cast<uint16_t>(count));
+    end.u32(zip64 ? kMax32 : static_cast<uint32_t>(directorySize));
+    end.u32(zip64 ? kMax32 : static_cast<uint32_t>(directoryOffset));
+    end.u16(0);
+
+    return writeBytes(end.data().data(), end.data().size());
+}
+
+bool ArchiveWriter::finish()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file) {
+        return m_finished; // już zamknięte (true) lub nigdy nie otwarte (false)
+    }
+
+    // Indeks wszystkich wpisów jako ostatni plik archiwum
+    std::string manifest;
+    for (const CentralRecord& record : m_records) {
+        char numbers[128];
+        std::snprintf(numbers, sizeof(numbers), ",\"size\":%llu,\"stored\":%llu,\"crc32\":\"%08x\",\"offset\":%llu}\n",
+                      static_cast<unsigned long long>(record.uncompressedSize),
+                      static_cast<unsigned long long>(record.compressedSize),
+                      record.crc32,
+                      static_cast<unsigned long long>(record.offset));
+        manifest += "{\"name\":" + jsonString(record.name) + numbers;
+    }
+
+    bool ok = addLocked(prepare(kManifestName, reinterpret_cast<const uint8_t*>(manifest.data()),
+                                manifest.size(), Compression::Deflate, m_format));
+
+    if (ok) {
+        if (m_format == Format::Zip) {
+            ok = writeZipCentralDirectory();
+        } else {
+            static const char zeros[1024] = {};
+            ok = writeBytes(zeros, sizeof(zeros)); // dwa puste bloki kończące TAR
+        }
+    }
+
+    if (std::fflush(m_file) != 0) {
+        ok = false;
+        m_error = "Błąd zapisu archiwum";
+    }
+    if (m_ownsFile) {
+        std::fclose(m_file);
+    }
+    m_file = nullptr;
+    m_finished = true;
+    return ok;
+}
+
+std::string ArchiveWriter::errorString() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_error;
+}
+
+uint64_t ArchiveWriter::entryCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_records.size();
+}
+
+} // namespace qrcore
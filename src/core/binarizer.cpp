@@ -0,0 +1,170 @@
+#include "qrcore/binarizer.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+
+namespace qrcore {
+
+namespace {
+
+constexpr double kSauvolaRange = 128.0; // dynamika odchylenia dla obrazów 8-bitowych
+
+int windowRadius(const cv::Mat& gray, int window)
+{
+    if (window <= 0) {
+        window = std::max(15, std::min(gray.cols, gray.rows) / 8);
+    }
+    return std::max(1, window / 2);
+}
+
+// Suma okna side x side o lewym górnym rogu w kolumnie x obrazu z marginesem
+template <typename Sum>
+inline double windowSum(const Sum* top, const Sum* bottom, int x, int side)
+{
+    return static_cast<double>(bottom[x + side] - bottom[x] - top[x + side] + top[x]);
+}
+
+// Wiersz progowania. Pętle nie mają rozgałęzień ani przycinania okna, więc
+// kompilator je wektoryzuje; Sauvola porównuje kwadraty zamiast liczyć
+// pierwiastek odchylenia:
+//   p <= m (1 + k (s / R - 1))  <=>  a <= b s,  a = p - m (1 - k), b = m k / R
+template <typename Sum>
+void thresholdRow(const uint8_t* pixels, const Sum* top, const Sum* bottom, const double* squareTop,
+                  const double* squareBottom, int width, int side, const BinarizeOptions& options, uint8_t* output)
+{
+    const double area = static_cast<double>(side) * side;
+    const double inverseArea = 1.0 / area;
+
+    if (options.method == BinarizeMethod::Sauvola) {
+        const double k = options.sauvolaK;
+        for (int x = 0; x < width; x++) {
+            const double mean = windowSum(top, bottom, x, side) * inverseArea;
+            const double squares = windowSum(squareTop, squareBottom, x, side) * inverseArea;
+            const double variance = squares - mean * mean;
+            const double a = pixels[x] - mean * (1.0 - k);
+            const double b = mean * k / kSauvolaRange;
+            output[x] = ((a <= 0.0) | (a * a <= b * b * variance)) ? 0 : 255;
+        }
+    } else {
+        const double bradley = 1.0 - options.bradleyT;
+        for (int x = 0; x < width; x++) {
+            output[x] = pixels[x] * area <= windowSum(top, bottom, x, side) * bradley ? 0 : 255;
+        }
+    }
+}
+
+std::mutex g_binarizeMutex;
+bool g_binarizeSet = false;
+BinarizeOptions g_binarize;
+
+} // namespace
+
+const cv::Mat& Binarizer::apply(const cv::Mat& gray)
+{
+    if (gray.empty() || gray.type() != CV_8UC1 || !m_options.enabled()) {
+        m_binary.release();
+        return m_binary;
+    }
+
+    // Margines powielający krawędzie: każde okno ma pełny rozmiar, więc pętla
+    // progowania czyta wiersze całkowe pod stałymi przesunięciami
+    // (cv::integral i cv::copyMakeBorder są wektoryzowane w OpenCV)
+    const int radius = windowRadius(gray, m_options.window);
+    const int side = 2 * radius + 1;
+    cv::copyMakeBorder(gray, m_padded, radius, radius, radius, radius, cv::BORDER_REPLICATE);
+
+    // Sumy 32-bitowe, dopóki suma całego obrazu mieści się w int (do ok. 8 Mpx)
+    const bool sauvola = m_options.method == BinarizeMethod::Sauvola;
+    const bool narrow = static_cast<double>(m_padded.rows) * m_padded.cols * 255.0 < 2147483647.0;
+    if (sauvola) {
+        cv::integral(m_padded, m_sum, m_squares, narrow ? CV_32S : CV_64F, CV_64F);
+    } else {
+        cv::integral(m_padded, m_sum, narrow ? CV_32S : CV_64F);
+    }
+    m_binary.create(gray.size(), CV_8UC1);
+
+    for (int y = 0; y < gray.rows; y++) {
+        const uint8_t* pixels = gray.ptr<uint8_t>(y);
+        const double* squareTop = sauvola ? m_squares.ptr<double>(y) : nullptr;
+        const double* squareBottom = sauvola ? m_squares.ptr<double>(y + side) : nullptr;
+        uint8_t* output = m_binary.ptr<uint8_t>(y);
+        if (narrow) {
+            thresholdRow(pixels, m_sum.ptr<int32_t>(y), m_sum.ptr<int32_t>(y + side), squareTop, squareBottom,
+                         gray.cols, side, m_options, output);
+        } else {
+            thresholdRow(pixels, m_sum.ptr<double>(y), m_sum.ptr<double>(y + side), squareTop, squareBottom,
+                         gray.cols, side, m_options, output);
+        }
+    }
+    return m_binary;
+}
+
+cv::Mat binarize(const cv::Mat& gray, const BinarizeOptions& options)
+{
+    Binarizer binarizer(options);
+    return binarizer.apply(gray).clone();
+}
+
+bool parseBinarization(const std::string& text, BinarizeOptions& options)
+{
+    BinarizeOptions parsed = options;
+    std::string method = text;
+    parsed.stage = BinarizeStage::Fallback;
+
+    const size_t colon = text.find(':');
+    if (colon != std::string::npos) {
+        method = text.substr(0, colon);
+        if (text.substr(colon + 1) != "always") {
+            return false;
+        }
+        parsed.stage = BinarizeStage::Always;
+    }
+
+    if (method == "off" || method == "none") {
+        parsed.method = BinarizeMethod::None;
+    } else if (method == "bradley") {
+        parsed.method = BinarizeMethod::Bradley;
+    } else if (method == "sauvola") {
+        parsed.method = BinarizeMethod::Sauvola;
+    } else {
+        return false;
+    }
+
+    options = parsed;
+    return true;
+}
+
+BinarizeOptions defaultBinarization()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_binarizeMutex);
+        if (g_binarizeSet) {
+            return g_binarize;
+        }
+    }
+
+    // Zmienna środowiskowa jest czytana raz - konfiguracja wdrożenia
+    static const BinarizeOptions defaults = [] {
+        BinarizeOptions options;
+        const char* environment = std::getenv("QRCORE_BINARIZE");
+        if (environment && !parseBinarization(environment, options)) {
+            qWarning() << "Nieznana strategia w QRCORE_BINARIZE:" << environment;
+        }
+        return options;
+    }();
+    return defaults;
+}
+
+void setDefaultBinarization(const BinarizeOptions& options)
+{
+    std::lock_guard<std::mutex> lock(g_binarizeMutex);
+    g_binarize = options;
+    g_binarizeSet = true;
+}
+
+} // namespace qrcore
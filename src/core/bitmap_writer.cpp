@@ -0,0 +1,558 @@
+#include "qrcore/bitmap_writer.h"
+
+#include "qrcore/qr_rasterizer.h"
+
+#include <opencv2/core.hpp>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace qrcore {
+
+namespace {
+
+// Rozmiar bloku IDAT
+constexpr size_t kChunkSize = 64 * 1024;
+
+// Liczba pasów przetwarzanych jednocześnie (jedna fala)
+constexpr size_t kStripsPerWave = 8;
+
+void putBigEndian32(uint8_t* out, uint32_t value)
+{
+    out[0] = uint8_t(value >> 24);
+    out[1] = uint8_t(value >> 16);
+    out[2] = uint8_t(value >> 8);
+    out[3] = uint8_t(value);
+}
+
+void writeBytes(std::ostream& output, const void* data, size_t size)
+{
+    output.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+// ---- PNG ----
+
+void writePngChunk(std::ostream& output, const char type[4], const uint8_t* data, size_t size)
+{
+    uint8_t header[8];
+    putBigEndian32(header, static_cast<uint32_t>(size));
+    std::memcpy(header + 4, type, 4);
+    writeBytes(output, header, sizeof(header));
+    if (size > 0) {
+        writeBytes(output, data, size);
+    }
+
+    uLong crc = ::crc32(0L, reinterpret_cast<const Bytef*>(type), 4);
+    if (size > 0) {
+        crc = ::crc32(crc, data, static_cast<uInt>(size));
+    }
+    uint8_t trailer[4];
+    putBigEndian32(trailer, static_cast<uint32_t>(crc));
+    writeBytes(output, trailer, sizeof(trailer));
+}
+
+// Źródło wierszy rastra Mono: (pierwszy wiersz, liczba wierszy, bufor, krok)
+using RowSource = std::function<void(int, int, uint8_t*, size_t)>;
+
+// Pas wierszy obrazu przetworzony niezależnie w wątku roboczym
+struct EncodedStrip {
+    int firstRow = 0;
+    int rowCount = 0;
+    std::vector<uint8_t> data;  // surowy deflate (PNG) lub dane T.6 (TIFF)
+    uLong adler = 1;            // adler32 przefiltrowanych wierszy (PNG)
+    size_t filteredSize = 0;
+    bool ok = true;
+};
+
+// Podział na pasy: wysokość wynika z budżetu pamięci, a nie z liczby wątków,
+// więc plik jest identyczny niezależnie od równoległości
+std::vector<EncodedStrip> planStrips(int size, size_t lineBytes, const BitmapOptions& options)
+{
+    const size_t perRow = 3 * (lineBytes + 1);  // raster + wiersze filtrowane + wynik
+    const size_t budget = std::max<size_t>(options.memoryBudget, perRow * kStripsPerWave);
+    const int rowsPerStrip = static_cast<int>(std::min<size_t>(size, budget / (perRow * kStripsPerWave)));
+
+    std::vector<EncodedStrip> strips((size + rowsPerStrip - 1) / rowsPerStrip);
+    for (size_t i = 0; i < strips.size(); i++) {
+        strips[i].firstRow = static_cast<int>(i) * rowsPerStrip;
+        strips[i].rowCount = std::min(rowsPerStrip, size - strips[i].firstRow);
+    }
+    return strips;
+}
+
+// Przetwarza pasy falami po kStripsPerWave (równolegle w obrębie fali)
+// i przekazuje je do zapisu w kolejności - w pamięci jest co najwyżej jedna fala
+template <typename Encode, typename Emit>
+bool processStrips(std::vector<EncodedStrip>& strips, bool parallel, Encode encode, Emit emit)
+{
+    for (size_t wave = 0; wave < strips.size(); wave += kStripsPerWave) {
+        const int count = static_cast<int>(std::min(kStripsPerWave, strips.size() - wave));
+        auto worker = [&](const cv::Range& range) {
+            for (int i = range.start; i < range.end; i++) {
+                encode(strips[wave + i], wave + i + 1 == strips.size());
+            }
+        };
+
+        if (parallel && count > 1) {
+            cv::parallel_for_(cv::Range(0, count), worker);
+        } else {
+            worker(cv::Range(0, count));
+        }
+
+        for (int i = 0; i < count; i++) {
+            EncodedStrip& strip = strips[wave + i];
+            if (!strip.ok || !emit(strip)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool writePng(const RowSource& source, int size, size_t lineBytes, const BitmapOptions& options, std::ostream& output)
+{
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    writeBytes(output, signature, sizeof(signature));
+
+    // IHDR: 1 bit, kolor indeksowany - indeks 1 (bit ustawiony) = moduł ciemny,
+    // więc raster Mono trafia do pliku bez odwracania bitów
+    uint8_t header[13];
+    putBigEndian32(header, static_cast<uint32_t>(size));
+    putBigEndian32(header + 4, static_cast<uint32_t>(size));
+    header[8] = 1;
+    header[9] = 3;
+    header[10] = header[11] = header[12] = 0;
+    writePngChunk(output, "IHDR", header, sizeof(header));
+
+    static const uint8_t palette[6] = {0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00};
+    writePngChunk(output, "PLTE", palette, sizeof(palette));
+
+    if (options.dpi > 0.0) {
+        uint8_t physical[9];
+        const uint32_t pixelsPerMeter = static_cast<uint32_t>(std::lround(options.dpi / 0.0254));
+        putBigEndian32(physical, pixelsPerMeter);
+        putBigEndian32(physical + 4, pixelsPerMeter);
+        physical[8] = 1;
+        writePngChunk(output, "pHYs", physical, sizeof(physical));
+    }
+
+    // Każdy pas to osobny surowy strumień deflate zakończony Z_FULL_FLUSH
+    // (ostatni - Z_FINISH); sklejone tworzą jeden poprawny strumień zlib,
+    // a sumy adler32 pasów łączy adler32_combine
+    auto encode = [&](EncodedStrip& strip, bool last) {
+        // Wiersz poprzedzający pas jest potrzebny filtrowi Up
+        const int first = strip.firstRow > 0 ? strip.firstRow - 1 : 0;
+        const int rows = strip.rowCount + (strip.firstRow - first);
+        std::vector<uint8_t> raster(lineBytes * rows);
+        source(first, rows, raster.data(), lineBytes);
+
+        std::vector<uint8_t> filtered((lineBytes + 1) * strip.rowCount);
+        for (int y = 0; y < strip.rowCount; y++) {
+            const int local = y + (strip.firstRow - first);
+            const uint8_t* row = raster.data() + static_cast<size_t>(local) * lineBytes;
+            uint8_t* line = filtered.data() + static_cast<size_t>(y) * (lineBytes + 1);
+            const bool repeated = local > 0 && std::memcmp(row, row - lineBytes, lineBytes) == 0;
+
+            // Filtr Up dla powtórzonego wiersza daje same zera, inaczej None
+            line[0] = repeated ? 2 : 0;
+            if (repeated) {
+                std::memset(line + 1, 0, lineBytes);
+            } else {
+                std::memcpy(line + 1, row, lineBytes);
+            }
+        }
+        raster = std::vector<uint8_t>();
+
+        strip.filteredSize = filtered.size();
+        strip.adler = adler32(1L, filtered.data(), static_cast<uInt>(filtered.size()));
+
+        z_stream stream;
+        std::memset(&stream, 0, sizeof(stream));
+        if (deflateInit2(&stream, std::clamp(options.compression, 1, 9), Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            strip.ok = false;
+            return;
+        }
+        strip.data.resize(deflateBound(&stream, static_cast<uLong>(filtered.size())) + 16);
+        stream.next_in = filtered.data();
+        stream.avail_in = static_cast<uInt>(filtered.size());
+        stream.next_out = strip.data.data();
+        stream.avail_out = static_cast<uInt>(strip.data.size());
+        const int status = deflate(&stream, last ? Z_FINISH : Z_FULL_FLUSH);
+        strip.ok = last ? status == Z_STREAM_END : (status == Z_OK && stream.avail_in == 0);
+        strip.data.resize(stream.total_out);
+        deflateEnd(&stream);
+    };
+
+    // Wynik trafia do bloków IDAT o stałym rozmiarze
+    std::vector<uint8_t> chunk;
+    chunk.reserve(kChunkSize);
+    auto append = [&](const uint8_t* data, size_t size) {
+        while (size > 0) {
+            const size_t part = std::min(size, kChunkSize - chunk.size());
+            chunk.insert(chunk.end(), data, data + part);
+            data += part;
+            size -= part;
+            if (chunk.size() == kChunkSize) {
+                writePngChunk(output, "IDAT", chunk.data(), chunk.size());
+                chunk.clear();
+            }
+        }
+    };
+
+    static const uint8_t zlibHeader[2] = {0x78, 0x9C};
+    append(zlibHeader, sizeof(zlibHeader));
+
+    uLong adler = 1;
+    std::vector<EncodedStrip> strips = planStrips(size, lineBytes, options);
+    const bool encoded = processStrips(strips, options.parallel, encode, [&](EncodedStrip& strip) {
+        append(strip.data.data(), strip.data.size());
+        adler = adler32_combine(adler, strip.adler, static_cast<z_off_t>(strip.filteredSize));
+        strip.data = std::vector<uint8_t>();
+        return static_cast<bool>(output);
+    });
+    if (!encoded) {
+        return false;
+    }
+
+    uint8_t trailer[4];
+    putBigEndian32(trailer, static_cast<uint32_t>(adler));
+    append(trailer, sizeof(trailer));
+    if (!chunk.empty()) {
+        writePngChunk(output, "IDAT", chunk.data(), chunk.size());
+    }
+
+    writePngChunk(output, "IEND", nullptr, 0);
+    return static_cast<bool>(output);
+}
+
+// ---- TIFF / CCITT Group 4 ----
+
+struct FaxCode {
+    uint16_t code;
+    uint8_t length;
+};
+
+// Kody długości ciągów z ITU-T T.4: indeksy 0-63 kończące, 64-103 uzupełniające
+// (64, 128, ..., 2560); indeks kodu uzupełniającego = 63 + długość / 64
+constexpr FaxCode kWhiteCodes[104] = {
+    {0x035, 8}, {0x007, 6}, {0x007, 4}, {0x008, 4}, {0x00B, 4}, {0x00C, 4}, {0x00E, 4}, {0x00F, 4},
+    {0x013, 5}, {0x014, 5}, {0x007, 5}, {0x008, 5}, {0x008, 6}, {0x003, 6}, {0x034, 6}, {0x035, 6},
+    {0x02A, 6}, {0x02B, 6}, {0x027, 7}, {0x00C, 7}, {0x008, 7}, {0x017, 7}, {0x003, 7}, {0x004, 7},
+    {0x028, 7}, {0x02B, 7}, {0x013, 7}, {0x024, 7}, {0x018, 7}, {0x002, 8}, {0x003, 8}, {0x01A, 8},
+    {0x01B, 8}, {0x012, 8}, {0x013, 8}, {0x014, 8}, {0x015, 8}, {0x016, 8}, {0x017, 8}, {0x028, 8},
+    {0x029, 8}, {0x02A, 8}, {0x02B, 8}, {0x02C, 8}, {0x02D, 8}, {0x004, 8}, {0x005, 8}, {0x00A, 8},
+    {0x00B, 8}, {0x052, 8}, {0x053, 8}, {0x054, 8}, {0x055, 8}, {0x024, 8}, {0x025, 8}, {0x058, 8},
+    {0x059, 8}, {0x05A, 8}, {0x05B, 8}, {0x04A, 8}, {0x04B, 8}, {0x032, 8}, {0x033, 8}, {0x034, 8},
+    {0x01B, 5}, {0x012, 5}, {0x017, 6}, {0x037, 7}, {0x036, 8}, {0x037, 8}, {0x064, 8}, {0x065, 8},
+    {0x068, 8}, {0x067, 8}, {0x0CC, 9}, {0x0CD, 9}, {0x0D2, 9}, {0x0D3, 9}, {0x0D4, 9}, {0x0D5, 9},
+    {0x0D6, 9}, {0x0D7, 9}, {0x0D8, 9}, {0x0D9, 9}, {0x0DA, 9}, {0x0DB, 9}, {0x098, 9}, {0x099, 9},
+    {0x09A, 9}, {0x018, 6}, {0x09B, 9}, {0x008, 11}, {0x00C, 11}, {0x00D, 11}, {0x012, 12}, {0x013, 12},
+    {0x014, 12}, {0x015, 12}, {0x016, 12}, {0x017, 12}, {0x01C, 12}, {0x01D, 12}, {0x01E, 12}, {0x01F, 12},
+};
+constexpr FaxCode kBlackCodes[104] = {
+    {0x037, 10}, {0x002, 3}, {0x003, 2}, {0x002, 2}, {0x003, 3}, {0x003, 4}, {0x002, 4}, {0x003, 5},
+    {0x005, 6}, {0x004, 6}, {0x004, 7}, {0x005, 7}, {0x007, 7}, {0x004, 8}, {0x007, 8}, {0x018, 9},
+    {0x017, 10}, {0x018, 10}, {0x008, 10}, {0x067, 11}, {0x068, 11}, {0x06C, 11}, {0x037, 11}, {0x028, 11},
+    {0x017, 11}, {0x018, 11}, {0x0CA, 12}, {0x0CB, 12}, {0x0CC, 12}, {0x0CD, 12}, {0x068, 12}, {0x069, 12},
+    {0x06A, 12}, {0x06B, 12}, {0x0D2, 12}, {0x0D3, 12}, {0x0D4, 12}, {0x0D5, 12}, {0x0D6, 12}, {0x0D7, 12},
+    {0x06C, 12}, {0x06D, 12}, {0x0DA, 12}, {0x0DB, 12}, {0x054, 12}, {0x055, 12}, {0x056, 12}, {0x057, 12},
+    {0x064, 12}, {0x065, 12}, {0x052, 12}, {0x053, 12}, {0x024, 12}, {0x037, 12}, {0x038, 12}, {0x027, 12},
+    {0x028, 12}, {0x058, 12}, {0x059, 12}, {0x02B, 12}, {0x02C, 12}, {0x05A, 12}, {0x066, 12}, {0x067, 12},
+    {0x00F, 10}, {0x0C8, 12}, {0x0C9, 12}, {0x05B, 12}, {0x033, 12}, {0x034, 12}, {0x035, 12}, {0x06C, 13},
+    {0x06D, 13}, {0x04A, 13}, {0x04B, 13}, {0x04C, 13}, {0x04D, 13}, {0x072, 13}, {0x073, 13}, {0x074, 13},
+    {0x075, 13}, {0x076, 13}, {0x077, 13}, {0x052, 13}, {0x053, 13}, {0x054, 13}, {0x055, 13}, {0x05A, 13},
+    {0x05B, 13}, {0x064, 13}, {0x065, 13}, {0x008, 11}, {0x00C, 11}, {0x00D, 11}, {0x012, 12}, {0x013, 12},
+    {0x014, 12}, {0x015, 12}, {0x016, 12}, {0x017, 12}, {0x01C, 12}, {0x01D, 12}, {0x01E, 12}, {0x01F, 12},
+};
+
+constexpr FaxCode kPassCode = {0x1, 4};
+constexpr FaxCode kHorizontalCode = {0x1, 3};
+// Tryb pionowy, indeks = b1 - a1 + 3 (VR3 ... V0 ... VL3)
+constexpr FaxCode kVerticalCodes[7] = {
+    {0x03, 7}, {0x03, 6}, {0x03, 3}, {0x1, 1}, {0x2, 3}, {0x02, 6}, {0x02, 7}
+};
+
+class BitWriter
+{
+public:
+    void put(FaxCode code)
+    {
+        m_accumulator = (m_accumulator << code.length) | code.code;
+        m_bits += code.length;
+        while (m_bits >= 8) {
+            m_bits -= 8;
+            m_bytes.push_back(uint8_t(m_accumulator >> m_bits));
+        }
+    }
+
+    // Długość ciągu: kody uzupełniające i kod kończący
+    void putRun(int run, const FaxCode* table)
+    {
+        while (run >= 2624) {
+            put(table[63 + (2560 >> 6)]);
+            run -= 2560;
+        }
+        if (run >= 64) {
+            put(table[63 + (run >> 6)]);
+            run &= 63;
+        }
+        put(table[run]);
+    }
+
+    std::vector<uint8_t> finish()
+    {
+        if (m_bits > 0) {
+            m_bytes.push_back(uint8_t(m_accumulator << (8 - m_bits)));
+            m_bits = 0;
+        }
+        return std::move(m_bytes);
+    }
+
+private:
+    uint64_t m_accumulator = 0;
+    int m_bits = 0;
+    std::vector<uint8_t> m_bytes;
+};
+
+inline int pixel(const uint8_t* line, int x)
+{
+    return (line[x >> 3] >> (7 - (x & 7))) & 1;
+}
+
+// Pierwsza pozycja >= start o kolorze różnym od color (lub width).
+// Pełne bajty tła lub modułu są pomijane w całości.
+int findChange(const uint8_t* line, int start, int width, int color)
+{
+    const uint8_t skip = color ? 0xFF : 0x00;
+    int x = start;
+    while (x < width) {
+        if ((x & 7) == 0 && x + 8 <= width && line[x >> 3] == skip) {
+            x += 8;
+            continue;
+        }
+        if (pixel(line, x) != color) {
+            return x;
+        }
+        x++;
+    }
+    return width;
+}
+
+// Kodowanie dwuwymiarowe T.6 względem poprzedniego wiersza (pierwszy wiersz
+// odnosi się do wyimaginowanego białego wiersza)
+std::vector<uint8_t> encodeGroup4(const uint8_t* raster, size_t lineBytes, int width, int height)
+{
+    BitWriter writer;
+    const std::vector<uint8_t> whiteLine(lineBytes, 0);
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* line = raster + static_cast<size_t>(y) * lineBytes;
+        const uint8_t* reference = y > 0 ? line - lineBytes : whiteLine.data();
+
+        int a0 = 0;
+        int a1 = pixel(line, 0) ? 0 : findChange(line, 0, width, 0);
+        int b1 = pixel(reference, 0) ? 0 : findChange(reference, 0, width, 0);
+
+        for (;;) {
+            const int b2 = b1 < width ? findChange(reference, b1, width, pixel(reference, b1)) : width;
+            if (b2 >= a1) {
+                const int distance = b1 - a1;
+                if (distance >= -3 && distance <= 3) {
+                    writer.put(kVerticalCodes[distance + 3]);
+                    a0 = a1;
+                } else {
+                    const int a2 = a1 < width ? findChange(line, a1, width, pixel(line, a1)) : width;
+                    writer.put(kHorizontalCode);
+                    if (a0 + a1 == 0 || pixel(line, a0) == 0) {
+                        writer.putRun(a1 - a0, kWhiteCodes);
+                        writer.putRun(a2 - a1, kBlackCodes);
+                    } else {
+                        writer.putRun(a1 - a0, kBlackCodes);
+                        writer.putRun(a2 - a1, kWhiteCodes);
+                    }
+                    a0 = a2;
+                }
+            } else {
+                writer.put(kPassCode);
+                a0 = b2;
+            }
+
+            if (a0 >= width) {
+                break;
+            }
+            const int color = pixel(line, a0);
+            a1 = findChange(line, a0, width, color);
+            b1 = findChange(reference, a0, width, !color);
+            b1 = findChange(reference, b1, width, color);
+        }
+    }
+
+    // EOFB
+    writer.put({0x001, 12});
+    writer.put({0x001, 12});
+    return writer.finish();
+}
+
+void putLittleEndian16(std::vector<uint8_t>& out, uint16_t value)
+{
+    out.push_back(uint8_t(value));
+    out.push_back(uint8_t(value >> 8));
+}
+
+void putLittleEndian32(std::vector<uint8_t>& out, uint32_t value)
+{
+    putLittleEndian16(out, uint16_t(value));
+    putLittleEndian16(out, uint16_t(value >> 16));
+}
+
+bool writeTiff(const RowSource& source, int size, size_t lineBytes, const BitmapOptions& options, std::ostream& output)
+{
+
+    // Pasy TIFF są kodowane T.6 niezależnie (każdy względem białego wiersza),
+    // więc mogą powstawać równolegle. Surowy raster istnieje tylko dla
+    // bieżącej fali; w pamięci zostają jedynie skompresowane pasy, bo IFD
+    // z ich przesunięciami poprzedza dane w pliku.
+    std::vector<EncodedStrip> strips = planStrips(size, lineBytes, options);
+    const bool encoded = processStrips(strips, options.parallel, [&](EncodedStrip& strip, bool) {
+        std::vector<uint8_t> raster(lineBytes * strip.rowCount);
+        source(strip.firstRow, strip.rowCount, raster.data(), lineBytes);
+        strip.data = encodeGroup4(raster.data(), lineBytes, size, strip.rowCount);
+    }, [](EncodedStrip&) { return true; });
+    if (!encoded) {
+        return false;
+    }
+
+    // Układ pliku: nagłówek, IFD, tablice pasów (gdy jest ich więcej niż
+    // jeden), wartości rozdzielczości, dane pasów
+    enum : uint16_t { Short = 3, Long = 4, Rational = 5 };
+    const uint16_t entryCount = 13;
+    const uint32_t stripCount = static_cast<uint32_t>(strips.size());
+    const uint32_t ifdOffset = 8;
+    const uint32_t arraysOffset = ifdOffset + 2 + entryCount * 12 + 4;
+    const uint32_t arrayBytes = stripCount > 1 ? stripCount * 4 : 0;
+    const uint32_t resolutionOffset = arraysOffset + 2 * arrayBytes;
+    const uint32_t dataOffset = resolutionOffset + 16;
+
+    std::vector<uint8_t> file = {'I', 'I', 42, 0};
+    putLittleEndian32(file, ifdOffset);
+
+    putLittleEndian16(file, entryCount);
+    auto entry = [&](uint16_t tag, uint16_t type, uint32_t count, uint32_t value) {
+        putLittleEndian16(file, tag);
+        putLittleEndian16(file, type);
+        putLittleEndian32(file, count);
+        if (type == Short) {
+            putLittleEndian16(file, uint16_t(value));
+            putLittleEndian16(file, 0);
+        } else {
+            putLittleEndian32(file, value);
+        }
+    };
+    const uint32_t firstStripBytes = static_cast<uint32_t>(strips.front().data.size());
+    entry(256, Long, 1, static_cast<uint32_t>(size));                          // ImageWidth
+    entry(257, Long, 1, static_cast<uint32_t>(size));                          // ImageLength
+    entry(258, Short, 1, 1);                                                   // BitsPerSample
+    entry(259, Short, 1, 4);                                                   // Compression = CCITT T.6
+    entry(262, Short, 1, 0);                                                   // Photometric = WhiteIsZero
+    entry(273, Long, stripCount, stripCount > 1 ? arraysOffset : dataOffset);  // StripOffsets
+    entry(277, Short, 1, 1);                                                   // SamplesPerPixel
+    entry(278, Long, 1, static_cast<uint32_t>(strips.front().rowCount));       // RowsPerStrip
+    entry(279, Long, stripCount, stripCount > 1 ? arraysOffset + arrayBytes : firstStripBytes); // StripByteCounts
+    entry(282, Rational, 1, resolutionOffset);                                 // XResolution
+    entry(283, Rational, 1, resolutionOffset + 8);                             // YResolution
+    entry(293, Long, 1, 0);                                                    // T6Options
+    entry(296, Short, 1, 2);                                                   // ResolutionUnit = cal
+    putLittleEndian32(file, 0);
+
+    if (stripCount > 1) {
+        uint32_t offset = dataOffset;
+        for (const EncodedStrip& strip : strips) {
+            putLittleEndian32(file, offset);
+            offset += static_cast<uint32_t>(strip.data.size());
+        }
+        for (const EncodedStrip& strip : strips) {
+            putLittleEndian32(file, static_cast<uint32_t>(strip.data.size()));
+        }
+    }
+
+    // Rozdzielczość jako ułamek z dokładnością do 1/1000 DPI
+    const double dpi = options.dpi > 0.0 ? options.dpi : 72.0;
+    for (int i = 0; i < 2; i++) {
+        putLittleEndian32(file, static_cast<uint32_t>(std::lround(dpi * 1000.0)));
+        putLittleEndian32(file, 1000);
+    }
+
+    writeBytes(output, file.data(), file.size());
+    for (const EncodedStrip& strip : strips) {
+        writeBytes(output, strip.data.data(), strip.data.size());
+    }
+    return static_cast<bool>(output);
+}
+
+bool writeRaster(const RowSource& source, int size, size_t lineBytes, BitmapFormat format,
+                 const BitmapOptions& options, std::ostream& output)
+{
+    return format == BitmapFormat::Png ? writePng(source, size, lineBytes, options, output)
+                                       : writeTiff(source, size, lineBytes, options, output);
+}
+
+} // namespace
+
+bool writeBitmap(const QRMatrix& matrix, BitmapFormat format, std::ostream& output, const BitmapOptions& options)
+{
+    RasterOptions rasterOptions;
+    rasterOptions.scale = options.scale;
+    rasterOptions.border = options.border;
+    const StripRasterizer rasterizer(matrix, rasterOptions, options.size);
+    if (rasterizer.isNull()) {
+        return false;
+    }
+
+    const RowSource source = [&rasterizer](int firstRow, int rowCount, uint8_t* destination, size_t bytesPerLine) {
+        rasterizer.render(firstRow, rowCount, destination, bytesPerLine);
+    };
+    return writeRaster(source, rasterizer.size(), rasterizer.bytesPerLine(), format, options, output);
+}
+
+bool writeBitmap(const uint8_t* raster, int size, size_t bytesPerLine, BitmapFormat format,
+                 std::ostream& output, const BitmapOptions& options)
+{
+    const size_t lineBytes = rasterBytesPerLine(size, PixelFormat::Mono);
+    if (!raster || size < 1 || bytesPerLine < lineBytes) {
+        return false;
+    }
+
+    const RowSource source = [=](int firstRow, int rowCount, uint8_t* destination, size_t destinationBytesPerLine) {
+        for (int y = 0; y < rowCount; y++) {
+            std::memcpy(destination + static_cast<size_t>(y) * destinationBytesPerLine,
+                        raster + static_cast<size_t>(firstRow + y) * bytesPerLine, lineBytes);
+        }
+    };
+    return writeRaster(source, size, lineBytes, format, options, output);
+}
+
+bool bitmapFormatForPath(const std::string& path, BitmapFormat& format)
+{
+    const size_t dot = path.rfind('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+
+    std::string extension = path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (extension == "png") {
+        format = BitmapFormat::Png;
+    } else if (extension == "tif" || extension == "tiff") {
+        format = BitmapFormat::Tiff;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace qrcore
@@ -0,0 +1,205 @@
+#include "qrcore/camera_pipeline.h"
+#include "qrcore/multi_decoder.h"
+#include "qrcore/qr_decoder.h"
+
+namespace qrcore {
+
+CameraPipeline::CameraPipeline(QObject* parent)
+    : QObject(parent)
+{
+}
+
+CameraPipeline::~CameraPipeline()
+{
+    stop();
+}
+
+bool CameraPipeline::start(int deviceIndex)
+{
+    stop();
+
+    if (!m_capture.open(deviceIndex) || !m_capture.isOpened()) {
+        return false;
+    }
+    m_fromFile = false;
+    startThreads();
+    return true;
+}
+
+bool CameraPipeline::startFile(const std::string& path)
+{
+    stop();
+
+    if (!m_capture.open(path) || !m_capture.isOpened()) {
+        return false;
+    }
+    double fps = m_capture.get(cv::CAP_PROP_FPS);
+    if (!(fps > 0.0 && fps <= 1000.0)) {
+        fps = 30.0;
+    }
+    m_fromFile = true;
+    m_frameInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / fps));
+    startThreads();
+    return true;
+}
+
+void CameraPipeline::startThreads()
+{
+    int workers = m_workerCount;
+    if (workers <= 0) {
+        workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    }
+    if (workers < 1) {
+        workers = 1;
+    }
+
+    m_frames.reset(new RingBuffer<CapturedFrame>(m_bufferCapacity));
+    m_captured = 0;
+    m_dropped = 0;
+    m_decoded = 0;
+    m_found = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_structuredAppendMutex);
+        m_structuredAppend.clear();
+    }
+    m_running = true;
+
+    m_captureThread = std::thread(&CameraPipeline::captureLoop, this);
+    for (int i = 0; i < workers; i++) {
+        m_workers.emplace_back(&CameraPipeline::decodeLoop, this);
+    }
+}
+
+void CameraPipeline::stop()
+{
+    m_running = false;
+    m_wakeCondition.notify_all();
+
+    if (m_captureThread.joinable()) {
+        m_captureThread.join();
+    }
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    m_frames.reset();
+
+    if (m_capture.isOpened()) {
+        m_capture.release();
+    }
+}
+
+CameraPipeline::Stats CameraPipeline::stats() const
+{
+    Stats stats;
+    stats.captured = m_captured.load();
+    stats.dropped = m_dropped.load();
+    stats.decoded = m_decoded.load();
+    stats.found = m_found.load();
+    return stats;
+}
+
+void CameraPipeline::captureLoop()
+{
+    uint64_t index = 0;
+    auto nextFrame = std::chrono::steady_clock::now();
+    while (m_running.load()) {
+        // Odczyt blokuje do czasu nadejścia klatki - tempo wyznacza kamera,
+        // a dla pliku zapisana częstotliwość klatek
+        if (m_fromFile) {
+            std::this_thread::sleep_until(nextFrame);
+            nextFrame += m_frameInterval;
+        }
+        CapturedFrame frame;
+        if (!m_capture.read(frame.image) || frame.image.empty()) {
+            if (m_running.exchange(false)) {
+                if (m_fromFile) {
+                    emit sourceFinished();
+                } else {
+                    emit captureFailed(QStringLiteral("Kamera przestała dostarczać obraz"));
+                }
+            }
+            break;
+        }
+
+        frame.index = index++;
+        frame.captured = std::chrono::steady_clock::now();
+        m_dropped += m_frames->pushDropOldest(std::move(frame));
+        ++m_captured;
+
+        m_wakeCondition.notify_one();
+    }
+    m_wakeCondition.notify_all();
+}
+
+void CameraPipeline::decodeLoop()
+{
+    // Każdy dekoder ma własny kontekst (bufory, detektor, obszar śledzenia)
+    DecoderContext context;
+    CapturedFrame frame;
+    while (m_running.load()) {
+        if (!m_frames->tryPop(frame)) {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wakeCondition.wait_for(lock, std::chrono::milliseconds(20));
+            continue;
+        }
+
+        DecodeResult result = context.decode(frame.image);
+        ++m_decoded;
+
+        if (result.isValid() && m_running.load()) {
+            ++m_found;
+            if (result.structuredAppend.isValid()) {
+                collectStructuredAppend(frame.image, result);
+            } else {
+                publish(result);
+            }
+        }
+    }
+}
+
+void CameraPipeline::collectStructuredAppend(const cv::Mat& image, const DecodeResult& part)
+{
+    StructuredAppendCollector::Progress progress;
+    DecodeResult message;
+    bool complete = false;
+    {
+        std::lock_guard<std::mutex> lock(m_structuredAppendMutex);
+        progress = m_structuredAppend.add(part);
+        complete = m_structuredAppend.takeComplete(message);
+    }
+
+    // Obszar śledzenia prowadzi detektor do tego samego symbolu - przy
+    // niepełnej serii kadr jest przeszukiwany pod kątem pozostałych części
+    if (!complete && progress.received < progress.total) {
+        MultiDecodeOptions options;
+        options.parallel = false; // pozostałe dekodery zajmują już rdzenie
+        const std::vector<DecodeResult> others = decodeMulti(image, options);
+
+        std::lock_guard<std::mutex> lock(m_structuredAppendMutex);
+        for (const DecodeResult& other : others) {
+            const StructuredAppendCollector::Progress added = m_structuredAppend.add(other);
+            if (added.total == progress.total && other.structuredAppend.parity == part.structuredAppend.parity) {
+                progress = added;
+            }
+        }
+        complete = m_structuredAppend.takeComplete(message);
+    }
+
+    emit structuredAppendProgress(progress.received, progress.total);
+    if (complete) {
+        publish(message);
+    }
+}
+
+void CameraPipeline::publish(const DecodeResult& result)
+{
+    QPolygonF corners;
+    for (const cv::Point2f& point : result.corners) {
+        corners << QPointF(point.x, point.y);
+    }
+    emit codeDecoded(QByteArray::fromStdString(result.text), corners);
+}
+
+} // namespace qrcore
@@ -0,0 +1,364 @@
+#include "qrcore/decoder_backend.h"
+
+#include "qrcore/multi_decoder.h"
+#include "qrcore/symbol_reader.h"
+
+#include "decoder_internal.h"
+
+#include <opencv2/objdetect.hpp>
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+
+namespace qrcore {
+
+namespace {
+
+// Detektor OpenCV: obraz straight każdego symbolu jest czytany ponownie,
+// by uzupełnić nagłówek Structured Append
+class OpenCvBackend : public DecoderBackend
+{
+public:
+    const char* name() const override { return "opencv"; }
+
+    std::vector<DecodeResult> decode(const cv::Mat& gray, bool multiple) override
+    {
+        std::vector<DecodeResult> results;
+        if (!multiple) {
+            DecodeResult result;
+            cv::Mat straight;
+            result.text = m_detector.detectAndDecode(gray, result.corners, straight);
+            if (result.isValid()) {
+                readStructuredAppend(straight, result);
+                results.push_back(std::move(result));
+            }
+            return results;
+        }
+
+        std::vector<std::string> texts;
+        cv::Mat points;
+        std::vector<cv::Mat> straights;
+        if (!m_detector.detectAndDecodeMulti(gray, texts, points, straights) || points.empty()) {
+            return results;
+        }
+
+        // Punkty: 4 narożniki na każdy kod, w kolejności kodów
+        cv::Mat corners;
+        points.reshape(2, 1).convertTo(corners, CV_32FC2);
+        const cv::Point2f* point = corners.ptr<cv::Point2f>();
+        const size_t count = std::min(texts.size(), corners.total() / 4);
+
+        for (size_t i = 0; i < count; i++) {
+            if (texts[i].empty()) {
+                continue; // wykryty, ale nieodczytany (np. ucięty krawędzią obrazu)
+            }
+            DecodeResult result;
+            result.text = std::move(texts[i]);
+            result.corners.assign(point + i * 4, point + i * 4 + 4);
+            if (i < straights.size()) {
+                readStructuredAppend(straights[i], result);
+            }
+            results.push_back(std::move(result));
+        }
+        return results;
+    }
+
+private:
+    cv::QRCodeDetector m_detector;
+};
+
+std::unique_ptr<DecoderBackend> createOpenCvBackend()
+{
+    return std::make_unique<OpenCvBackend>();
+}
+
+struct BackendEntry {
+    const char* name;
+    std::unique_ptr<DecoderBackend> (*create)();
+    bool multiCode; // odczytuje dowolnie wiele kodów z jednego obrazu
+};
+
+// Wkompilowane backendy od najtańszego - to także domyślna kolejność kaskady.
+// Własny detektor składa ograniczoną liczbę wzorców (do 4 symboli), więc
+// przy odczycie wielu kodów jest pomijany - patrz DecoderCascade.
+const BackendEntry kBackends[] = {
+    {"native", detail::createNativeBackend, false},
+#ifdef QRCORE_HAVE_QUIRC
+    {"quirc", detail::createQuircBackend, true},
+#endif
+#ifdef QRCORE_HAVE_ZXING
+    {"zxing", detail::createZxingBackend, true},
+#endif
+    {"opencv", createOpenCvBackend, true},
+};
+constexpr size_t kBackendCount = sizeof(kBackends) / sizeof(kBackends[0]);
+
+// Liczniki wspólne dla wszystkich kaskad (atomowe - kaskady działają w wielu wątkach)
+struct BackendCounters {
+    std::atomic<uint64_t> attempts{0};
+    std::atomic<uint64_t> successes{0};
+    std::atomic<uint64_t> microseconds{0};
+};
+
+std::array<BackendCounters, kBackendCount>& counters()
+{
+    static std::array<BackendCounters, kBackendCount> instance;
+    return instance;
+}
+
+bool findBackend(const std::string& name, size_t& index)
+{
+    for (size_t i = 0; i < kBackendCount; i++) {
+        if (name == kBackends[i].name) {
+            index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseIndices(const std::string& list, std::vector<size_t>& indices)
+{
+    indices.clear();
+    std::istringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        const size_t first = name.find_first_not_of(" \t");
+        const size_t last = name.find_last_not_of(" \t");
+        if (first == std::string::npos) {
+            continue;
+        }
+        size_t index = 0;
+        if (!findBackend(name.substr(first, last - first + 1), index)) {
+            return false;
+        }
+        indices.push_back(index);
+    }
+    return !indices.empty();
+}
+
+std::mutex g_cascadeMutex;
+std::vector<size_t> g_cascade; // pusta - ustawienie domyślne
+
+std::vector<size_t> cascadeIndices()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_cascadeMutex);
+        if (!g_cascade.empty()) {
+            return g_cascade;
+        }
+    }
+
+    // Zmienna środowiskowa jest czytana raz - konfiguracja wdrożenia
+    static const std::vector<size_t> defaults = [] {
+        std::vector<size_t> indices;
+        const char* environment = std::getenv("QRCORE_DECODERS");
+        if (environment && !parseIndices(environment, indices)) {
+            qWarning() << "Nieznany backend w QRCORE_DECODERS:" << environment;
+            indices.clear();
+        }
+        if (indices.empty()) {
+            for (size_t i = 0; i < kBackendCount; i++) {
+                indices.push_back(i);
+            }
+        }
+        return indices;
+    }();
+    return defaults;
+}
+
+} // namespace
+
+std::vector<std::string> availableDecoderBackends()
+{
+    std::vector<std::string> names;
+    for (const BackendEntry& entry : kBackends) {
+        names.emplace_back(entry.name);
+    }
+    return names;
+}
+
+std::unique_ptr<DecoderBackend> createDecoderBackend(const std::string& name)
+{
+    size_t index = 0;
+    return findBackend(name, index) ? kBackends[index].create() : nullptr;
+}
+
+std::vector<std::string> parseDecoderBackends(const std::string& list)
+{
+    std::vector<size_t> indices;
+    std::vector<std::string> names;
+    if (parseIndices(list, indices)) {
+        for (size_t index : indices) {
+            names.emplace_back(kBackends[index].name);
+        }
+    }
+    return names;
+}
+
+std::vector<std::string> decoderCascade()
+{
+    std::vector<std::string> names;
+    for (size_t index : cascadeIndices()) {
+        names.emplace_back(kBackends[index].name);
+    }
+    return names;
+}
+
+bool setDecoderCascade(const std::vector<std::string>& names)
+{
+    std::vector<size_t> indices;
+    for (const std::string& name : names) {
+        size_t index = 0;
+        if (!findBackend(name, index)) {
+            return false;
+        }
+        indices.push_back(index);
+    }
+
+    std::lock_guard<std::mutex> lock(g_cascadeMutex);
+    g_cascade = std::move(indices);
+    return true;
+}
+
+std::vector<DecoderBackendStats> decoderBackendStats()
+{
+    std::vector<DecoderBackendStats> stats(kBackendCount);
+    for (size_t i = 0; i < kBackendCount; i++) {
+        const BackendCounters& counter = counters()[i];
+        stats[i].name = kBackends[i].name;
+        stats[i].attempts = counter.attempts.load(std::memory_order_relaxed);
+        stats[i].successes = counter.successes.load(std::memory_order_relaxed);
+        stats[i].microseconds = counter.microseconds.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void resetDecoderBackendStats()
+{
+    for (BackendCounters& counter : counters()) {
+        counter.attempts = 0;
+        counter.successes = 0;
+        counter.microseconds = 0;
+    }
+}
+
+DecoderCascade::DecoderCascade() : m_binarizer(defaultBinarization())
+{
+    for (size_t index : cascadeIndices()) {
+        m_stages.push_back(Stage{index, nullptr});
+    }
+}
+
+DecoderCascade::DecoderCascade(const std::vector<std::string>& names) : m_binarizer(defaultBinarization())
+{
+    for (const std::string& name : names) {
+        size_t index = 0;
+        if (findBackend(name, index)) {
+            m_stages.push_back(Stage{index, nullptr});
+        }
+    }
+    if (m_stages.empty()) {
+        *this = DecoderCascade();
+    }
+}
+
+std::vector<DecodeResult> DecoderCascade::decode(const cv::Mat& gray, bool multiple)
+{
+    if (gray.empty()) {
+        return {};
+    }
+    if (!m_binarizer.options().enabled()) {
+        return decodeStages(gray, multiple);
+    }
+
+    // Progowanie przed backendami; obraz w innym formacie niż CV_8UC1
+    // trafia do nich bez zmian
+    if (m_binarizer.options().stage == BinarizeStage::Always) {
+        const cv::Mat& binary = m_binarizer.apply(gray);
+        return decodeStages(binary.empty() ? gray : binary, multiple);
+    }
+
+    // Drugie podejście na obrazie binarnym - odblaski, cienie, niski kontrast
+    std::vector<DecodeResult> results = decodeStages(gray, multiple);
+    if (results.empty()) {
+        const cv::Mat& binary = m_binarizer.apply(gray);
+        if (!binary.empty()) {
+            results = decodeStages(binary, multiple);
+        }
+    }
+    return results;
+}
+
+std::vector<DecodeResult> DecoderCascade::decodeStages(const cv::Mat& gray, bool multiple)
+{
+    // Jeden kod: pierwszy backend, który coś odczytał, kończy kaskadę.
+    // Wiele kodów: tani backend mógł odczytać tylko część symboli, więc
+    // pracują wszystkie etapy, a ich wyniki są łączone bez powtórzeń.
+    // Backendy o ograniczonej liczbie symboli są wtedy pomijane, o ile
+    // kaskada ma inny, który odczyta wszystkie.
+    const bool skipLimited = multiple && std::any_of(m_stages.begin(), m_stages.end(), [](const Stage& stage) {
+        return kBackends[stage.backend].multiCode;
+    });
+
+    std::vector<DecodeResult> collected;
+    size_t ran = 0;
+    for (Stage& stage : m_stages) {
+        if (skipLimited && !kBackends[stage.backend].multiCode) {
+            continue;
+        }
+        ++ran;
+        if (!stage.instance) {
+            stage.instance = kBackends[stage.backend].create();
+        }
+
+        std::vector<DecodeResult> results;
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            results = stage.instance->decode(gray, multiple);
+        } catch (const std::exception& e) {
+            // Błąd jednego backendu nie przerywa kaskady
+            qWarning() << "Błąd backendu" << stage.instance->name() << ":" << e.what();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        BackendCounters& counter = counters()[stage.backend];
+        counter.attempts.fetch_add(1, std::memory_order_relaxed);
+        counter.microseconds.fetch_add(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()),
+            std::memory_order_relaxed);
+        if (results.empty()) {
+            continue;
+        }
+
+        counter.successes.fetch_add(1, std::memory_order_relaxed);
+        if (!multiple) {
+            return results;
+        }
+        std::move(results.begin(), results.end(), std::back_inserter(collected));
+    }
+
+    if (collected.empty() || ran == 1) {
+        return collected;
+    }
+    return mergeDuplicates(std::move(collected));
+}
+
+std::vector<std::string> DecoderCascade::names() const
+{
+    std::vector<std::string> names;
+    for (const Stage& stage : m_stages) {
+        names.emplace_back(kBackends[stage.backend].name);
+    }
+    return names;
+}
+
+} // namespace qrcore
@@ -0,0 +1,45 @@
+#ifndef QRCORE_DECODER_INTERNAL_H
+#define QRCORE_DECODER_INTERNAL_H
+
+#include "qrcore/decoder_backend.h"
+#include "qrcore/finder_detector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Elementy dekodowania współdzielone przez moduły biblioteki
+// (nagłówek wewnętrzny - nie jest instalowany)
+namespace qrcore {
+namespace detail {
+
+// Widok obrazu w skali szarości (kolejne wiersze co stride bajtów)
+struct GrayImage {
+    const uint8_t* data = nullptr;
+    int width = 0;
+    int height = 0;
+    size_t stride = 0;
+
+    const uint8_t* row(int y) const { return data + static_cast<size_t>(y) * stride; }
+};
+
+// Własny detektor na surowym buforze (patrz finder_detector.h)
+std::vector<FinderPattern> findFinderPatterns(const GrayImage& image);
+std::vector<DecodeResult> detectAndDecodeNative(const GrayImage& image, bool multiple);
+std::unique_ptr<DecoderBackend> createNativeBackend();
+
+// Fabryki opcjonalnych backendów - definiowane tylko wtedy, gdy
+// odpowiednia biblioteka została włączona w CMake
+#ifdef QRCORE_HAVE_QUIRC
+std::unique_ptr<DecoderBackend> createQuircBackend();
+#endif
+
+#ifdef QRCORE_HAVE_ZXING
+std::unique_ptr<DecoderBackend> createZxingBackend();
+#endif
+
+} // namespace detail
+} // namespace qrcore
+
+#endif // QRCORE_DECODER_INTERNAL_H
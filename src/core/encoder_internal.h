@@ -0,0 +1,91 @@
+#ifndef QRCORE_ENCODER_INTERNAL_H
+#define QRCORE_ENCODER_INTERNAL_H
+
+#include "qrcore/qr_encoder.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Elementy wbudowanego kodera współdzielone przez moduły biblioteki
+// (nagłówek wewnętrzny - nie jest instalowany)
+namespace qrcore {
+namespace detail {
+
+// Szablon symbolu danej wersji: wzorce funkcyjne oraz kolejność, w jakiej
+// bity słów kodowych trafiają do modułów (zygzak od prawego dolnego rogu)
+struct SymbolLayout {
+    enum : uint8_t { Dark = 1, Function = 2 };
+
+    int version = 0;
+    int size = 0;
+    std::vector<uint8_t> modules;     // flagi Dark/Function, indeks y * size + x
+    std::vector<uint32_t> dataOrder;  // indeksy modułów kolejnych bitów danych
+    QRMatrix functionPattern;         // ciemne moduły funkcyjne (format wyzerowany)
+    std::array<QRMatrix, 8> masks;    // wzorce masek ograniczone do modułów danych
+    std::array<QRMatrix, 8> maskColumns; // to samo po transpozycji
+};
+
+// Szablon dla wersji 1-40 (tworzony raz, bezpieczny wątkowo)
+const SymbolLayout& symbolLayout(int version);
+
+// Bufor bitów (MSB pierwszy)
+class BitBuffer
+{
+public:
+    void append(uint32_t value, int bits);
+    size_t size() const { return m_bits; }
+    const std::vector<uint8_t>& bytes() const { return m_bytes; }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    size_t m_bits = 0;
+};
+
+// Liczba znaków segmentu (dla trybu Byte - bajtów, dla Kanji - par bajtów)
+int segmentCharacterCount(const Segment& segment);
+
+// Długość segmentów w bitach dla wersji; -1, jeśli licznik się nie mieści
+// lub segment zawiera znaki spoza trybu
+long segmentsBitLength(const std::vector<Segment>& segments, int version);
+
+// Najmniejsza wersja (>= minVersion), w której mieszczą się segmenty; 0 gdy brak
+int chooseVersion(const std::vector<Segment>& segments, ErrorCorrection level, int minVersion = 1);
+
+// Słowa danych z terminatorem i wypełnieniem 0xEC/0x11; pusty wynik, gdy
+// segmenty nie mieszczą się w wersji
+std::vector<uint8_t> makeDataCodewords(const std::vector<Segment>& segments, int version, ErrorCorrection level);
+
+// Podział słów danych na bloki, słowa korekcyjne i przeplot
+std::vector<uint8_t> interleaveCodewords(const std::vector<uint8_t>& data, int version, ErrorCorrection level);
+
+// Kara maski liczona jak w libqrencode (N1-N4, bez różnic w remisach) na
+// wierszach bitowych symbolu i jego transpozycji (kolumnach)
+int maskPenalty(const QRMatrix& symbol, const QRMatrix& columns);
+int maskPenalty(const QRMatrix& symbol);
+
+// Transpozycja macierzy bitowej
+QRMatrix transposed(const QRMatrix& matrix);
+
+// Wartość wzorca maski dla modułu (x - kolumna, y - wiersz)
+bool maskBit(int mask, int x, int y);
+
+// Zapisuje słowo formatu dla poziomu i maski (obie kopie)
+void writeFormat(QRMatrix& symbol, ErrorCorrection level, int mask);
+
+// Odczytuje obie kopie 15-bitowego słowa formatu (odwrotność writeFormat)
+std::array<uint32_t, 2> readFormat(const QRMatrix& symbol);
+
+// Rozmieszcza słowa kodowe w szablonie i nakłada maskę (mask < 0 -
+// wybór maski o najniższej karze). chosenMask otrzymuje użytą maskę.
+QRMatrix buildSymbol(const SymbolLayout& layout, const std::vector<uint8_t>& codewords,
+                     ErrorCorrection level, int mask, bool parallel, int* chosenMask = nullptr);
+
+// Pełne kodowanie wbudowanym koderem
+QRMatrix encodeNative(const std::vector<Segment>& segments, const EncodeOptions& options);
+
+} // namespace detail
+} // namespace qrcore
+
+#endif // QRCORE_ENCODER_INTERNAL_H
@@ -0,0 +1,730 @@
+#include "qrcore/finder_detector.h"
+
+#include "qrcore/qr_matrix.h"
+#include "qrcore/qr_tables.h"
+#include "qrcore/symbol_reader.h"
+
+#include "decoder_internal.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define QRCORE_FINDER_SSE2 1
+#endif
+
+namespace qrcore {
+
+namespace {
+
+constexpr int kBlockShift = 5;               // bloki progowania 32x32
+constexpr int kBlockSize = 1 << kBlockShift;
+constexpr int kSmoothRadius = 2;             // próg ze średniej 5x5 bloków (160 px)
+constexpr int kMinContrast = 24;             // jednolite otoczenie - bez ciemnych pikseli
+constexpr size_t kMaxCandidates = 12;        // wzorce brane do składania trójek
+constexpr size_t kMaxTriples = 24;           // trójki sprawdzane przez próbkowanie
+
+// Progi lokalne: średnia jasność otoczenia 5x5 bloków. Bloki o zbyt małym
+// kontraście otoczenia dostają próg 0 (wszystko jasne), co wycina szum tła.
+class ThresholdMap
+{
+public:
+    explicit ThresholdMap(const detail::GrayImage& image)
+        : m_columns((image.width + kBlockSize - 1) >> kBlockShift),
+          m_rows((image.height + kBlockSize - 1) >> kBlockShift),
+          m_values(static_cast<size_t>(m_columns) * m_rows, 0)
+    {
+        const size_t blocks = m_values.size();
+        std::vector<uint32_t> sums(blocks, 0);
+        std::vector<uint32_t> counts(blocks, 0);
+        std::vector<uint8_t> minimums(blocks, 255);
+        std::vector<uint8_t> maximums(blocks, 0);
+
+        for (int y = 0; y < image.height; y++) {
+            const uint8_t* row = image.row(y);
+            const size_t base = static_cast<size_t>(y >> kBlockShift) * m_columns;
+            for (int bx = 0; bx < m_columns; bx++) {
+                const int begin = bx << kBlockShift;
+                const int end = std::min(image.width, begin + kBlockSize);
+                uint32_t sum = 0;
+                uint8_t low = 255;
+                uint8_t high = 0;
+                int x = begin;
+#ifdef QRCORE_FINDER_SSE2
+                if (end - begin == kBlockSize) {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x + 16));
+                    const __m128i sad = _mm_add_epi64(_mm_sad_epu8(a, _mm_setzero_si128()),
+                                                      _mm_sad_epu8(b, _mm_setzero_si128()));
+                    sum = static_cast<uint32_t>(_mm_cvtsi128_si32(sad) + _mm_cvtsi128_si32(_mm_srli_si128(sad, 8)));
+                    __m128i minimum = _mm_min_epu8(a, b);
+                    __m128i maximum = _mm_max_epu8(a, b);
+                    minimum = _mm_min_epu8(minimum, _mm_srli_si128(minimum, 8));
+                    minimum = _mm_min_epu8(minimum, _mm_srli_si128(minimum, 4));
+                    minimum = _mm_min_epu8(minimum, _mm_srli_si128(minimum, 2));
+                    minimum = _mm_min_epu8(minimum, _mm_srli_si128(minimum, 1));
+                    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 8));
+                    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 4));
+                    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 2));
+                    maximum = _mm_max_epu8(maximum, _mm_srli_si128(maximum, 1));
+                    low = static_cast<uint8_t>(_mm_cvtsi128_si32(minimum) & 0xFF);
+                    high = static_cast<uint8_t>(_mm_cvtsi128_si32(maximum) & 0xFF);
+                    x = end;
+                }
+#endif
+                for (; x < end; x++) {
+                    sum += row[x];
+                    low = std::min(low, row[x]);
+                    high = std::max(high, row[x]);
+                }
+                sums[base + bx] += sum;
+                counts[base + bx] += static_cast<uint32_t>(end - begin);
+                minimums[base + bx] = std::min(minimums[base + bx], low);
+                maximums[base + bx] = std::max(maximums[base + bx], high);
+            }
+        }
+
+        for (int by = 0; by < m_rows; by++) {
+            for (int bx = 0; bx < m_columns; bx++) {
+                uint64_t sum = 0;
+                uint64_t count = 0;
+                int low = 255;
+                int high = 0;
+                for (int ny = std::max(0, by - kSmoothRadius); ny <= std::min(m_rows - 1, by + kSmoothRadius); ny++) {
+                    for (int nx = std::max(0, bx - kSmoothRadius); nx <= std::min(m_columns - 1, bx + kSmoothRadius);
+                         nx++) {
+                        const size_t index = static_cast<size_t>(ny) * m_columns + nx;
+                        sum += sums[index];
+                        count += counts[index];
+                        low = std::min<int>(low, minimums[index]);
+                        high = std::max<int>(high, maximums[index]);
+                    }
+                }
+                m_values[static_cast<size_t>(by) * m_columns + bx] =
+                    high - low < kMinContrast ? 0 : static_cast<uint8_t>(sum / std::max<uint64_t>(count, 1));
+            }
+        }
+    }
+
+    uint8_t at(int x, int y) const
+    {
+        return m_values[static_cast<size_t>(y >> kBlockShift) * m_columns + (x >> kBlockShift)];
+    }
+
+private:
+    int m_columns;
+    int m_rows;
+    std::vector<uint8_t> m_values;
+};
+
+// Obraz z progami: ciemne są piksele poniżej progu swojego bloku
+struct Binarized {
+    const detail::GrayImage& image;
+    ThresholdMap thresholds;
+
+    bool inside(int x, int y) const { return x >= 0 && y >= 0 && x < image.width && y < image.height; }
+    bool dark(int x, int y) const { return image.row(y)[x] < thresholds.at(x, y); }
+
+    // Jasność w punkcie (środki pikseli w k + 0.5) z interpolacją dwuliniową
+    float sample(float x, float y) const
+    {
+        x = std::min(std::max(x - 0.5f, 0.0f), static_cast<float>(image.width - 1));
+        y = std::min(std::max(y - 0.5f, 0.0f), static_cast<float>(image.height - 1));
+        const int x0 = static_cast<int>(x);
+        const int y0 = static_cast<int>(y);
+        const int x1 = std::min(x0 + 1, image.width - 1);
+        const int y1 = std::min(y0 + 1, image.height - 1);
+        const float fx = x - x0;
+        const float fy = y - y0;
+        const uint8_t* top = image.row(y0);
+        const uint8_t* bottom = image.row(y1);
+        return (top[x0] * (1 - fx) + top[x1] * fx) * (1 - fy) + (bottom[x0] * (1 - fx) + bottom[x1] * fx) * fy;
+    }
+
+    bool darkAt(float x, float y) const
+    {
+        const int px = std::min(std::max(static_cast<int>(x), 0), image.width - 1);
+        const int py = std::min(std::max(static_cast<int>(y), 0), image.height - 1);
+        return sample(x, y) < thresholds.at(px, py);
+    }
+};
+
+// Proporcje biegów 1:1:3:1:1 z tolerancją połowy modułu
+bool finderRatio(const int counts[5])
+{
+    int total = 0;
+    for (int i = 0; i < 5; i++) {
+        if (counts[i] == 0) {
+            return false;
+        }
+        total += counts[i];
+    }
+    if (total < 7) {
+        return false;
+    }
+    const float module = total / 7.0f;
+    const float variance = module / 2.0f;
+    return std::fabs(module - counts[0]) < variance && std::fabs(module - counts[1]) < variance &&
+           std::fabs(3.0f * module - counts[2]) < 3.0f * variance && std::fabs(module - counts[3]) < variance &&
+           std::fabs(module - counts[4]) < variance;
+}
+
+// Kontrola 1:1:3:1:1 wzdłuż kierunku (dx, dy) przez piksel (x, y) leżący
+// w środkowym biegu; center - środek wzorca wzdłuż kierunku (w pikselach
+// od (x, y)), total - łączna długość biegów
+bool crossCheck(const Binarized& image, int x, int y, int dx, int dy, int maxCount, int originalTotal,
+                float& center, int& total)
+{
+    int counts[5] = {0, 0, 0, 0, 0};
+    auto inside = [&](int i) { return image.inside(x + i * dx, y + i * dy); };
+    auto dark = [&](int i) { return image.dark(x + i * dx, y + i * dy); };
+
+    int i = 0;
+    for (; inside(i) && dark(i); i--) {
+        counts[2]++;
+    }
+    if (!inside(i)) {
+        return false;
+    }
+    for (; inside(i) && !dark(i) && counts[1] <= maxCount; i--) {
+        counts[1]++;
+    }
+    if (!inside(i) || counts[1] > maxCount) {
+        return false;
+    }
+    for (; inside(i) && dark(i) && counts[0] <= maxCount; i--) {
+        counts[0]++;
+    }
+    if (counts[0] > maxCount) {
+        return false;
+    }
+
+    for (i = 1; inside(i) && dark(i); i++) {
+        counts[2]++;
+    }
+    if (!inside(i)) {
+        return false;
+    }
+    for (; inside(i) && !dark(i) && counts[3] < maxCount; i++) {
+        counts[3]++;
+    }
+    if (!inside(i) || counts[3] >= maxCount) {
+        return false;
+    }
+    for (; inside(i) && dark(i) && counts[4] < maxCount; i++) {
+        counts[4]++;
+    }
+    if (counts[4] >= maxCount) {
+        return false;
+    }
+
+    total = counts[0] + counts[1] + counts[2] + counts[3] + counts[4];
+    if (5 * std::abs(total - originalTotal) >= 2 * originalTotal || !finderRatio(counts)) {
+        return false;
+    }
+    // i wskazuje pierwszy piksel za ostatnim biegiem
+    center = static_cast<float>(i - counts[4] - counts[3]) - counts[2] / 2.0f;
+    return true;
+}
+
+struct Candidate {
+    float x = 0.0f;
+    float y = 0.0f;
+    float moduleSize = 0.0f;
+    int hits = 0;
+    bool used = false;
+};
+
+// Potwierdzenie wzorca znalezionego w wierszu: kolumna, potem znów wiersz
+// (ustala środek w obu osiach), a na końcu połączenie z bliskim kandydatem
+void confirmCandidate(const Binarized& image, const int counts[5], float centerX, int y,
+                      std::vector<Candidate>& candidates)
+{
+    const int rowTotal = counts[0] + counts[1] + counts[2] + counts[3] + counts[4];
+    const int x = static_cast<int>(centerX);
+    float offset = 0.0f;
+    int columnTotal = 0;
+    if (!crossCheck(image, x, y, 0, 1, counts[2], rowTotal, offset, columnTotal)) {
+        return;
+    }
+    const float centerY = y + offset;
+    int checkedTotal = 0;
+    if (!crossCheck(image, x, static_cast<int>(centerY), 1, 0, counts[2], rowTotal, offset, checkedTotal)) {
+        return;
+    }
+    const float refinedX = x + offset;
+    const float moduleSize = (checkedTotal + columnTotal) / 14.0f;
+
+    for (Candidate& candidate : candidates) {
+        if (std::fabs(candidate.x - refinedX) <= candidate.moduleSize &&
+            std::fabs(candidate.y - centerY) <= candidate.moduleSize &&
+            std::fabs(candidate.moduleSize - moduleSize) <= std::max(1.0f, candidate.moduleSize)) {
+            const float weight = static_cast<float>(candidate.hits);
+            candidate.x = (candidate.x * weight + refinedX) / (weight + 1);
+            candidate.y = (candidate.y * weight + centerY) / (weight + 1);
+            candidate.moduleSize = (candidate.moduleSize * weight + moduleSize) / (weight + 1);
+            candidate.hits++;
+            return;
+        }
+    }
+    candidates.push_back(Candidate{refinedX, centerY, moduleSize, 1, false});
+}
+
+// Ciemne piksele wiersza (0xFF) według progów bloków - 16 pikseli naraz
+void binarizeRow(const Binarized& image, int y, std::vector<uint8_t>& dark)
+{
+    const uint8_t* row = image.image.row(y);
+    const int width = image.image.width;
+    int x = 0;
+#ifdef QRCORE_FINDER_SSE2
+    // Bloki mają 32 piksele, więc każda szesnastka ma jeden próg
+    for (; x + 16 <= width; x += 16) {
+        const uint8_t threshold = image.thresholds.at(x, y);
+        __m128i mask = _mm_setzero_si128();
+        if (threshold > 0) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+            // p < t  <=>  min(p, t - 1) == p
+            const __m128i limit = _mm_set1_epi8(static_cast<char>(threshold - 1));
+            mask = _mm_cmpeq_epi8(_mm_min_epu8(pixels, limit), pixels);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dark.data() + x), mask);
+    }
+#endif
+    for (; x < width; x++) {
+        dark[x] = row[x] < image.thresholds.at(x, y) ? 0xFF : 0x00;
+    }
+}
+
+// Pozycje zmian koloru w wierszu (piksel x różni się od x - 1)
+void rowTransitions(const std::vector<uint8_t>& dark, int width, std::vector<int>& transitions)
+{
+    transitions.clear();
+    int x = 1;
+#ifdef QRCORE_FINDER_SSE2
+    for (; x + 16 <= width; x += 16) {
+        const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dark.data() + x));
+        const __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dark.data() + x - 1));
+        unsigned changed = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(current, previous))) ^ 0xFFFFu;
+        // Jednolite 16 pikseli (najczęstszy przypadek) kosztuje jedno porównanie
+        while (changed) {
+            int bit = 0;
+            while (!((changed >> bit) & 1u)) {
+                bit++;
+            }
+            transitions.push_back(x + bit);
+            changed &= changed - 1;
+        }
+    }
+#endif
+    for (; x < width; x++) {
+        if (dark[x] != dark[x - 1]) {
+            transitions.push_back(x);
+        }
+    }
+}
+
+std::vector<Candidate> findCandidates(const Binarized& image)
+{
+    std::vector<Candidate> candidates;
+    const int width = image.image.width;
+    const int height = image.image.height;
+    if (width < 21 || height < 21) {
+        return candidates;
+    }
+
+    // Co drugi wiersz dla Full HD - wzorzec o module 2 px nadal trafia w kilka wierszy
+    const int step = std::max(1, height / 540);
+    std::vector<uint8_t> dark(static_cast<size_t>(width));
+    std::vector<int> transitions;
+    std::vector<int> runStarts;
+
+    for (int y = step / 2; y < height; y += step) {
+        binarizeRow(image, y, dark);
+        rowTransitions(dark, width, transitions);
+
+        // Biegi: [runStarts[k], runStarts[k + 1]); kolory naprzemienne
+        runStarts.assign(1, 0);
+        runStarts.insert(runStarts.end(), transitions.begin(), transitions.end());
+        runStarts.push_back(width);
+        const bool firstDark = dark[0] != 0;
+        const int runs = static_cast<int>(runStarts.size()) - 1;
+
+        for (int k = 0; k + 5 <= runs; k++) {
+            // Pierwszy bieg piątki musi być ciemny
+            if (((k % 2 == 0) != firstDark)) {
+                continue;
+            }
+            int counts[5];
+            for (int i = 0; i < 5; i++) {
+                counts[i] = runStarts[k + i + 1] - runStarts[k + i];
+            }
+            if (finderRatio(counts)) {
+                const float centerX = runStarts[k + 2] + counts[2] / 2.0f;
+                confirmCandidate(image, counts, centerX, y, candidates);
+            }
+        }
+    }
+
+    // Wzorce potwierdzone w kilku wierszach są pewniejsze od pojedynczych trafień
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Candidate& a, const Candidate& b) { return a.hits > b.hits; });
+    const size_t confirmed = static_cast<size_t>(std::count_if(
+        candidates.begin(), candidates.end(), [](const Candidate& candidate) { return candidate.hits >= 2; }));
+    if (confirmed >= 3) {
+        candidates.resize(confirmed);
+    }
+    if (candidates.size() > kMaxCandidates) {
+        candidates.resize(kMaxCandidates);
+    }
+    return candidates;
+}
+
+struct Point {
+    double x = 0.0;
+    double y = 0.0;
+};
+
+// Homografia z czterech par punktów (u, v) -> (x, y); false dla układu zdegenerowanego
+bool solveHomography(const std::array<Point, 4>& from, const std::array<Point, 4>& to, std::array<double, 9>& h)
+{
+    double a[8][9];
+    for (int i = 0; i < 4; i++) {
+        const double u = from[i].x;
+        const double v = from[i].y;
+        const double x = to[i].x;
+        const double y = to[i].y;
+        const double rowX[9] = {u, v, 1, 0, 0, 0, -u * x, -v * x, x};
+        const double rowY[9] = {0, 0, 0, u, v, 1, -u * y, -v * y, y};
+        std::memcpy(a[2 * i], rowX, sizeof(rowX));
+        std::memcpy(a[2 * i + 1], rowY, sizeof(rowY));
+    }
+
+    // Eliminacja Gaussa z wyborem elementu głównego
+    for (int column = 0; column < 8; column++) {
+        int pivot = column;
+        for (int row = column + 1; row < 8; row++) {
+            if (std::fabs(a[row][column]) > std::fabs(a[pivot][column])) {
+                pivot = row;
+            }
+        }
+        if (std::fabs(a[pivot][column]) < 1e-12) {
+            return false;
+        }
+        if (pivot != column) {
+            for (int k = 0; k < 9; k++) {
+                std::swap(a[pivot][k], a[column][k]);
+            }
+        }
+        for (int row = 0; row < 8; row++) {
+            if (row == column) {
+                continue;
+            }
+            const double factor = a[row][column] / a[column][column];
+            for (int k = column; k < 9; k++) {
+                a[row][k] -= factor * a[column][k];
+            }
+        }
+    }
+    for (int i = 0; i < 8; i++) {
+        h[i] = a[i][8] / a[i][i];
+    }
+    h[8] = 1.0;
+    return true;
+}
+
+Point project(const std::array<double, 9>& h, double u, double v)
+{
+    const double w = h[6] * u + h[7] * v + h[8];
+    return Point{(h[0] * u + h[1] * v + h[2]) / w, (h[3] * u + h[4] * v + h[5]) / w};
+}
+
+// Wzorzec wyrównania (1:1:1 - ciemny środek, jasny pierścień, ciemna ramka)
+// w otoczeniu przewidywanego środka; ex, ey - wektory jednego modułu
+bool findAlignment(const Binarized& image, const Point& expected, const Point& ex, const Point& ey,
+                   float moduleSize, Point& found)
+{
+    static const int kRing[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+    auto score = [&](double x, double y) {
+        int matches = image.darkAt(static_cast<float>(x), static_cast<float>(y)) ? 1 : 0;
+        for (const auto& direction : kRing) {
+            const double ox = direction[0] * ex.x + direction[1] * ey.x;
+            const double oy = direction[0] * ex.y + direction[1] * ey.y;
+            matches += image.darkAt(static_cast<float>(x + ox), static_cast<float>(y + oy)) ? 0 : 1;
+            matches += image.darkAt(static_cast<float>(x + 2 * ox), static_cast<float>(y + 2 * oy)) ? 1 : 0;
+        }
+        return matches;
+    };
+
+    const int radius = std::max(2, static_cast<int>(4.0f * moduleSize));
+    const int step = std::max(1, static_cast<int>(moduleSize / 4.0f));
+    int best = 0;
+    double bestDistance = 0.0;
+    for (int dy = -radius; dy <= radius; dy += step) {
+        for (int dx = -radius; dx <= radius; dx += step) {
+            const double x = expected.x + dx;
+            const double y = expected.y + dy;
+            if (!image.inside(static_cast<int>(x), static_cast<int>(y))) {
+                continue;
+            }
+            const int matches = score(x, y);
+            const double distance = static_cast<double>(dx) * dx + static_cast<double>(dy) * dy;
+            if (matches > best || (matches == best && distance < bestDistance)) {
+                best = matches;
+                bestDistance = distance;
+                found = Point{x, y};
+            }
+        }
+    }
+    return best >= 16;
+}
+
+// Próbkowanie siatki symbolu danej wersji rozpiętej na trzech wzorcach
+bool decodeVersion(const Binarized& image, const Candidate& topLeft, const Candidate& topRight,
+                   const Candidate& bottomLeft, int version, DecodeResult& result)
+{
+    const int size = version * 4 + 17;
+    const double span = size - 7.0;
+    const Point tl{topLeft.x, topLeft.y};
+    const Point tr{topRight.x, topRight.y};
+    const Point bl{bottomLeft.x, bottomLeft.y};
+    const Point ex{(tr.x - tl.x) / span, (tr.y - tl.y) / span};
+    const Point ey{(bl.x - tl.x) / span, (bl.y - tl.y) / span};
+
+    std::array<Point, 4> from = {Point{3.5, 3.5}, Point{size - 3.5, 3.5}, Point{3.5, size - 3.5},
+                                 Point{size - 3.5, size - 3.5}};
+    std::array<Point, 4> to = {tl, tr, bl, Point{tr.x + bl.x - tl.x, tr.y + bl.y - tl.y}};
+
+    // Wzorzec wyrównania (wersje 2+) koryguje perspektywę czwartego narożnika
+    if (version >= 2) {
+        const double offset = size - 6.5 - 3.5;
+        const Point expected{tl.x + (ex.x + ey.x) * offset, tl.y + (ex.y + ey.y) * offset};
+        const float moduleSize = (topLeft.moduleSize + topRight.moduleSize + bottomLeft.moduleSize) / 3.0f;
+        Point alignment;
+        if (findAlignment(image, expected, ex, ey, moduleSize, alignment)) {
+            from[3] = Point{size - 6.5, size - 6.5};
+            to[3] = alignment;
+        }
+    }
+
+    std::array<double, 9> h;
+    if (!solveHomography(from, to, h)) {
+        return false;
+    }
+
+    QRMatrix grid(size, version);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            const Point point = project(h, x + 0.5, y + 0.5);
+            if (image.darkAt(static_cast<float>(point.x), static_cast<float>(point.y))) {
+                grid.setModule(x, y, true);
+            }
+        }
+    }
+
+    SymbolContent content;
+    if (!readSymbol(grid, content) || content.text.empty()) {
+        return false;
+    }
+
+    result = DecodeResult();
+    result.text = std::move(content.text);
+    result.structuredAppend = content.structuredAppend;
+    for (const Point& corner : {Point{0, 0}, Point{static_cast<double>(size), 0},
+                                Point{static_cast<double>(size), static_cast<double>(size)},
+                                Point{0, static_cast<double>(size)}}) {
+        const Point point = project(h, corner.x, corner.y);
+        result.corners.emplace_back(static_cast<float>(point.x), static_cast<float>(point.y));
+    }
+    return true;
+}
+
+struct Triple {
+    size_t topLeft = 0;
+    size_t topRight = 0;
+    size_t bottomLeft = 0;
+    double score = 0.0; // odchylenie od trójkąta prostokątnego równoramiennego
+    int version = 0;    // wersja z odległości wzorców
+};
+
+// Trójki wzorców mogące być narożnikami jednego symbolu, od najlepszej
+std::vector<Triple> findTriples(const std::vector<Candidate>& candidates)
+{
+    std::vector<Triple> triples;
+    const size_t count = candidates.size();
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = i + 1; j < count; j++) {
+            for (size_t k = j + 1; k < count; k++) {
+                const Candidate* points[3] = {&candidates[i], &candidates[j], &candidates[k]};
+                const float smallest = std::min({points[0]->moduleSize, points[1]->moduleSize, points[2]->moduleSize});
+                const float largest = std::max({points[0]->moduleSize, points[1]->moduleSize, points[2]->moduleSize});
+                if (largest > 1.7f * smallest) {
+                    continue;
+                }
+
+                // Wierzchołek kąta prostego leży naprzeciw najdłuższego boku
+                auto distance2 = [](const Candidate* a, const Candidate* b) {
+                    const double dx = a->x - b->x;
+                    const double dy = a->y - b->y;
+                    return dx * dx + dy * dy;
+                };
+                const double sides[3] = {distance2(points[1], points[2]), distance2(points[0], points[2]),
+                                         distance2(points[0], points[1])};
+                const int corner = static_cast<int>(std::max_element(sides, sides + 3) - sides);
+                const Candidate* vertex = points[corner];
+                const Candidate* a = points[(corner + 1) % 3];
+                const Candidate* b = points[(corner + 2) % 3];
+                const double legA = std::sqrt(distance2(vertex, a));
+                const double legB = std::sqrt(distance2(vertex, b));
+                const double hypotenuse2 = sides[corner];
+                if (legA < 1e-3 || legB < 1e-3 || std::max(legA, legB) > 2.0 * std::min(legA, legB)) {
+                    continue;
+                }
+                const double rightAngle = std::fabs(hypotenuse2 - legA * legA - legB * legB) / hypotenuse2;
+                if (rightAngle > 0.4) {
+                    continue;
+                }
+
+                // Odległość środków wzorców to bok symbolu minus 7 modułów. Biegi
+                // mierzone wzdłuż osi obrazu są w obróconym symbolu dłuższe
+                // o 1 / cos kąta obrotu, więc moduł jest korygowany kierunkiem boku.
+                const double tilt = std::max(std::fabs(a->x - vertex->x), std::fabs(a->y - vertex->y)) / legA;
+                const double moduleSize = (vertex->moduleSize + a->moduleSize + b->moduleSize) / 3.0 * tilt;
+                const double modules = (legA + legB) / 2.0 / moduleSize + 7.0;
+                const int version = static_cast<int>(std::lround((modules - 17.0) / 4.0));
+                if (version < qrspec::kMinVersion - 1 || version > qrspec::kMaxVersion + 1) {
+                    continue;
+                }
+
+                // Prawy górny tak, by (prawy - lewy) x (dolny - lewy) > 0 (oś y w dół)
+                const double cross = (a->x - vertex->x) * (b->y - vertex->y) - (a->y - vertex->y) * (b->x - vertex->x);
+                const size_t indexOf[3] = {i, j, k};
+                Triple triple;
+                triple.topLeft = indexOf[corner];
+                triple.topRight = cross > 0 ? indexOf[(corner + 1) % 3] : indexOf[(corner + 2) % 3];
+                triple.bottomLeft = cross > 0 ? indexOf[(corner + 2) % 3] : indexOf[(corner + 1) % 3];
+                triple.score = rightAngle + std::fabs(legA - legB) / std::max(legA, legB) + (largest / smallest - 1.0);
+                triple.version = std::min(std::max(version, qrspec::kMinVersion), qrspec::kMaxVersion);
+                triples.push_back(triple);
+            }
+        }
+    }
+
+    std::sort(triples.begin(), triples.end(), [](const Triple& a, const Triple& b) { return a.score < b.score; });
+    if (triples.size() > kMaxTriples) {
+        triples.resize(kMaxTriples);
+    }
+    return triples;
+}
+
+detail::GrayImage viewOf(const cv::Mat& gray)
+{
+    detail::GrayImage image;
+    if (!gray.empty() && gray.type() == CV_8UC1) {
+        image.data = gray.ptr<uint8_t>(0);
+        image.width = gray.cols;
+        image.height = gray.rows;
+        image.stride = gray.rows > 1 ? static_cast<size_t>(gray.ptr<uint8_t>(1) - gray.ptr<uint8_t>(0))
+                                     : static_cast<size_t>(gray.cols);
+    }
+    return image;
+}
+
+class NativeBackend : public DecoderBackend
+{
+public:
+    const char* name() const override { return "native"; }
+
+    std::vector<DecodeResult> decode(const cv::Mat& gray, bool multiple) override
+    {
+        return detectAndDecodeNative(gray, multiple);
+    }
+};
+
+} // namespace
+
+namespace detail {
+
+std::vector<FinderPattern> findFinderPatterns(const GrayImage& image)
+{
+    std::vector<FinderPattern> patterns;
+    if (!image.data) {
+        return patterns;
+    }
+    const Binarized binarized{image, ThresholdMap(image)};
+    for (const Candidate& candidate : findCandidates(binarized)) {
+        FinderPattern pattern;
+        pattern.center = cv::Point2f(candidate.x, candidate.y);
+        pattern.moduleSize = candidate.moduleSize;
+        pattern.hits = candidate.hits;
+        patterns.push_back(pattern);
+    }
+    return patterns;
+}
+
+std::vector<DecodeResult> detectAndDecodeNative(const GrayImage& image, bool multiple)
+{
+    std::vector<DecodeResult> results;
+    if (!image.data) {
+        return results;
+    }
+
+    const Binarized binarized{image, ThresholdMap(image)};
+    std::vector<Candidate> candidates = findCandidates(binarized);
+    if (candidates.size() < 3) {
+        return results;
+    }
+
+    for (const Triple& triple : findTriples(candidates)) {
+        Candidate& topLeft = candidates[triple.topLeft];
+        Candidate& topRight = candidates[triple.topRight];
+        Candidate& bottomLeft = candidates[triple.bottomLeft];
+        if (topLeft.used || topRight.used || bottomLeft.used) {
+            continue;
+        }
+
+        // Wersja z odległości wzorców bywa chybiona o jeden
+        DecodeResult result;
+        bool decoded = false;
+        for (int delta : {0, -1, 1}) {
+            const int version = triple.version + delta;
+            if (version >= qrspec::kMinVersion && version <= qrspec::kMaxVersion &&
+                decodeVersion(binarized, topLeft, topRight, bottomLeft, version, result)) {
+                decoded = true;
+                break;
+            }
+        }
+        if (!decoded) {
+            continue;
+        }
+
+        topLeft.used = topRight.used = bottomLeft.used = true;
+        results.push_back(std::move(result));
+        if (!multiple) {
+            break;
+        }
+    }
+    return results;
+}
+
+std::unique_ptr<DecoderBackend> createNativeBackend()
+{
+    return std::make_unique<NativeBackend>();
+}
+
+} // namespace detail
+
+std::vector<FinderPattern> findFinderPatterns(const cv::Mat& gray)
+{
+    return detail::findFinderPatterns(viewOf(gray));
+}
+
+std::vector<DecodeResult> detectAndDecodeNative(const cv::Mat& gray, bool multiple)
+{
+    return detail::detectAndDecodeNative(viewOf(gray), multiple);
+}
+
+} // namespace qrcore
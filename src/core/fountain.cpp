@@ -0,0 +1,405 @@
+#include "qrcore/fountain.h"
+
+#include "qrcore/archive_writer.h"
+#include "qrcore/qr_tables.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace qrcore {
+
+namespace {
+
+constexpr uint8_t kFormatVersion = 1;
+const char kFramePrefix[] = "QF:";
+constexpr size_t kFramePrefixLength = sizeof(kFramePrefix) - 1;
+
+// Alfabet Base45 (RFC 9285) = zestaw znaków trybu alfanumerycznego QR
+const char kBase45Charset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+
+// Parametry solitonu odpornego: c i prawdopodobieństwo porażki delta
+constexpr double kSolitonC = 0.05;
+constexpr double kSolitonDelta = 0.1;
+
+std::string base45Encode(const std::string& bytes)
+{
+    std::string text;
+    text.reserve(bytes.size() / 2 * 3 + 2);
+    for (size_t i = 0; i < bytes.size(); i += 2) {
+        if (i + 1 < bytes.size()) {
+            uint32_t value = static_cast<uint8_t>(bytes[i]) * 256u + static_cast<uint8_t>(bytes[i + 1]);
+            for (int k = 0; k < 3; k++, value /= 45) {
+                text += kBase45Charset[value % 45];
+            }
+        } else {
+            const uint32_t value = static_cast<uint8_t>(bytes[i]);
+            text += kBase45Charset[value % 45];
+            text += kBase45Charset[value / 45];
+        }
+    }
+    return text;
+}
+
+bool base45Decode(const char* text, size_t length, std::string& bytes)
+{
+    static const auto digits = [] {
+        std::array<int8_t, 256> table;
+        table.fill(-1);
+        for (int i = 0; i < 45; i++) {
+            table[static_cast<uint8_t>(kBase45Charset[i])] = static_cast<int8_t>(i);
+        }
+        return table;
+    }();
+
+    if (length % 3 == 1) {
+        return false;
+    }
+    bytes.clear();
+    bytes.reserve(length / 3 * 2 + 1);
+    for (size_t i = 0; i < length; i += 3) {
+        const size_t count = std::min<size_t>(3, length - i);
+        uint32_t value = 0;
+        for (size_t k = count; k-- > 0;) {
+            const int digit = digits[static_cast<uint8_t>(text[i + k])];
+            if (digit < 0) {
+                return false;
+            }
+            value = value * 45 + static_cast<uint32_t>(digit);
+        }
+        if (count == 3) {
+            if (value > 0xFFFF) {
+                return false;
+            }
+            bytes += static_cast<char>(value >> 8);
+            bytes += static_cast<char>(value & 0xFF);
+        } else {
+            if (value > 0xFF) {
+                return false;
+            }
+            bytes += static_cast<char>(value);
+        }
+    }
+    return true;
+}
+
+void putBigEndian(std::string& output, uint32_t value, int bytes)
+{
+    for (int i = bytes - 1; i >= 0; i--) {
+        output += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+uint32_t getBigEndian(const std::string& input, size_t offset, int bytes)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value = value << 8 | static_cast<uint8_t>(input[offset + i]);
+    }
+    return value;
+}
+
+// Generator xorshift64* - wynik zależy wyłącznie od ziarna, więc nadawca
+// i odbiorca na różnych platformach losują te same bloki
+class Random
+{
+public:
+    Random(uint32_t transferId, uint32_t seed, uint64_t stream)
+    {
+        // splitmix64 rozprasza sąsiednie ziarna
+        uint64_t z = (static_cast<uint64_t>(transferId) << 32 | seed) + stream * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        m_state = (z ^ (z >> 31)) | 1;
+    }
+
+    uint64_t next()
+    {
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 0x2545F4914F6CDD1Dull;
+    }
+
+    uint32_t below(uint32_t bound) { return static_cast<uint32_t>((next() >> 32) % bound); }
+    double unit() { return static_cast<double>(next() >> 11) / 9007199254740992.0; }
+
+private:
+    uint64_t m_state;
+};
+
+constexpr uint64_t kDegreeStream = 1;
+constexpr uint64_t kNeighborStream = 2;
+
+// Bloki ramki: dla numerów < K blok o tym numerze, dalej degree różnych
+// bloków z generatora ramki
+std::vector<uint32_t> frameNeighbors(uint32_t transferId, uint32_t seed, int degree, int blockCount)
+{
+    if (seed < static_cast<uint32_t>(blockCount)) {
+        return {seed};
+    }
+    Random random(transferId, seed, kNeighborStream);
+    std::vector<uint32_t> neighbors;
+    neighbors.reserve(static_cast<size_t>(degree));
+    while (static_cast<int>(neighbors.size()) < degree) {
+        const uint32_t block = random.below(static_cast<uint32_t>(blockCount));
+        if (std::find(neighbors.begin(), neighbors.end(), block) == neighbors.end()) {
+            neighbors.push_back(block);
+        }
+    }
+    return neighbors;
+}
+
+// Dystrybuanta solitonu odpornego (Luby, 2002) dla K bloków
+std::vector<double> robustSoliton(int blockCount)
+{
+    const double k = blockCount;
+    const double r = kSolitonC * std::log(k / kSolitonDelta) * std::sqrt(k);
+    const int spike = std::max(1, std::min(blockCount, static_cast<int>(std::lround(k / std::max(r, 1.0)))));
+
+    std::vector<double> weights(static_cast<size_t>(blockCount) + 1, 0.0);
+    double total = 0.0;
+    for (int d = 1; d <= blockCount; d++) {
+        double weight = d == 1 ? 1.0 / k : 1.0 / (static_cast<double>(d) * (d - 1));
+        if (d < spike) {
+            weight += r / (d * k);
+        } else if (d == spike) {
+            weight += r * std::log(std::max(r, 1.0) / kSolitonDelta) / k;
+        }
+        weights[d] = weight;
+        total += weight;
+    }
+
+    std::vector<double> cdf(weights.size(), 0.0);
+    for (int d = 1; d <= blockCount; d++) {
+        cdf[d] = cdf[d - 1] + weights[d] / total;
+    }
+    return cdf;
+}
+
+} // namespace
+
+FountainEncoder::FountainEncoder(const std::string& message, int blockSize)
+{
+    if (message.empty() || blockSize < 1 || blockSize > 0xFFFF || message.size() > kMaxFountainMessageSize ||
+        (message.size() + blockSize - 1) / blockSize > static_cast<size_t>(kMaxFountainBlocks)) {
+        return;
+    }
+    m_messageSize = message.size();
+    m_transferId = crc32(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    m_blockSize = blockSize;
+    m_blockCount = static_cast<int>((message.size() + blockSize - 1) / blockSize);
+    m_message = message;
+    m_message.resize(static_cast<size_t>(m_blockCount) * blockSize, '\0');
+}
+
+std::string FountainEncoder::frame(uint32_t seed) const
+{
+    if (isNull()) {
+        return std::string();
+    }
+
+    int degree = 1;
+    if (seed >= static_cast<uint32_t>(m_blockCount)) {
+        // Rozkład jest liczony raz na koder (K się nie zmienia)
+        static thread_local std::vector<double> cdf;
+        static thread_local int cdfBlocks = 0;
+        if (cdfBlocks != m_blockCount) {
+            cdf = robustSoliton(m_blockCount);
+            cdfBlocks = m_blockCount;
+        }
+        const double draw = Random(m_transferId, seed, kDegreeStream).unit();
+        degree = static_cast<int>(std::upper_bound(cdf.begin() + 1, cdf.end(), draw) - cdf.begin());
+        degree = std::min(std::max(degree, 1), m_blockCount);
+    }
+
+    std::string payload;
+    payload.reserve(kFountainHeaderSize + m_blockSize);
+    putBigEndian(payload, kFormatVersion, 1);
+    putBigEndian(payload, m_transferId, 4);
+    putBigEndian(payload, static_cast<uint32_t>(m_messageSize), 4);
+    putBigEndian(payload, static_cast<uint32_t>(m_blockSize), 2);
+    putBigEndian(payload, seed, 4);
+    putBigEndian(payload, static_cast<uint32_t>(degree), 2);
+
+    std::string data(static_cast<size_t>(m_blockSize), '\0');
+    for (uint32_t block : frameNeighbors(m_transferId, seed, degree, m_blockCount)) {
+        const char* source = m_message.data() + static_cast<size_t>(block) * m_blockSize;
+        for (int i = 0; i < m_blockSize; i++) {
+            data[i] ^= source[i];
+        }
+    }
+    payload += data;
+
+    return kFramePrefix + base45Encode(payload);
+}
+
+int FountainEncoder::blockSizeFor(int version, ErrorCorrection level)
+{
+    if (version < qrspec::kMinVersion || version > qrspec::kMaxVersion) {
+        return 0;
+    }
+    // Znaki alfanumeryczne: 11 bitów na parę, 6 na ostatni nieparzysty
+    const int bits = qrspec::kDataCapacityBits.bits[qrspec::levelIndex(level)][version] - 4 -
+                     qrspec::characterCountBits(SegmentMode::Alphanumeric, version);
+    const int characters = 2 * (bits / 11) + (bits % 11 >= 6 ? 1 : 0) - static_cast<int>(kFramePrefixLength);
+    // Base45: 3 znaki na 2 bajty, 2 znaki na ostatni nieparzysty bajt
+    const int bytes = 2 * (characters / 3) + (characters % 3 == 2 ? 1 : 0);
+    return std::max(0, std::min(bytes - kFountainHeaderSize, 0xFFFF));
+}
+
+FountainDecoder::FrameStatus FountainDecoder::addFrame(const std::string& text)
+{
+    std::string payload;
+    if (text.compare(0, kFramePrefixLength, kFramePrefix) != 0 ||
+        !base45Decode(text.data() + kFramePrefixLength, text.size() - kFramePrefixLength, payload) ||
+        payload.size() <= static_cast<size_t>(kFountainHeaderSize) || getBigEndian(payload, 0, 1) != kFormatVersion) {
+        return FrameStatus::NotFountain;
+    }
+
+    const uint32_t transferId = getBigEndian(payload, 1, 4);
+    const size_t messageSize = getBigEndian(payload, 5, 4);
+    const int blockSize = static_cast<int>(getBigEndian(payload, 9, 2));
+    const uint32_t seed = getBigEndian(payload, 11, 4);
+    const int degree = static_cast<int>(getBigEndian(payload, 15, 2));
+    if (messageSize == 0 || messageSize > kMaxFountainMessageSize || blockSize == 0 ||
+        payload.size() != static_cast<size_t>(kFountainHeaderSize + blockSize) ||
+        (messageSize + blockSize - 1) / blockSize > static_cast<size_t>(kMaxFountainBlocks)) {
+        return FrameStatus::NotFountain;
+    }
+    const int blockCount = static_cast<int>((messageSize + blockSize - 1) / blockSize);
+    if (degree < 1 || degree > blockCount || (seed < static_cast<uint32_t>(blockCount) && degree != 1)) {
+        return FrameStatus::NotFountain;
+    }
+
+    if (!isStarted()) {
+        m_transferId = transferId;
+        m_messageSize = messageSize;
+        m_blockSize = blockSize;
+        m_blockCount = blockCount;
+        m_blocks.assign(static_cast<size_t>(blockCount), std::string());
+        m_waiting.assign(static_cast<size_t>(blockCount), std::vector<size_t>());
+    } else if (transferId != m_transferId || messageSize != m_messageSize || blockSize != m_blockSize) {
+        return FrameStatus::OtherTransfer;
+    }
+
+    const auto position = std::lower_bound(m_seen.begin(), m_seen.end(), seed);
+    if (position != m_seen.end() && *position == seed) {
+        return FrameStatus::Duplicate;
+    }
+    m_seen.insert(position, seed);
+    if (isComplete()) {
+        return FrameStatus::Accepted;
+    }
+
+    // Bloki już znane są od razu odejmowane (XOR) od danych ramki
+    Pending pending;
+    pending.data = payload.substr(kFountainHeaderSize);
+    for (uint32_t block : frameNeighbors(transferId, seed, degree, blockCount)) {
+        const std::string& known = m_blocks[block];
+        if (known.empty()) {
+            pending.neighbors.push_back(block);
+        } else {
+            for (int i = 0; i < m_blockSize; i++) {
+                pending.data[i] ^= known[i];
+            }
+        }
+    }
+
+    if (pending.neighbors.size() == 1) {
+        resolve(pending.neighbors.front(), std::move(pending.data));
+    } else if (pending.neighbors.size() > 1) {
+        for (uint32_t block : pending.neighbors) {
+            m_waiting[block].push_back(m_pending.size());
+        }
+        m_pending.push_back(std::move(pending));
+    }
+    return FrameStatus::Accepted;
+}
+
+void FountainDecoder::resolve(uint32_t block, std::string data)
+{
+    // Dekodowanie przez "obieranie": każdy odtworzony blok zmniejsza stopień
+    // ramek, które go zawierają; ramki stopnia 1 odtwarzają kolejne bloki
+    std::vector<std::pair<uint32_t, std::string>> ready;
+    ready.emplace_back(block, std::move(data));
+    while (!ready.empty()) {
+        const uint32_t current = ready.back().first;
+        std::string value = std::move(ready.back().second);
+        ready.pop_back();
+        if (!m_blocks[current].empty()) {
+            continue;
+        }
+        m_blocks[current] = std::move(value);
+        m_resolved++;
+
+        const std::string& known = m_blocks[current];
+        for (size_t index : m_waiting[current]) {
+            Pending& pending = m_pending[index];
+            if (pending.done) {
+                continue;
+            }
+            for (int i = 0; i < m_blockSize; i++) {
+                pending.data[i] ^= known[i];
+            }
+            pending.neighbors.erase(std::find(pending.neighbors.begin(), pending.neighbors.end(), current));
+            if (pending.neighbors.size() == 1) {
+                ready.emplace_back(pending.neighbors.front(), std::move(pending.data));
+                pending.done = true;
+                pending.neighbors.clear();
+                pending.data.clear();
+            }
+        }
+        std::vector<size_t>().swap(m_waiting[current]);
+    }
+}
+
+bool FountainDecoder::message(std::string& output) const
+{
+    if (!isComplete()) {
+        return false;
+    }
+    std::string assembled;
+    assembled.reserve(static_cast<size_t>(m_blockCount) * m_blockSize);
+    for (const std::string& block : m_blocks) {
+        assembled += block;
+    }
+    assembled.resize(m_messageSize);
+    if (crc32(reinterpret_cast<const uint8_t*>(assembled.data()), assembled.size()) != m_transferId) {
+        return false;
+    }
+    output = std::move(assembled);
+    return true;
+}
+
+void FountainDecoder::reset()
+{
+    *this = FountainDecoder();
+}
+
+std::string packTransferFile(const std::string& name, const std::string& contents)
+{
+    const std::string stored = name.substr(0, 0xFFFF);
+    std::string message;
+    message.reserve(2 + stored.size() + contents.size());
+    putBigEndian(message, static_cast<uint32_t>(stored.size()), 2);
+    message += stored;
+    message += contents;
+    return message;
+}
+
+bool unpackTransferFile(const std::string& message, std::string& name, std::string& contents)
+{
+    if (message.size() < 2) {
+        return false;
+    }
+    const size_t nameLength = getBigEndian(message, 0, 2);
+    if (message.size() < 2 + nameLength) {
+        return false;
+    }
+    name = message.substr(2, nameLength);
+    contents = message.substr(2 + nameLength);
+    return true;
+}
+
+} // namespace qrcore
@@ -0,0 +1,72 @@
+#include "qrcore/image_bridge.h"
+#include "qrcore/pyramid_decoder.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <QtCore/QSysInfo>
+
+namespace qrcore {
+
+cv::Mat wrapImage(const QImage& image)
+{
+    if (image.isNull()) {
+        return cv::Mat();
+    }
+
+    // constBits() nie odłącza współdzielonych danych QImage
+    void* data = const_cast<uchar*>(image.constBits());
+    const size_t step = static_cast<size_t>(image.bytesPerLine());
+
+    switch (image.format()) {
+        case QImage::Format_RGB32:
+        case QImage::Format_ARGB32:
+        case QImage::Format_ARGB32_Premultiplied:
+            // 0xAARRGGBB w pamięci little-endian to bajty B, G, R, A
+            if (QSysInfo::ByteOrder != QSysInfo::LittleEndian) {
+                return cv::Mat();
+            }
+            return cv::Mat(image.height(), image.width(), CV_8UC4, data, step);
+        case QImage::Format_Grayscale8:
+            return cv::Mat(image.height(), image.width(), CV_8UC1, data, step);
+        default:
+            return cv::Mat();
+    }
+}
+
+cv::Mat grayFromImage(const QImage& image)
+{
+    cv::Mat view = wrapImage(image);
+    if (view.empty()) {
+        if (image.isNull()) {
+            return cv::Mat();
+        }
+        // Rzadki przypadek (np. obraz 16-bitowy) - konwersja przez Qt
+        return grayFromImage(image.convertToFormat(QImage::Format_Grayscale8)).clone();
+    }
+
+    if (view.channels() == 1) {
+        return view;
+    }
+
+    cv::Mat gray;
+    cv::cvtColor(view, gray, cv::COLOR_BGRA2GRAY);
+    return gray;
+}
+
+std::vector<std::vector<DecodeResult>> decodeImages(const std::vector<QImage>& images)
+{
+    std::vector<std::vector<DecodeResult>> results(images.size());
+
+    cv::parallel_for_(cv::Range(0, static_cast<int>(images.size())), [&](const cv::Range& range) {
+        for (int i = range.start; i < range.end; i++) {
+            const cv::Mat gray = grayFromImage(images[i]);
+            if (!gray.empty()) {
+                results[i] = decodePyramid(gray);
+            }
+        }
+    });
+
+    return results;
+}
+
+} // namespace qrcore
@@ -0,0 +1,190 @@
+#include "qrcore/multi_decoder.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace qrcore {
+
+namespace {
+
+// Podział obrazu na kafelki z zakładką (ostatni kafelek dosunięty do krawędzi)
+std::vector<cv::Rect> makeTiles(const cv::Size& size, int tileSize, int overlap)
+{
+    std::vector<cv::Rect> tiles;
+    if (size.width <= tileSize && size.height <= tileSize) {
+        tiles.emplace_back(0, 0, size.width, size.height);
+        return tiles;
+    }
+
+    const int step = std::max(1, tileSize - overlap);
+    auto starts = [&](int length) {
+        std::vector<int> result;
+        if (length <= tileSize) {
+            result.push_back(0);
+            return result;
+        }
+        for (int start = 0; ; start += step) {
+            if (start + tileSize >= length) {
+                result.push_back(length - tileSize);
+                break;
+            }
+            result.push_back(start);
+        }
+        return result;
+    };
+
+    for (int y : starts(size.height)) {
+        for (int x : starts(size.width)) {
+            tiles.emplace_back(x, y, std::min(tileSize, size.width), std::min(tileSize, size.height));
+        }
+    }
+    return tiles;
+}
+
+cv::Point2f centerOf(const std::vector<cv::Point2f>& corners)
+{
+    cv::Point2f center(0.0f, 0.0f);
+    for (const cv::Point2f& point : corners) {
+        center += point;
+    }
+    return corners.empty() ? center : center * (1.0f / corners.size());
+}
+
+// Wyszukiwanie wszystkich kodów w jednym kafelku (kaskada backendów)
+void decodeTile(const cv::Mat& gray, const cv::Rect& tile, std::vector<DecodeResult>& output)
+{
+    DecoderCascade cascade;
+    for (DecodeResult& result : cascade.decode(gray(tile), true)) {
+        for (cv::Point2f& point : result.corners) {
+            point.x += tile.x;
+            point.y += tile.y;
+        }
+        output.push_back(std::move(result));
+    }
+}
+
+} // namespace
+
+std::vector<DecodeResult> mergeDuplicates(std::vector<DecodeResult> results)
+{
+    // Większe wielokąty najpierw - przy duplikacie zostaje pełniejszy odczyt
+    std::sort(results.begin(), results.end(), [](const DecodeResult& a, const DecodeResult& b) {
+        return std::fabs(cv::contourArea(a.corners)) > std::fabs(cv::contourArea(b.corners));
+    });
+
+    std::vector<DecodeResult> unique;
+    for (DecodeResult& candidate : results) {
+        const cv::Point2f center = centerOf(candidate.corners);
+        const cv::Rect bounds = cv::boundingRect(candidate.corners);
+
+        bool duplicate = false;
+        for (const DecodeResult& kept : unique) {
+            if (kept.text != candidate.text) {
+                continue;
+            }
+            // Ten sam kod: środek kandydata leży wewnątrz zachowanego wielokąta
+            // albo oba środki są bliżej niż połowa boku symbolu
+            const cv::Point2f keptCenter = centerOf(kept.corners);
+            const float limit = 0.5f * std::max(bounds.width, bounds.height);
+            if (cv::pointPolygonTest(kept.corners, center, false) >= 0 ||
+                cv::norm(center - keptCenter) < limit) {
+                duplicate = true;
+                break;
+            }
+        }
+
+        if (!duplicate) {
+            unique.push_back(std::move(candidate));
+        }
+    }
+
+    // Kolejność czytania: wierszami od lewego górnego rogu. Wiersze są
+    // przydzielane w jednym przebiegu według y (nowy wiersz poniżej połowy
+    // wysokości pierwszego kodu wiersza), potem sortowanie (wiersz, x) -
+    // "blisko w pionie" nie jest przechodnie, więc nie może być komparatorem
+    struct Placement {
+        cv::Rect bounds;
+        int row = 0;
+        size_t index = 0;
+    };
+    std::vector<Placement> placements(unique.size());
+    for (size_t i = 0; i < unique.size(); i++) {
+        placements[i].bounds = cv::boundingRect(unique[i].corners);
+        placements[i].index = i;
+    }
+    std::sort(placements.begin(), placements.end(), [](const Placement& a, const Placement& b) {
+        return a.bounds.y != b.bounds.y ? a.bounds.y < b.bounds.y : a.bounds.x < b.bounds.x;
+    });
+
+    int row = -1;
+    int rowLimit = 0;
+    for (Placement& placement : placements) {
+        if (row < 0 || placement.bounds.y > rowLimit) {
+            row++;
+            rowLimit = placement.bounds.y + placement.bounds.height / 2;
+        }
+        placement.row = row;
+    }
+    std::sort(placements.begin(), placements.end(), [](const Placement& a, const Placement& b) {
+        return a.row != b.row ? a.row < b.row : a.bounds.x < b.bounds.x;
+    });
+
+    std::vector<DecodeResult> ordered;
+    ordered.reserve(unique.size());
+    for (const Placement& placement : placements) {
+        ordered.push_back(std::move(unique[placement.index]));
+    }
+    return ordered;
+}
+
+std::vector<DecodeResult> decodeMulti(const cv::Mat& image, const MultiDecodeOptions& options)
+{
+    if (image.empty()) {
+        return {};
+    }
+
+    try {
+        // Konwersja do skali szarości raz dla wszystkich kafelków
+        cv::Mat gray;
+        if (image.channels() == 3) {
+            cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+        } else if (image.channels() == 4) {
+            cv::cvtColor(image, gray, cv::COLOR_BGRA2GRAY);
+        } else {
+            gray = image;
+        }
+
+        const std::vector<cv::Rect> tiles = makeTiles(gray.size(), std::max(64, options.tileSize),
+                                                      std::max(0, options.overlap));
+        std::vector<std::vector<DecodeResult>> perTile(tiles.size());
+
+        auto worker = [&](const cv::Range& range) {
+            for (int i = range.start; i < range.end; i++) {
+                decodeTile(gray, tiles[i], perTile[i]);
+            }
+        };
+
+        if (options.parallel && tiles.size() > 1) {
+            cv::parallel_for_(cv::Range(0, static_cast<int>(tiles.size())), worker);
+        } else {
+            worker(cv::Range(0, static_cast<int>(tiles.size())));
+        }
+
+        std::vector<DecodeResult> results;
+        for (std::vector<DecodeResult>& tileResults : perTile) {
+            std::move(tileResults.begin(), tileResults.end(), std::back_inserter(results));
+        }
+        return mergeDuplicates(std::move(results));
+
+    } catch (const std::exception& e) {
+        qWarning() << "Błąd dekodowania wielu kodów QR:" << e.what();
+        return {};
+    }
+}
+
+} // namespace qrcore
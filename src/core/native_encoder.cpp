@@ -0,0 +1,664 @@
+#include "encoder_internal.h"
+
+#include "qrcore/qr_tables.h"
+#include "qrcore/reed_solomon.h"
+
+#include <opencv2/core.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace qrcore {
+namespace detail {
+
+namespace {
+
+// Wagi kar maski (ISO/IEC 18004, 7.8.3)
+constexpr int kPenaltyN1 = 3;
+constexpr int kPenaltyN2 = 3;
+constexpr int kPenaltyN3 = 40;
+constexpr int kPenaltyN4 = 10;
+
+const char kAlphanumericCharset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+
+int alphanumericValue(char c)
+{
+    const char* position = std::strchr(kAlphanumericCharset, c);
+    return (c != '\0' && position) ? static_cast<int>(position - kAlphanumericCharset) : -1;
+}
+
+uint32_t modeIndicator(SegmentMode mode)
+{
+    switch (mode) {
+        case SegmentMode::Numeric:      return 0x1;
+        case SegmentMode::Alphanumeric: return 0x2;
+        case SegmentMode::Byte:         return 0x4;
+        case SegmentMode::Kanji:        return 0x8;
+        case SegmentMode::StructuredAppend: return 0x3;
+    }
+    return 0;
+}
+
+// Bity treści segmentu (bez wskaźnika trybu i licznika); false dla
+// znaków spoza trybu
+bool appendSegmentData(const Segment& segment, BitBuffer* buffer, long& bits)
+{
+    const std::string& data = segment.data;
+    switch (segment.mode) {
+        case SegmentMode::Numeric:
+            for (size_t i = 0; i < data.size(); i += 3) {
+                const size_t count = std::min<size_t>(3, data.size() - i);
+                uint32_t value = 0;
+                for (size_t j = 0; j < count; j++) {
+                    const char c = data[i + j];
+                    if (c < '0' || c > '9') {
+                        return false;
+                    }
+                    value = value * 10 + static_cast<uint32_t>(c - '0');
+                }
+                const int width = static_cast<int>(count) * 3 + 1;
+                if (buffer) {
+                    buffer->append(value, width);
+                }
+                bits += width;
+            }
+            return true;
+
+        case SegmentMode::Alphanumeric:
+            for (size_t i = 0; i < data.size(); i += 2) {
+                const int first = alphanumericValue(data[i]);
+                const int second = i + 1 < data.size() ? alphanumericValue(data[i + 1]) : 0;
+                if (first < 0 || second < 0) {
+                    return false;
+                }
+                const int width = i + 1 < data.size() ? 11 : 6;
+                if (buffer) {
+                    buffer->append(i + 1 < data.size() ? static_cast<uint32_t>(first * 45 + second)
+                                                       : static_cast<uint32_t>(first), width);
+                }
+                bits += width;
+            }
+            return true;
+
+        case SegmentMode::Byte:
+            if (buffer) {
+                for (unsigned char c : data) {
+                    buffer->append(c, 8);
+                }
+            }
+            bits += static_cast<long>(data.size()) * 8;
+            return true;
+
+        case SegmentMode::Kanji:
+            if (data.size() % 2 != 0) {
+                return false;
+            }
+            for (size_t i = 0; i < data.size(); i += 2) {
+                // Kod Shift JIS -> 13 bitów (ISO/IEC 18004, 7.4.6)
+                uint32_t code = static_cast<uint32_t>(static_cast<unsigned char>(data[i])) << 8 |
+                                static_cast<unsigned char>(data[i + 1]);
+                if (code >= 0x8140 && code <= 0x9FFC) {
+                    code -= 0x8140;
+                } else if (code >= 0xE040 && code <= 0xEBBF) {
+                    code -= 0xC140;
+                } else {
+                    return false;
+                }
+                if (buffer) {
+                    buffer->append((code >> 8) * 0xC0 + (code & 0xFF), 13);
+                }
+                bits += 13;
+            }
+            return true;
+
+        case SegmentMode::StructuredAppend:
+            // Nagłówek nie ma licznika znaków: numer symbolu, liczba symboli,
+            // parzystość (ISO/IEC 18004, 8.2)
+            if (data.size() == 3) {
+                const int total = static_cast<unsigned char>(data[0]);
+                const int number = static_cast<unsigned char>(data[1]);
+                if (total < 1 || total > 16 || number < 1 || number > total) {
+                    return false;
+                }
+                if (buffer) {
+                    buffer->append(static_cast<uint32_t>(number - 1), 4);
+                    buffer->append(static_cast<uint32_t>(total - 1), 4);
+                    buffer->append(static_cast<unsigned char>(data[2]), 8);
+                }
+                bits += 16;
+                return true;
+            }
+            return false;
+    }
+    return false;
+}
+
+bool appendSegments(const std::vector<Segment>& segments, int version, BitBuffer* buffer, long& bits)
+{
+    bits = 0;
+    for (const Segment& segment : segments) {
+        const int countBits = qrspec::characterCountBits(segment.mode, version);
+        const int count = segmentCharacterCount(segment);
+        if (countBits > 0 && count >= (1 << countBits)) {
+            return false;
+        }
+        if (buffer) {
+            buffer->append(modeIndicator(segment.mode), 4);
+            if (countBits > 0) {
+                buffer->append(static_cast<uint32_t>(count), countBits);
+            }
+        }
+        bits += 4 + countBits;
+        if (!appendSegmentData(segment, buffer, bits)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---- szablon symbolu ----
+
+void setFunction(SymbolLayout& layout, int x, int y, bool dark)
+{
+    layout.modules[static_cast<size_t>(y) * layout.size + x] =
+        SymbolLayout::Function | (dark ? SymbolLayout::Dark : 0);
+}
+
+void drawFinder(SymbolLayout& layout, int centerX, int centerY)
+{
+    for (int dy = -4; dy <= 4; dy++) {
+        for (int dx = -4; dx <= 4; dx++) {
+            const int x = centerX + dx;
+            const int y = centerY + dy;
+            if (x < 0 || y < 0 || x >= layout.size || y >= layout.size) {
+                continue;
+            }
+            const int distance = std::max(std::abs(dx), std::abs(dy));
+            setFunction(layout, x, y, distance != 2 && distance != 4);
+        }
+    }
+}
+
+std::unique_ptr<SymbolLayout> createLayout(int version)
+{
+    auto layout = std::make_unique<SymbolLayout>();
+    layout->version = version;
+    layout->size = qrspec::symbolSize(version);
+    const int size = layout->size;
+    layout->modules.assign(static_cast<size_t>(size) * size, 0);
+
+    // Wzorce pomiaru czasu
+    for (int i = 0; i < size; i++) {
+        setFunction(*layout, 6, i, i % 2 == 0);
+        setFunction(*layout, i, 6, i % 2 == 0);
+    }
+
+    // Wzorce pozycjonujące z separatorami
+    drawFinder(*layout, 3, 3);
+    drawFinder(*layout, size - 4, 3);
+    drawFinder(*layout, 3, size - 4);
+
+    // Wzorce wyrównania (poza narożnikami zajętymi przez wzorce pozycjonujące)
+    const qrspec::AlignmentPositions alignment = qrspec::alignmentPositions(version);
+    for (int i = 0; i < alignment.count; i++) {
+        for (int j = 0; j < alignment.count; j++) {
+            if ((i == 0 && j == 0) || (i == 0 && j == alignment.count - 1) || (i == alignment.count - 1 && j == 0)) {
+                continue;
+            }
+            for (int dy = -2; dy <= 2; dy++) {
+                for (int dx = -2; dx <= 2; dx++) {
+                    setFunction(*layout, alignment.positions[i] + dx, alignment.positions[j] + dy,
+                                std::max(std::abs(dx), std::abs(dy)) != 1);
+                }
+            }
+        }
+    }
+
+    // Obszary formatu (wypełniane przy nakładaniu maski) i stały ciemny moduł
+    for (int i = 0; i < 9; i++) {
+        if (i != 6) {
+            setFunction(*layout, 8, i, false);
+            setFunction(*layout, i, 8, false);
+        }
+    }
+    for (int i = 0; i < 8; i++) {
+        setFunction(*layout, size - 1 - i, 8, false);
+        setFunction(*layout, 8, size - 1 - i, false);
+    }
+    setFunction(*layout, 8, size - 8, true);
+
+    // Informacja o wersji (dwie kopie 6x3)
+    if (version >= 7) {
+        const uint32_t bits = qrspec::versionBits(version);
+        for (int i = 0; i < 18; i++) {
+            const bool dark = (bits >> i) & 1;
+            const int a = size - 11 + i % 3;
+            const int b = i / 3;
+            setFunction(*layout, a, b, dark);
+            setFunction(*layout, b, a, dark);
+        }
+    }
+
+    // Kolejność modułów danych: pary kolumn od prawej, naprzemiennie w górę i w dół
+    layout->dataOrder.reserve(qrspec::rawDataModules(version));
+    for (int right = size - 1; right >= 1; right -= 2) {
+        if (right == 6) {
+            right = 5;
+        }
+        const bool upward = ((right + 1) & 2) == 0;
+        for (int vertical = 0; vertical < size; vertical++) {
+            const int y = upward ? size - 1 - vertical : vertical;
+            for (int j = 0; j < 2; j++) {
+                const int x = right - j;
+                const size_t index = static_cast<size_t>(y) * size + x;
+                if (!(layout->modules[index] & SymbolLayout::Function)) {
+                    layout->dataOrder.push_back(static_cast<uint32_t>(index));
+                }
+            }
+        }
+    }
+    // Wzorce funkcyjne i maski w postaci bitowej (XOR całych słów przy ocenie masek)
+    layout->functionPattern = QRMatrix(size, version);
+    for (int m = 0; m < 8; m++) {
+        layout->masks[m] = QRMatrix(size, version);
+    }
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            const uint8_t module = layout->modules[static_cast<size_t>(y) * size + x];
+            if (module & SymbolLayout::Function) {
+                layout->functionPattern.setModule(x, y, module & SymbolLayout::Dark);
+                continue;
+            }
+            for (int m = 0; m < 8; m++) {
+                layout->masks[m].setModule(x, y, maskBit(m, x, y));
+            }
+        }
+    }
+    for (int m = 0; m < 8; m++) {
+        layout->maskColumns[m] = transposed(layout->masks[m]);
+    }
+    return layout;
+}
+
+// Pozycje obu kopii słowa formatu; visit(x, y, bit)
+template <typename Visit>
+void forEachFormatModule(int size, Visit visit)
+{
+    // Pierwsza kopia wokół lewego górnego wzorca pozycjonującego
+    for (int i = 0; i <= 5; i++) {
+        visit(8, i, i);
+    }
+    visit(8, 7, 6);
+    visit(8, 8, 7);
+    visit(7, 8, 8);
+    for (int i = 9; i < 15; i++) {
+        visit(14 - i, 8, i);
+    }
+
+    // Druga kopia rozdzielona między pozostałe wzorce
+    for (int i = 0; i < 8; i++) {
+        visit(size - 1 - i, 8, i);
+    }
+    for (int i = 8; i < 15; i++) {
+        visit(8, size - 15 + i, i);
+    }
+}
+
+// ---- kara maski na wierszach bitowych ----
+
+// Pozycja pierwszego modułu >= x o kolorze różnym od dark (lub size)
+inline int nextChange(const uint64_t* row, int x, int size, bool dark)
+{
+    int wordIndex = x >> 6;
+    const int lastWord = (size - 1) >> 6;
+    uint64_t word = (dark ? ~row[wordIndex] : row[wordIndex]) & (~uint64_t(0) << (x & 63));
+    while (word == 0) {
+        if (++wordIndex > lastWord) {
+            return size;
+        }
+        word = dark ? ~row[wordIndex] : row[wordIndex];
+    }
+    const int position = (wordIndex << 6) + __builtin_ctzll(word);
+    return position < size ? position : size;
+}
+
+// N1 i N3 dla jednej linii. Długości ciągów jak w libqrencode: indeksy
+// nieparzyste to ciągi ciemne (runs[0] = -1, gdy linia zaczyna się od ciemnego),
+// a obszar poza symbolem traktowany jest jak jasny.
+int penaltyN1N3(const uint64_t* row, int size, int* runs)
+{
+    int length = 0;
+    if (row[0] & 1) {
+        runs[length++] = -1;
+    }
+
+    // Granice ciągów z maski zmian koloru (bit x: moduł x różni się od x-1)
+    const int words = (size + 63) >> 6;
+    int start = 0;
+    uint64_t carry = 0;
+    for (int w = 0; w < words; w++) {
+        uint64_t changes = row[w] ^ ((row[w] << 1) | carry);
+        carry = row[w] >> 63;
+        if (w == 0) {
+            changes &= ~uint64_t(1);
+        }
+        while (changes) {
+            const int position = (w << 6) + __builtin_ctzll(changes);
+            if (position >= size) {
+                break;
+            }
+            runs[length++] = position - start;
+            start = position;
+            changes &= changes - 1;
+        }
+    }
+    runs[length++] = size - start;
+
+    int penalty = 0;
+    for (int i = 0; i < length; i++) {
+        if (runs[i] >= 5) {
+            penalty += kPenaltyN1 + (runs[i] - 5);
+        }
+        if ((i & 1) && i >= 3 && i < length - 2 && runs[i] % 3 == 0) {
+            const int unit = runs[i] / 3;
+            if (runs[i - 2] == unit && runs[i - 1] == unit && runs[i + 1] == unit && runs[i + 2] == unit) {
+                if (i == 3 || runs[i - 3] >= 4 * unit) {
+                    penalty += kPenaltyN3;
+                } else if (i + 4 >= length || runs[i + 3] >= 4 * unit) {
+                    penalty += kPenaltyN3;
+                }
+            }
+        }
+    }
+    return penalty;
+}
+
+} // namespace
+
+void BitBuffer::append(uint32_t value, int bits)
+{
+    for (int i = bits - 1; i >= 0; i--) {
+        if ((m_bits & 7) == 0) {
+            m_bytes.push_back(0);
+        }
+        if ((value >> i) & 1) {
+            m_bytes.back() |= uint8_t(0x80 >> (m_bits & 7));
+        }
+        m_bits++;
+    }
+}
+
+QRMatrix transposed(const QRMatrix& matrix)
+{
+    const int size = matrix.size();
+    QRMatrix result(size, matrix.version());
+    for (int y = 0; y < size; y++) {
+        const uint64_t* row = matrix.row(y);
+        for (int x = nextChange(row, 0, size, false); x < size; x = nextChange(row, x + 1, size, false)) {
+            result.setModule(y, x, true);
+            if (x + 1 >= size) {
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+int segmentCharacterCount(const Segment& segment)
+{
+    const int bytes = static_cast<int>(segment.data.size());
+    return segment.mode == SegmentMode::Kanji ? bytes / 2 : bytes;
+}
+
+long segmentsBitLength(const std::vector<Segment>& segments, int version)
+{
+    long bits = 0;
+    return appendSegments(segments, version, nullptr, bits) ? bits : -1;
+}
+
+int chooseVersion(const std::vector<Segment>& segments, ErrorCorrection level, int minVersion)
+{
+    for (int version = std::max(minVersion, qrspec::kMinVersion); version <= qrspec::kMaxVersion; version++) {
+        const long bits = segmentsBitLength(segments, version);
+        if (bits >= 0 && bits <= qrspec::dataCodewords(version, level) * 8L) {
+            return version;
+        }
+    }
+    return 0;
+}
+
+std::vector<uint8_t> makeDataCodewords(const std::vector<Segment>& segments, int version, ErrorCorrection level)
+{
+    const size_t capacityBits = static_cast<size_t>(qrspec::dataCodewords(version, level)) * 8;
+    BitBuffer buffer;
+    long bits = 0;
+    if (!appendSegments(segments, version, &buffer, bits) || buffer.size() > capacityBits) {
+        return {};
+    }
+
+    // Terminator (do 4 zer), dopełnienie do bajtu, bajty wypełniające
+    buffer.append(0, static_cast<int>(std::min<size_t>(4, capacityBits - buffer.size())));
+    buffer.append(0, static_cast<int>((8 - buffer.size() % 8) % 8));
+    std::vector<uint8_t> codewords = buffer.bytes();
+    for (uint8_t pad = 0xEC; codewords.size() * 8 < capacityBits; pad ^= 0xEC ^ 0x11) {
+        codewords.push_back(pad);
+    }
+    return codewords;
+}
+
+std::vector<uint8_t> interleaveCodewords(const std::vector<uint8_t>& data, int version, ErrorCorrection level)
+{
+    const int levelIndex = qrspec::levelIndex(level);
+    const int blocks = qrspec::kEcBlocks[levelIndex][version];
+    const int ecLength = qrspec::kEcCodewordsPerBlock[levelIndex][version];
+    const int total = qrspec::totalCodewords(version);
+    const int shortBlocks = blocks - total % blocks;
+    const int shortDataLength = total / blocks - ecLength;
+
+    // Bloki krótkie są pierwsze, długie mają jedno słowo danych więcej
+    std::vector<uint8_t> ec(static_cast<size_t>(blocks) * ecLength);
+    std::vector<int> offsets(blocks + 1, 0);
+    for (int b = 0; b < blocks; b++) {
+        const int length = shortDataLength + (b >= shortBlocks ? 1 : 0);
+        offsets[b + 1] = offsets[b] + length;
+        rsEncode(data.data() + offsets[b], static_cast<size_t>(length), ecLength, ec.data() + b * ecLength);
+    }
+
+    std::vector<uint8_t> result;
+    result.reserve(total);
+    for (int i = 0; i <= shortDataLength; i++) {
+        for (int b = 0; b < blocks; b++) {
+            if (i < offsets[b + 1] - offsets[b]) {
+                result.push_back(data[offsets[b] + i]);
+            }
+        }
+    }
+    for (int i = 0; i < ecLength; i++) {
+        for (int b = 0; b < blocks; b++) {
+            result.push_back(ec[b * ecLength + i]);
+        }
+    }
+    return result;
+}
+
+const SymbolLayout& symbolLayout(int version)
+{
+    static std::array<std::once_flag, qrspec::kMaxVersion + 1> flags;
+    static std::array<std::unique_ptr<SymbolLayout>, qrspec::kMaxVersion + 1> layouts;
+    std::call_once(flags[version], [version]() { layouts[version] = createLayout(version); });
+    return *layouts[version];
+}
+
+bool maskBit(int mask, int x, int y)
+{
+    switch (mask) {
+        case 0:  return (x + y) % 2 == 0;
+        case 1:  return y % 2 == 0;
+        case 2:  return x % 3 == 0;
+        case 3:  return (x + y) % 3 == 0;
+        case 4:  return (x / 3 + y / 2) % 2 == 0;
+        case 5:  return x * y % 2 + x * y % 3 == 0;
+        case 6:  return (x * y % 2 + x * y % 3) % 2 == 0;
+        case 7:  return ((x + y) % 2 + x * y % 3) % 2 == 0;
+        default: return false;
+    }
+}
+
+void writeFormat(QRMatrix& symbol, ErrorCorrection level, int mask)
+{
+    const uint32_t bits = qrspec::formatBits(level, mask);
+    forEachFormatModule(symbol.size(), [&](int x, int y, int bit) {
+        symbol.setModule(x, y, (bits >> bit) & 1);
+    });
+}
+
+std::array<uint32_t, 2> readFormat(const QRMatrix& symbol)
+{
+    std::array<uint32_t, 2> copies{};
+    int visited = 0;
+    forEachFormatModule(symbol.size(), [&](int x, int y, int bit) {
+        if (symbol.module(x, y)) {
+            copies[visited / 15] |= uint32_t(1) << bit;
+        }
+        visited++;
+    });
+    return copies;
+}
+
+int maskPenalty(const QRMatrix& symbol)
+{
+    return maskPenalty(symbol, transposed(symbol));
+}
+
+int maskPenalty(const QRMatrix& symbol, const QRMatrix& columns)
+{
+    const int size = symbol.size();
+    const int words = symbol.wordsPerRow();
+    std::vector<int> runs(size + 2);
+
+    int penalty = 0;
+    long darkModules = 0;
+    for (int i = 0; i < size; i++) {
+        penalty += penaltyN1N3(symbol.row(i), size, runs.data());
+        penalty += penaltyN1N3(columns.row(i), size, runs.data());
+        for (int w = 0; w < words; w++) {
+            darkModules += __builtin_popcountll(symbol.row(i)[w]);
+        }
+    }
+
+    // N2: bloki 2x2 jednego koloru - bit x oznacza blok (x, x+1) w parze wierszy
+    for (int y = 1; y < size; y++) {
+        const uint64_t* above = symbol.row(y - 1);
+        const uint64_t* below = symbol.row(y);
+        for (int w = 0; w < words; w++) {
+            const uint64_t nextAbove = w + 1 < words ? above[w + 1] : 0;
+            const uint64_t nextBelow = w + 1 < words ? below[w + 1] : 0;
+            const uint64_t shiftedAbove = (above[w] >> 1) | (nextAbove << 63);
+            const uint64_t shiftedBelow = (below[w] >> 1) | (nextBelow << 63);
+            uint64_t blocks = ~(above[w] ^ below[w]) & ~(shiftedAbove ^ shiftedBelow) & ~(above[w] ^ shiftedAbove);
+
+            // Tylko bloki zaczynające się w kolumnach 0 .. size-2
+            const int first = w * 64;
+            if (first + 64 > size - 1) {
+                const int valid = size - 1 - first;
+                blocks &= valid > 0 ? (~uint64_t(0) >> (64 - valid)) : 0;
+            }
+            penalty += kPenaltyN2 * __builtin_popcountll(blocks);
+        }
+    }
+
+    // N4: odchylenie udziału ciemnych modułów od 50%
+    const long area = static_cast<long>(size) * size;
+    const long ratio = (200 * darkModules + area) / area / 2;
+    penalty += static_cast<int>(std::labs(ratio - 50) / 5) * kPenaltyN4;
+    return penalty;
+}
+
+QRMatrix buildSymbol(const SymbolLayout& layout, const std::vector<uint8_t>& codewords,
+                     ErrorCorrection level, int mask, bool parallel, int* chosenMask)
+{
+    // Bity słów kodowych w kolejności zygzaka; bity resztowe pozostają jasne
+    QRMatrix placed = layout.functionPattern;
+    const int size = layout.size;
+    const size_t bitCount = std::min(layout.dataOrder.size(), codewords.size() * 8);
+    for (size_t i = 0; i < bitCount; i++) {
+        if ((codewords[i >> 3] >> (7 - (i & 7))) & 1) {
+            const uint32_t index = layout.dataOrder[i];
+            placed.setModule(static_cast<int>(index % size), static_cast<int>(index / size), true);
+        }
+    }
+
+    // Symbol z maską m: XOR słów wierszy (lub kolumn) i słowo formatu
+    const int words = placed.wordsPerRow();
+    auto masked = [&](const QRMatrix& base, const QRMatrix& pattern) {
+        QRMatrix result = base;
+        for (int y = 0; y < size; y++) {
+            uint64_t* row = result.row(y);
+            const uint64_t* maskRow = pattern.row(y);
+            for (int w = 0; w < words; w++) {
+                row[w] ^= maskRow[w];
+            }
+        }
+        return result;
+    };
+
+    if (mask < 0 || mask >= 8) {
+        // Ocena wszystkich ośmiu masek; przy remisie wygrywa niższy numer
+        const QRMatrix placedColumns = transposed(placed);
+        std::array<int, 8> penalties{};
+        auto evaluate = [&](const cv::Range& range) {
+            for (int m = range.start; m < range.end; m++) {
+                QRMatrix rows = masked(placed, layout.masks[m]);
+                QRMatrix columns = masked(placedColumns, layout.maskColumns[m]);
+                const uint32_t bits = qrspec::formatBits(level, m);
+                forEachFormatModule(size, [&](int x, int y, int bit) {
+                    rows.setModule(x, y, (bits >> bit) & 1);
+                    columns.setModule(y, x, (bits >> bit) & 1);
+                });
+                penalties[m] = maskPenalty(rows, columns);
+            }
+        };
+        if (parallel) {
+            cv::parallel_for_(cv::Range(0, 8), evaluate);
+        } else {
+            evaluate(cv::Range(0, 8));
+        }
+        mask = static_cast<int>(std::min_element(penalties.begin(), penalties.end()) - penalties.begin());
+    }
+
+    QRMatrix symbol = masked(placed, layout.masks[mask]);
+    writeFormat(symbol, level, mask);
+    if (chosenMask) {
+        *chosenMask = mask;
+    }
+    return symbol;
+}
+
+QRMatrix encodeNative(const std::vector<Segment>& segments, const EncodeOptions& options)
+{
+    int version = options.version;
+    if (version < 0 || version > qrspec::kMaxVersion) {
+        return QRMatrix();
+    }
+    if (version == 0) {
+        version = chooseVersion(segments, options.ecLevel);
+        if (version == 0) {
+            return QRMatrix();
+        }
+    }
+
+    const std::vector<uint8_t> data = makeDataCodewords(segments, version, options.ecLevel);
+    if (data.empty()) {
+        return QRMatrix();
+    }
+
+    return buildSymbol(symbolLayout(version), interleaveCodewords(data, version, options.ecLevel),
+                       options.ecLevel, -1, options.parallelMasks);
+}
+
+} // namespace detail
+} // namespace qrcore
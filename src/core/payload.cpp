@@ -0,0 +1,71 @@
+#include "qrcore/payload.h"
+
+namespace qrcore {
+
+QString urlPayload(const QString& url)
+{
+    if (url.isEmpty()) {
+        return QString();
+    }
+
+    // Dodaj protokół jeśli brakuje
+    if (!url.startsWith("http://") && !url.startsWith("https://")) {
+        return "https://" + url;
+    }
+    return url;
+}
+
+QString vCardPayload(const ContactData& contact)
+{
+    // Sprawdź czy są jakieś dane
+    if (contact.firstName.isEmpty() && contact.lastName.isEmpty() && contact.phone.isEmpty() &&
+        contact.email.isEmpty() && contact.company.isEmpty() && contact.website.isEmpty()) {
+        return QString();
+    }
+
+    // Generuj vCard
+    QString vcard = "BEGIN:VCARD\n";
+    vcard += "VERSION:3.0\n";
+
+    if (!contact.firstName.isEmpty() || !contact.lastName.isEmpty()) {
+        QString fullName = (contact.firstName + " " + contact.lastName).trimmed();
+        vcard += "FN:" + fullName + "\n";
+        vcard += "N:" + contact.lastName + ";" + contact.firstName + ";;;\n";
+    }
+
+    if (!contact.phone.isEmpty()) {
+        vcard += "TEL:" + contact.phone + "\n";
+    }
+
+    if (!contact.email.isEmpty()) {
+        vcard += "EMAIL:" + contact.email + "\n";
+    }
+
+    if (!contact.company.isEmpty()) {
+        vcard += "ORG:" + contact.company + "\n";
+    }
+
+    if (!contact.website.isEmpty()) {
+        vcard += "URL:" + contact.website + "\n";
+    }
+
+    vcard += "END:VCARD";
+
+    return vcard;
+}
+
+QString wifiPayload(const WiFiData& wifi)
+{
+    if (wifi.ssid.isEmpty()) {
+        return QString();
+    }
+
+    // Format: WIFI:T:WPA;S:mynetwork;P:mypass;H:false;;
+    return QString("WIFI:T:%1;S:%2;P:%3;H:%4;;")
+           .arg(wifi.security)
+           .arg(wifi.ssid)
+           .arg(wifi.password)
+           .arg(wifi.hidden ? "true" : "false");
+}
+
+} // namespace qrcore
@@ -0,0 +1,196 @@
+#include "qrcore/photo_decoder.h"
+
+#include <opencv2/imgcodecs.hpp>
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+namespace qrcore {
+
+namespace {
+
+// Flaga imdecode dla pomniejszenia 1/reduction w skali szarości
+int reducedFlag(int reduction)
+{
+    switch (reduction) {
+        case 2: return cv::IMREAD_REDUCED_GRAYSCALE_2;
+        case 4: return cv::IMREAD_REDUCED_GRAYSCALE_4;
+        case 8: return cv::IMREAD_REDUCED_GRAYSCALE_8;
+        default: return cv::IMREAD_GRAYSCALE;
+    }
+}
+
+// Najmniejszy bok wielokąta kodu
+double shortestSide(const DecodeResult& result)
+{
+    double shortest = 0.0;
+    const size_t count = result.corners.size();
+    for (size_t i = 0; i < count; i++) {
+        const cv::Point2f edge = result.corners[(i + 1) % count] - result.corners[i];
+        const double length = std::hypot(edge.x, edge.y);
+        shortest = i == 0 ? length : std::min(shortest, length);
+    }
+    return shortest;
+}
+
+bool readFile(const std::string& path, std::vector<uint8_t>& data)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+
+    const std::streamsize size = file.tellg();
+    if (size <= 0) {
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), size));
+}
+
+} // namespace
+
+bool jpegSize(const uint8_t* data, size_t size, cv::Size& imageSize)
+{
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return false;
+    }
+
+    size_t position = 2;
+    while (position + 4 <= size) {
+        if (data[position] != 0xFF) {
+            return false;
+        }
+        const uint8_t marker = data[position + 1];
+        if (marker == 0xFF) {
+            position++; // bajt wypełnienia
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) {
+            position += 2; // znaczniki bez długości
+            continue;
+        }
+        if (marker == 0xD9 || marker == 0xDA) {
+            return false; // koniec obrazu albo dane skanu przed nagłówkiem ramki
+        }
+
+        const size_t length = static_cast<size_t>(data[position + 2]) << 8 | data[position + 3];
+        // SOF0-SOF15 z wyjątkiem DHT (C4), JPG (C8) i DAC (CC)
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+            if (position + 9 > size || length < 7) {
+                return false;
+            }
+            const int height = data[position + 5] << 8 | data[position + 6];
+            const int width = data[position + 7] << 8 | data[position + 8];
+            if (width <= 0 || height <= 0) {
+                return false;
+            }
+            imageSize = cv::Size(width, height);
+            return true;
+        }
+        position += 2 + length;
+    }
+    return false;
+}
+
+std::vector<DecodeResult> decodePhoto(const std::vector<uint8_t>& data, const PhotoDecodeOptions& options,
+                                      PhotoDecodeInfo* info)
+{
+    PhotoDecodeInfo local;
+    PhotoDecodeInfo& result = info ? *info : local;
+    result = PhotoDecodeInfo();
+    if (data.empty()) {
+        return {};
+    }
+
+    try {
+        // Pierwsze pomniejszenie: największe, przy którym dłuższy bok nie spada
+        // poniżej minReducedSide (48 Mpx - 1/4, 12 Mpx - 1/2)
+        int reduction = 1;
+        cv::Size size;
+        if (options.reducedJpeg && jpegSize(data.data(), data.size(), size)) {
+            const int longest = std::max(size.width, size.height);
+            for (int candidate : {8, 4, 2}) {
+                if (longest / candidate >= options.minReducedSide) {
+                    reduction = candidate;
+                    break;
+                }
+            }
+        }
+
+        std::vector<DecodeResult> best;
+        for (;; reduction /= 2) {
+            const cv::Mat gray = cv::imdecode(data, reducedFlag(reduction));
+            result.passes++;
+            if (gray.empty()) {
+                return best;
+            }
+            if (reduction == 1 || size.empty()) {
+                result.fullSize = cv::Size(gray.cols * reduction, gray.rows * reduction);
+            } else {
+                // imdecode obraca obraz według EXIF, nagłówek SOF podaje wymiary przed obrotem
+                const bool swapped = (gray.cols > gray.rows) != (size.width > size.height);
+                result.fullSize = swapped ? cv::Size(size.height, size.width) : size;
+            }
+
+            // Przebieg pomniejszony przeszukuje jeden poziom piramidy (duże kody
+            // są widoczne i na nim, mniejsze znajdzie kolejny przebieg) i bez
+            // kafelków - pełne przeszukanie kadru należy tylko do ostatniego
+            PyramidOptions pyramid = options.pyramid;
+            if (reduction > 1) {
+                pyramid.fullResolutionFallback = false;
+                pyramid.maxLevels = std::min(pyramid.maxLevels, 1);
+            }
+
+            std::vector<DecodeResult> found = decodePyramid(gray, pyramid);
+            const bool small = std::any_of(found.begin(), found.end(), [&](const DecodeResult& code) {
+                return shortestSide(code) < options.minCodeSide;
+            });
+            if (!found.empty()) {
+                // Środek piksela pomniejszenia leży w środku bloku reduction x reduction
+                const float scale = static_cast<float>(reduction);
+                for (DecodeResult& code : found) {
+                    for (cv::Point2f& point : code.corners) {
+                        point = (point + cv::Point2f(0.5f, 0.5f)) * scale - cv::Point2f(0.5f, 0.5f);
+                    }
+                }
+                // Kody odczytane tylko w mniejszej rozdzielczości zostają w wyniku
+                std::move(found.begin(), found.end(), std::back_inserter(best));
+                best = mergeDuplicates(std::move(best));
+                result.reduction = reduction;
+            }
+
+            // Większa rozdzielczość tylko dla pustego wyniku albo małych kodów -
+            // obok małego kodu mogą leżeć inne, nieczytelne w pomniejszeniu
+            if (reduction == 1 || (!best.empty() && !small)) {
+                break;
+            }
+        }
+        return best;
+
+    } catch (const std::exception& e) {
+        qWarning() << "Błąd odczytu zdjęcia:" << e.what();
+        return {};
+    }
+}
+
+std::vector<DecodeResult> decodePhotoFile(const std::string& path, const PhotoDecodeOptions& options,
+                                          PhotoDecodeInfo* info)
+{
+    std::vector<uint8_t> data;
+    if (!readFile(path, data)) {
+        if (info) {
+            *info = PhotoDecodeInfo();
+        }
+        return {};
+    }
+    return decodePhoto(data, options, info);
+}
+
+} // namespace qrcore
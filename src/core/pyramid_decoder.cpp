@@ -0,0 +1,205 @@
+#include "qrcore/pyramid_decoder.h"
+
+#include <opencv2/imgproc.hpp>
+#include <opencv2/objdetect.hpp>
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+
+namespace qrcore {
+
+namespace {
+
+// Bok kodu (w pikselach poziomu), poniżej którego lokalizator OpenCV zaczyna
+// gubić wzorce wyszukiwania
+constexpr int kMinLocatorSide = 128;
+
+// Najdokładniejszy poziom potrzebny do znalezienia kodu o boku minCodeSide
+// (poziom i ma rozdzielczość 1/2^(i+1))
+int finestLevel(int levels, const PyramidOptions& options)
+{
+    if (options.minCodeSide <= 0) {
+        return 0;
+    }
+    int level = 0;
+    while (level + 1 < levels && (options.minCodeSide >> (level + 2)) >= kMinLocatorSide) {
+        ++level;
+    }
+    return level;
+}
+
+// Wycinek pełnej rozdzielczości odpowiadający kandydatowi z poziomu piramidy
+cv::Rect candidateCrop(const cv::Point2f* quad, double factor, double padding, const cv::Size& size)
+{
+    std::vector<cv::Point2f> points;
+    for (int k = 0; k < 4; k++) {
+        points.emplace_back(quad[k].x * factor, quad[k].y * factor);
+    }
+
+    cv::Rect area = cv::boundingRect(points);
+    const int margin = static_cast<int>(std::max(area.width, area.height) * padding) + static_cast<int>(factor);
+    area.x -= margin;
+    area.y -= margin;
+    area.width += 2 * margin;
+    area.height += 2 * margin;
+    return area & cv::Rect(0, 0, size.width, size.height);
+}
+
+// Poziom piramidy z zamalowanymi (na biało) kodami odczytanymi na poziomach
+// zgrubnych - lokalizator szuka wtedy tylko pozostałych symboli
+cv::Mat maskDecoded(const cv::Mat& level, double factor, const std::vector<DecodeResult>& results)
+{
+    if (results.empty()) {
+        return level;
+    }
+
+    cv::Mat masked = level.clone();
+    for (const DecodeResult& result : results) {
+        std::vector<cv::Point> polygon;
+        for (const cv::Point2f& point : result.corners) {
+            polygon.emplace_back(cvRound(point.x / factor), cvRound(point.y / factor));
+        }
+        if (polygon.size() >= 3) {
+            cv::fillConvexPoly(masked, polygon, cv::Scalar(255));
+        }
+    }
+    return masked;
+}
+
+bool coveredByResults(const cv::Rect& crop, const std::vector<DecodeResult>& results)
+{
+    const cv::Point2f center(crop.x + crop.width * 0.5f, crop.y + crop.height * 0.5f);
+    for (const DecodeResult& result : results) {
+        if (cv::pointPolygonTest(result.corners, center, false) >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int pyramidLevels(const cv::Size& size, const PyramidOptions& options)
+{
+    int levels = 0;
+    int side = std::max(size.width, size.height);
+    while (side > options.coarseSide && levels < options.maxLevels) {
+        side /= 2;
+        ++levels;
+    }
+    return levels;
+}
+
+std::vector<DecodeResult> decodePyramid(const cv::Mat& image, const PyramidOptions& options)
+{
+    if (image.empty()) {
+        return {};
+    }
+
+    try {
+        cv::Mat gray;
+        if (image.channels() == 3) {
+            cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+        } else if (image.channels() == 4) {
+            cv::cvtColor(image, gray, cv::COLOR_BGRA2GRAY);
+        } else {
+            gray = image;
+        }
+
+        const int levels = pyramidLevels(gray.size(), options);
+        if (levels == 0) {
+            return decodeMulti(gray); // mały obraz - bez piramidy
+        }
+
+        // Poziomy piramidy: levelImages[i] ma rozdzielczość 1/2^(i+1)
+        std::vector<cv::Mat> levelImages(levels);
+        cv::Mat previous = gray;
+        for (int i = 0; i < levels; i++) {
+            cv::resize(previous, levelImages[i], cv::Size((previous.cols + 1) / 2, (previous.rows + 1) / 2),
+                       0, 0, cv::INTER_AREA);
+            previous = levelImages[i];
+        }
+
+        std::vector<DecodeResult> results;
+        cv::QRCodeDetector locator;
+
+        // Dokładniejszy poziom kosztuje czterokrotnie więcej - tylko dla
+        // nieodczytanych kandydatów, na żądanie (findSmall) albo gdy nic
+        // nie znaleziono, a pełna rozdzielczość nie będzie przeszukana
+        auto descend = [&](size_t pending) {
+            return pending > 0 || options.findSmall || (results.empty() && !options.fullResolutionFallback);
+        };
+
+        // Od najmniejszego poziomu w stronę większych
+        const int finest = finestLevel(levels, options);
+        for (int level = levels - 1; level >= finest; level--) {
+            const double factor = static_cast<double>(gray.cols) / levelImages[level].cols;
+
+            cv::Mat points;
+            if (!locator.detectMulti(maskDecoded(levelImages[level], factor, results), points) || points.empty()) {
+                if (!descend(0)) {
+                    break;
+                }
+                continue;
+            }
+
+            cv::Mat quads;
+            points.reshape(2, 1).convertTo(quads, CV_32FC2);
+            const cv::Point2f* quad = quads.ptr<cv::Point2f>();
+
+            std::vector<cv::Rect> crops;
+            for (size_t i = 0; i + 3 < quads.total(); i += 4) {
+                cv::Rect crop = candidateCrop(quad + i, factor, options.cropPadding, gray.size());
+                if (crop.area() > 0 && !coveredByResults(crop, results)) {
+                    crops.push_back(crop);
+                }
+            }
+
+            // Dekodowanie wycinków w pełnej rozdzielczości
+            std::vector<DecodeResult> decoded(crops.size());
+            auto worker = [&](const cv::Range& range) {
+                DecoderContext context;
+                for (int i = range.start; i < range.end; i++) {
+                    context.reset();
+                    decoded[i] = context.decode(gray(crops[i]));
+                    for (cv::Point2f& point : decoded[i].corners) {
+                        point.x += crops[i].x;
+                        point.y += crops[i].y;
+                    }
+                }
+            };
+
+            if (options.parallel && crops.size() > 1) {
+                cv::parallel_for_(cv::Range(0, static_cast<int>(crops.size())), worker);
+            } else {
+                worker(cv::Range(0, static_cast<int>(crops.size())));
+            }
+
+            // Kolejne, dokładniejsze poziomy szukają mniejszych kodów obok
+            // odczytanych - duży kod nie ukrywa małych
+            size_t pending = 0;
+            for (DecodeResult& result : decoded) {
+                if (result.isValid()) {
+                    results.push_back(std::move(result));
+                } else {
+                    ++pending;
+                }
+            }
+            if (!descend(pending)) {
+                break;
+            }
+        }
+
+        if (results.empty() && options.fullResolutionFallback) {
+            return decodeMulti(gray);
+        }
+        return mergeDuplicates(std::move(results));
+
+    } catch (const std::exception& e) {
+        qWarning() << "Błąd dekodowania piramidowego:" << e.what();
+        return {};
+    }
+}
+
+} // namespace qrcore
@@ -0,0 +1,89 @@
+#include "qrcore/qr_decoder.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <QtCore/QDebug>
+
+namespace qrcore {
+
+const cv::Mat& DecoderContext::toGray(const cv::Mat& image)
+{
+    // Wszystkie backendy pracują na skali szarości - konwertujemy raz,
+    // do bufora wielokrotnego użytku (cvtColor nie alokuje przy tym samym rozmiarze)
+    switch (image.channels()) {
+        case 3:
+            cv::cvtColor(image, m_gray, cv::COLOR_BGR2GRAY);
+            return m_gray;
+        case 4:
+            cv::cvtColor(image, m_gray, cv::COLOR_BGRA2GRAY);
+            return m_gray;
+        default:
+            return image;
+    }
+}
+
+bool DecoderContext::detectIn(const cv::Mat& gray, const cv::Rect& area, DecodeResult& result)
+{
+    std::vector<DecodeResult> found = m_cascade.decode(gray(area), false);
+    if (found.empty()) {
+        return false;
+    }
+
+    // Narożniki z układu wycinka do układu całego obrazu
+    result = std::move(found.front());
+    for (cv::Point2f& point : result.corners) {
+        point.x += area.x;
+        point.y += area.y;
+    }
+    m_lastCorners = result.corners;
+    return true;
+}
+
+DecodeResult DecoderContext::decode(const cv::Mat& image)
+{
+    DecodeResult result;
+    if (image.empty()) {
+        return result;
+    }
+
+    try {
+        const cv::Mat& gray = toGray(image);
+        const cv::Rect frame(0, 0, gray.cols, gray.rows);
+
+        // Najpierw obszar wokół symbolu z poprzedniej klatki
+        if (!m_lastCorners.empty()) {
+            cv::Rect area = cv::boundingRect(m_lastCorners);
+            const int padding = static_cast<int>(std::max(area.width, area.height) * m_roiPadding);
+            area.x -= padding;
+            area.y -= padding;
+            area.width += 2 * padding;
+            area.height += 2 * padding;
+            area &= frame;
+
+            if (area.area() > 0 && area != frame && detectIn(gray, area, result)) {
+                ++m_roiHits;
+                return result;
+            }
+        }
+
+        // Pełne przeszukanie kadru
+        if (!detectIn(gray, frame, result)) {
+            m_lastCorners.clear(); // symbol zniknął z kadru
+        }
+        return result;
+
+    } catch (const std::exception& e) {
+        qWarning() << "Błąd dekodowania QR:" << e.what();
+        m_lastCorners.clear();
+        return DecodeResult();
+    }
+}
+
+DecodeResult decode(const cv::Mat& image)
+{
+    // Pojedynczy obraz - świeży kontekst bez historii położenia
+    DecoderContext context;
+    return context.decode(image);
+}
+
+} // namespace qrcore
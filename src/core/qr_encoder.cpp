@@ -0,0 +1,139 @@
+#include "qrcore/qr_encoder.h"
+
+#include "qrcore/segmenter.h"
+
+#include "encoder_internal.h"
+
+#include <qrencode.h>
+
+#include <cctype>
+
+namespace qrcore {
+
+namespace {
+
+QRecLevel toQRecLevel(ErrorCorrection level)
+{
+    switch (level) {
+        case ErrorCorrection::Low:      return QR_ECLEVEL_L;
+        case ErrorCorrection::Quartile: return QR_ECLEVEL_Q;
+        case ErrorCorrection::High:     return QR_ECLEVEL_H;
+        case ErrorCorrection::Medium:
+        default:                        return QR_ECLEVEL_M;
+    }
+}
+
+QRencodeMode toQRencodeMode(SegmentMode mode)
+{
+    switch (mode) {
+        case SegmentMode::Numeric:      return QR_MODE_NUM;
+        case SegmentMode::Alphanumeric: return QR_MODE_AN;
+        case SegmentMode::Kanji:        return QR_MODE_KANJI;
+        case SegmentMode::StructuredAppend: return QR_MODE_STRUCTURE;
+        case SegmentMode::Byte:
+        default:                        return QR_MODE_8;
+    }
+}
+
+// Przepisanie modułów (najmłodszy bit = moduł ciemny) i zwolnienie symbolu
+QRMatrix fromQRcode(QRcode* qrCode)
+{
+    if (!qrCode) {
+        return QRMatrix();
+    }
+
+    const int qrSize = qrCode->width;
+    QRMatrix matrix(qrSize, qrCode->version);
+    for (int y = 0; y < qrSize; y++) {
+        const unsigned char* row = qrCode->data + y * qrSize;
+        for (int x = 0; x < qrSize; x++) {
+            if (row[x] & 1) {
+                matrix.setModule(x, y, true);
+            }
+        }
+    }
+
+    QRcode_free(qrCode);
+    return matrix;
+}
+
+} // namespace
+
+bool operator==(const EncodeOptions& a, const EncodeOptions& b)
+{
+    return a.ecLevel == b.ecLevel && a.version == b.version && a.caseSensitive == b.caseSensitive &&
+           a.backend == b.backend && a.parallelMasks == b.parallelMasks &&
+           a.optimizeSegments == b.optimizeSegments && a.allowKanji == b.allowKanji;
+}
+
+size_t hashValue(const EncodeOptions& options)
+{
+    size_t hash = static_cast<size_t>(options.ecLevel);
+    hash = hash * 31 + static_cast<size_t>(options.version);
+    hash = hash * 31 + (options.caseSensitive ? 1 : 0);
+    hash = hash * 31 + static_cast<size_t>(options.backend);
+    hash = hash * 31 + (options.parallelMasks ? 1 : 0);
+    hash = hash * 31 + (options.optimizeSegments ? 1 : 0);
+    hash = hash * 31 + (options.allowKanji ? 1 : 0);
+    return hash;
+}
+
+QRMatrix encode(const std::string& data, const EncodeOptions& options)
+{
+    if (options.optimizeSegments) {
+        // Najkrótszy strumień bitów - wersja wynika z tablicy pojemności
+        const SegmentPlan plan = planSegments(data, options);
+        if (plan.version == 0) {
+            return QRMatrix();
+        }
+        EncodeOptions planned = options;
+        planned.version = plan.version;
+        return encodeSegments(plan.segments, planned);
+    }
+
+    if (options.backend == EncoderBackend::Native) {
+        Segment segment;
+        segment.data = data;
+        if (!options.caseSensitive) {
+            for (char& c : segment.data) {
+                c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            }
+        }
+        return detail::encodeNative({segment}, options);
+    }
+
+    // Utworzenie kodu QR przy użyciu libqrencode
+    QRcode* qrCode = QRcode_encodeString(data.c_str(),
+                                       options.version,
+                                       toQRecLevel(options.ecLevel),
+                                       QR_MODE_8, // tryb kodowania
+                                       options.caseSensitive ? 1 : 0);
+    return fromQRcode(qrCode);
+}
+
+QRMatrix encodeSegments(const std::vector<Segment>& segments, const EncodeOptions& options)
+{
+    if (options.backend == EncoderBackend::Native) {
+        return detail::encodeNative(segments, options);
+    }
+
+    QRinput* input = QRinput_new2(options.version, toQRecLevel(options.ecLevel));
+    if (!input) {
+        return QRMatrix();
+    }
+
+    for (const Segment& segment : segments) {
+        const int appended = QRinput_append(input, toQRencodeMode(segment.mode), static_cast<int>(segment.data.size()),
+                                            reinterpret_cast<const unsigned char*>(segment.data.data()));
+        if (appended != 0) {
+            QRinput_free(input);
+            return QRMatrix();
+        }
+    }
+
+    QRcode* qrCode = QRcode_encodeInput(input);
+    QRinput_free(input);
+    return fromQRcode(qrCode);
+}
+
+} // namespace qrcore
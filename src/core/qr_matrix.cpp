@@ -0,0 +1,18 @@
+#include "qrcore/qr_matrix.h"
+
+namespace qrcore {
+
+QRMatrix::QRMatrix(int size, int version)
+    : m_size(size > 0 ? size : 0),
+      m_version(version),
+      m_wordsPerRow((m_size + 63) / 64),
+      m_words(static_cast<size_t>(m_size) * m_wordsPerRow, 0)
+{
+}
+
+bool QRMatrix::operator==(const QRMatrix& other) const
+{
+    return m_size == other.m_size && m_version == other.m_version && m_words == other.m_words;
+}
+
+} // namespace qrcore
@@ -0,0 +1,275 @@
+#include "qrcore/qr_rasterizer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace qrcore {
+
+namespace {
+
+constexpr uint32_t kDarkRGB32 = 0xFF000000u;
+constexpr uint32_t kLightRGB32 = 0xFFFFFFFFu;
+
+// Pozycja pierwszego modułu >= x o zadanym kolorze (lub size, jeśli brak)
+template <bool Dark>
+inline int nextModule(const uint64_t* row, int x, int size)
+{
+    int wordIndex = x >> 6;
+    const int lastWord = (size - 1) >> 6;
+    uint64_t word = Dark ? row[wordIndex] : ~row[wordIndex];
+    word &= ~uint64_t(0) << (x & 63);
+
+    while (word == 0) {
+        if (++wordIndex > lastWord) {
+            return size;
+        }
+        word = Dark ? row[wordIndex] : ~row[wordIndex];
+    }
+
+    int position = (wordIndex << 6) + __builtin_ctzll(word);
+    return position < size ? position : size;
+}
+
+// Ustawia bity [from, to) w wierszu formatu Mono (MSB pierwszy)
+inline void setBitSpan(uint8_t* line, int from, int to)
+{
+    int firstByte = from >> 3;
+    const int lastByte = (to - 1) >> 3;
+    const uint8_t headMask = uint8_t(0xFF >> (from & 7));
+    const uint8_t tailMask = uint8_t(0xFF << (7 - ((to - 1) & 7)));
+
+    if (firstByte == lastByte) {
+        line[firstByte] |= headMask & tailMask;
+        return;
+    }
+
+    line[firstByte++] |= headMask;
+    if (lastByte > firstByte) {
+        std::memset(line + firstByte, 0xFF, lastByte - firstByte);
+    }
+    line[lastByte] |= tailMask;
+}
+
+// Wypełnia jasne tło wiersza pikseli
+inline void fillLight(uint8_t* line, int width, PixelFormat format)
+{
+    switch (format) {
+        case PixelFormat::Mono:
+            std::memset(line, 0x00, (width + 7) >> 3);
+            break;
+        case PixelFormat::Gray8:
+            std::memset(line, 0xFF, width);
+            break;
+        case PixelFormat::RGB32:
+            std::fill_n(reinterpret_cast<uint32_t*>(line), width, kLightRGB32);
+            break;
+    }
+}
+
+// Czyści bity [from, to) w wierszu formatu Mono
+inline void clearBitSpan(uint8_t* line, int from, int to)
+{
+    for (int x = from; x < to; x++) {
+        line[x >> 3] &= uint8_t(~(0x80 >> (x & 7)));
+    }
+}
+
+// Wypełnia odcinek [from, to) pikseli kolorem ciemnym
+inline void fillDark(uint8_t* line, int from, int to, PixelFormat format)
+{
+    switch (format) {
+        case PixelFormat::Mono:
+            setBitSpan(line, from, to);
+            break;
+        case PixelFormat::Gray8:
+            std::memset(line + from, 0x00, to - from);
+            break;
+        case PixelFormat::RGB32:
+            std::fill_n(reinterpret_cast<uint32_t*>(line) + from, to - from, kDarkRGB32);
+            break;
+    }
+}
+
+// Rysuje wszystkie wiersze modułów. Scale > 0 to wariant wyspecjalizowany
+// w czasie kompilacji (mnożenia i pętla replikacji znane kompilatorowi),
+// Scale == 0 oznacza skalę przekazaną w runtimeScale.
+template <int Scale>
+void rasterizeRows(const QRMatrix& matrix, int runtimeScale, int border, int width,
+                   PixelFormat format, uint8_t* destination, size_t bytesPerLine)
+{
+    const int scale = Scale > 0 ? Scale : runtimeScale;
+    const int size = matrix.size();
+    const size_t lineBytes = rasterBytesPerLine(width, format);
+    const int offset = border * scale;
+
+    // Górna strefa ciszy: jeden wiersz tła powielony w dół
+    uint8_t* line = destination;
+    const int borderRows = border * scale;
+    if (borderRows > 0) {
+        fillLight(line, width, format);
+        for (int i = 1; i < borderRows; i++) {
+            std::memcpy(line + i * bytesPerLine, line, lineBytes);
+        }
+    }
+
+    for (int y = 0; y < size; y++) {
+        line = destination + static_cast<size_t>(borderRows + y * scale) * bytesPerLine;
+        const uint64_t* modules = matrix.row(y);
+
+        fillLight(line, width, format);
+        int x = nextModule<true>(modules, 0, size);
+        while (x < size) {
+            const int end = nextModule<false>(modules, x, size);
+            fillDark(line, offset + x * scale, offset + end * scale, format);
+            x = end < size ? nextModule<true>(modules, end, size) : size;
+        }
+
+        for (int i = 1; i < scale; i++) {
+            std::memcpy(line + i * bytesPerLine, line, lineBytes);
+        }
+    }
+
+    // Dolna strefa ciszy
+    if (borderRows > 0) {
+        const uint8_t* source = destination;
+        line = destination + static_cast<size_t>(borderRows + size * scale) * bytesPerLine;
+        for (int i = 0; i < borderRows; i++) {
+            std::memcpy(line + i * bytesPerLine, source, lineBytes);
+        }
+    }
+}
+
+} // namespace
+
+int rasterSize(const QRMatrix& matrix, const RasterOptions& options)
+{
+    if (matrix.isNull() || options.scale < 1 || options.border < 0) {
+        return 0;
+    }
+    return (matrix.size() + 2 * options.border) * options.scale;
+}
+
+size_t rasterBytesPerLine(int width, PixelFormat format)
+{
+    switch (format) {
+        case PixelFormat::Mono:  return (static_cast<size_t>(width) + 7) / 8;
+        case PixelFormat::Gray8: return static_cast<size_t>(width);
+        case PixelFormat::RGB32: return static_cast<size_t>(width) * 4;
+    }
+    return 0;
+}
+
+bool rasterize(const QRMatrix& matrix, const RasterOptions& options, PixelFormat format,
+               uint8_t* destination, size_t bytesPerLine)
+{
+    const int width = rasterSize(matrix, options);
+    if (width == 0 || !destination || bytesPerLine < rasterBytesPerLine(width, format)) {
+        return false;
+    }
+
+    // Najczęstsze skale (podgląd, wydruk) mają osobne specjalizacje
+    switch (options.scale) {
+        case 1:  rasterizeRows<1>(matrix, 1, options.border, width, format, destination, bytesPerLine); break;
+        case 2:  rasterizeRows<2>(matrix, 2, options.border, width, format, destination, bytesPerLine); break;
+        case 4:  rasterizeRows<4>(matrix, 4, options.border, width, format, destination, bytesPerLine); break;
+        case 8:  rasterizeRows<8>(matrix, 8, options.border, width, format, destination, bytesPerLine); break;
+        case 16: rasterizeRows<16>(matrix, 16, options.border, width, format, destination, bytesPerLine); break;
+        default: rasterizeRows<0>(matrix, options.scale, options.border, width, format, destination, bytesPerLine); break;
+    }
+    return true;
+}
+
+bool rasterizeModules(const QRMatrix& matrix, const std::vector<ModulePosition>& modules,
+                      const RasterOptions& options, PixelFormat format,
+                      uint8_t* destination, size_t bytesPerLine)
+{
+    const int width = rasterSize(matrix, options);
+    if (width == 0 || !destination || bytesPerLine < rasterBytesPerLine(width, format)) {
+        return false;
+    }
+
+    const int scale = options.scale;
+    const int offset = options.border * scale;
+    for (const ModulePosition& position : modules) {
+        if (position.x < 0 || position.y < 0 || position.x >= matrix.size() || position.y >= matrix.size()) {
+            continue;
+        }
+        const bool dark = matrix.module(position.x, position.y);
+        const int from = offset + position.x * scale;
+        const int to = from + scale;
+        uint8_t* line = destination + static_cast<size_t>(offset + position.y * scale) * bytesPerLine;
+        for (int i = 0; i < scale; i++, line += bytesPerLine) {
+            if (dark) {
+                fillDark(line, from, to, format);
+            } else if (format == PixelFormat::Mono) {
+                clearBitSpan(line, from, to);
+            } else if (format == PixelFormat::Gray8) {
+                std::memset(line + from, 0xFF, scale);
+            } else {
+                std::fill_n(reinterpret_cast<uint32_t*>(line) + from, scale, kLightRGB32);
+            }
+        }
+    }
+    return true;
+}
+
+StripRasterizer::StripRasterizer(const QRMatrix& matrix, const RasterOptions& options, int outputSize)
+    : m_matrix(matrix), m_border(options.border)
+{
+    if (matrix.isNull() || options.border < 0 || (outputSize <= 0 && options.scale < 1)) {
+        return;
+    }
+
+    const int modules = matrix.size() + 2 * options.border;
+    m_size = outputSize > 0 ? outputSize : modules * options.scale;
+    if (m_size < modules) {
+        // Moduł mniejszy od piksela nie daje czytelnego symbolu
+        m_size = 0;
+        return;
+    }
+
+    m_edges.resize(modules + 1);
+    for (int i = 0; i <= modules; i++) {
+        m_edges[i] = static_cast<int>(static_cast<int64_t>(i) * m_size / modules);
+    }
+}
+
+int StripRasterizer::moduleRowAt(int y) const
+{
+    return static_cast<int>(std::upper_bound(m_edges.begin(), m_edges.end(), y) - m_edges.begin()) - 1;
+}
+
+void StripRasterizer::render(int firstRow, int rowCount, uint8_t* destination, size_t bytesPerLine) const
+{
+    const size_t lineBytes = this->bytesPerLine();
+    const int size = m_matrix.size();
+    int previousModuleRow = -1;
+
+    for (int i = 0; i < rowCount; i++) {
+        uint8_t* line = destination + static_cast<size_t>(i) * bytesPerLine;
+        const int moduleRow = moduleRowAt(firstRow + i);
+
+        // Kolejne wiersze pikseli tego samego wiersza modułów są kopiami
+        if (moduleRow == previousModuleRow) {
+            std::memcpy(line, line - bytesPerLine, lineBytes);
+            continue;
+        }
+        previousModuleRow = moduleRow;
+
+        fillLight(line, m_size, PixelFormat::Mono);
+        const int y = moduleRow - m_border;
+        if (y < 0 || y >= size) {
+            continue;
+        }
+
+        const uint64_t* modules = m_matrix.row(y);
+        int x = nextModule<true>(modules, 0, size);
+        while (x < size) {
+            const int end = nextModule<false>(modules, x, size);
+            setBitSpan(line, m_edges[x + m_border], m_edges[end + m_border]);
+            x = end < size ? nextModule<true>(modules, end, size) : size;
+        }
+    }
+}
+
+} // namespace qrcore
@@ -0,0 +1,49 @@
+#include "qrcore/qr_renderer.h"
+
+namespace qrcore {
+
+int scaleForSize(const QRMatrix& matrix, int size, int border)
+{
+    if (matrix.isNull()) {
+        return 1;
+    }
+
+    int scale = size / (matrix.size() + 2 * border);
+    return scale < 1 ? 1 : scale;
+}
+
+QImage renderImage(const QRMatrix& matrix, const RenderOptions& options)
+{
+    RasterOptions raster;
+    raster.scale = options.scale;
+    raster.border = options.border;
+
+    const int imageSize = rasterSize(matrix, raster);
+    if (imageSize == 0) {
+        return QImage();
+    }
+
+    QImage qrImage;
+    switch (options.format) {
+        case PixelFormat::Mono:
+            // Indeks 0 = tło, indeks 1 = moduł ciemny
+            qrImage = QImage(imageSize, imageSize, QImage::Format_Mono);
+            qrImage.setColorTable({qRgb(255, 255, 255), qRgb(0, 0, 0)});
+            break;
+        case PixelFormat::Gray8:
+            qrImage = QImage(imageSize, imageSize, QImage::Format_Grayscale8);
+            break;
+        case PixelFormat::RGB32:
+            qrImage = QImage(imageSize, imageSize, QImage::Format_RGB32);
+            break;
+    }
+
+    if (qrImage.isNull()) {
+        return QImage(); // brak pamięci na obraz
+    }
+
+    rasterize(matrix, raster, options.format, qrImage.bits(), qrImage.bytesPerLine());
+    return qrImage;
+}
+
+} // namespace qrcore
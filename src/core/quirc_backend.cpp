@@ -0,0 +1,130 @@
+#include "qrcore/decoder_backend.h"
+
+#include "qrcore/qr_matrix.h"
+#include "qrcore/symbol_reader.h"
+
+#include "decoder_internal.h"
+
+#include <quirc.h>
+
+#include <cstring>
+
+namespace qrcore {
+
+namespace {
+
+class QuircBackend : public DecoderBackend
+{
+public:
+    QuircBackend() : m_quirc(quirc_new()) {}
+    ~QuircBackend() override
+    {
+        if (m_quirc) {
+            quirc_destroy(m_quirc);
+        }
+    }
+
+    QuircBackend(const QuircBackend&) = delete;
+    QuircBackend& operator=(const QuircBackend&) = delete;
+
+    const char* name() const override { return "quirc"; }
+
+    std::vector<DecodeResult> decode(const cv::Mat& gray, bool multiple) override
+    {
+        std::vector<DecodeResult> results;
+        if (!m_quirc || gray.empty() || gray.type() != CV_8UC1) {
+            return results;
+        }
+
+        // Bufor quirc jest przydzielany ponownie tylko przy zmianie rozmiaru
+        if (gray.size() != m_size) {
+            if (quirc_resize(m_quirc, gray.cols, gray.rows) < 0) {
+                m_size = cv::Size();
+                return results;
+            }
+            m_size = gray.size();
+        }
+
+        int width = 0;
+        int height = 0;
+        uint8_t* buffer = quirc_begin(m_quirc, &width, &height);
+        for (int y = 0; y < height; y++) {
+            std::memcpy(buffer + static_cast<size_t>(y) * width, gray.ptr<uint8_t>(y), static_cast<size_t>(width));
+        }
+        quirc_end(m_quirc);
+
+        const int count = quirc_count(m_quirc);
+        for (int i = 0; i < count; i++) {
+            quirc_extract(m_quirc, i, &m_code);
+            DecodeResult result;
+            if (decodeCode(result)) {
+                results.push_back(std::move(result));
+                if (!multiple) {
+                    break;
+                }
+            }
+        }
+        return results;
+    }
+
+private:
+    // Siatka modułów wyodrębniona przez quirc (bit y * size + x, LSB pierwszy)
+    QRMatrix grid() const
+    {
+        const int size = m_code.size;
+        if (size < 21 || size > 177 || (size - 17) % 4 != 0) {
+            return QRMatrix();
+        }
+        QRMatrix grid(size, (size - 17) / 4);
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                const int bit = y * size + x;
+                if ((m_code.cell_bitmap[bit >> 3] >> (bit & 7)) & 1) {
+                    grid.setModule(x, y, true);
+                }
+            }
+        }
+        return grid;
+    }
+
+    bool decodeCode(DecodeResult& result)
+    {
+        // quirc kończy rozbiór na nieznanym trybie, więc symbol z nagłówkiem
+        // Structured Append daje pustą treść; takie symbole i symbole odbite
+        // lustrzanie (błąd korekcji) są czytane ponownie z siatki modułów
+        if (quirc_decode(&m_code, &m_data) == QUIRC_SUCCESS && m_data.payload_len > 0) {
+            result.text.assign(reinterpret_cast<const char*>(m_data.payload), static_cast<size_t>(m_data.payload_len));
+        } else {
+            SymbolContent content;
+            if (!readSymbol(grid(), content) || content.text.empty()) {
+                return false;
+            }
+            result.text = std::move(content.text);
+            result.structuredAppend = content.structuredAppend;
+        }
+
+        for (const quirc_point& corner : m_code.corners) {
+            result.corners.emplace_back(static_cast<float>(corner.x), static_cast<float>(corner.y));
+        }
+        return true;
+    }
+
+    struct quirc* m_quirc;
+    cv::Size m_size;
+    // Duże struktury (kilka KB) trzymane w obiekcie, a nie na stosie
+    struct quirc_code m_code;
+    struct quirc_data m_data;
+};
+
+} // namespace
+
+namespace detail {
+
+std::unique_ptr<DecoderBackend> createQuircBackend()
+{
+    return std::make_unique<QuircBackend>();
+}
+
+} // namespace detail
+
+} // namespace qrcore
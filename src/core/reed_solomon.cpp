@@ -0,0 +1,168 @@
+#include "qrcore/reed_solomon.h"
+
+#include <cstring>
+
+namespace qrcore {
+
+namespace {
+
+// Tablice tylko dla stopni występujących w specyfikacji QR (wersje 1-40)
+template <int Degree>
+inline constexpr GeneratorProducts kProducts = makeGeneratorProducts<Degree>();
+
+const GeneratorProducts* productsFor(int degree)
+{
+    switch (degree) {
+        case 7:  return &kProducts<7>;
+        case 10: return &kProducts<10>;
+        case 13: return &kProducts<13>;
+        case 15: return &kProducts<15>;
+        case 16: return &kProducts<16>;
+        case 17: return &kProducts<17>;
+        case 18: return &kProducts<18>;
+        case 20: return &kProducts<20>;
+        case 22: return &kProducts<22>;
+        case 24: return &kProducts<24>;
+        case 26: return &kProducts<26>;
+        case 28: return &kProducts<28>;
+        case 30: return &kProducts<30>;
+        default: return nullptr;
+    }
+}
+
+} // namespace
+
+bool rsEncode(const uint8_t* data, size_t length, int ecLength, uint8_t* ec)
+{
+    const GeneratorProducts* products = productsFor(ecLength);
+    if (!products) {
+        return false;
+    }
+
+    // Rejestr reszty z dzielenia; pozycje >= ecLength pozostają zerowe,
+    // bo odpowiadające im kolumny tablicy iloczynów są zerami
+    alignas(32) uint8_t remainder[33] = {};
+    for (size_t i = 0; i < length; i++) {
+        const uint8_t factor = data[i] ^ remainder[0];
+        std::memmove(remainder, remainder + 1, 32);
+        const uint8_t* row = (*products)[factor].data();
+        for (int j = 0; j < 32; j++) {
+            remainder[j] ^= row[j];
+        }
+    }
+
+    std::memcpy(ec, remainder, static_cast<size_t>(ecLength));
+    return true;
+}
+
+int rsDecode(uint8_t* codeword, size_t length, int ecLength)
+{
+    if (ecLength < 1 || ecLength > kMaxEcCodewords || length <= static_cast<size_t>(ecLength) || length > 255) {
+        return -1;
+    }
+
+    // Syndromy S_i = c(2^i) - pierwiastki generatora zaczynają się od 2^0
+    uint8_t syndromes[kMaxEcCodewords];
+    bool clean = true;
+    for (int i = 0; i < ecLength; i++) {
+        const uint8_t root = gf256::power(i);
+        uint8_t value = 0;
+        for (size_t j = 0; j < length; j++) {
+            value = gf256::multiply(value, root) ^ codeword[j];
+        }
+        syndromes[i] = value;
+        clean = clean && value == 0;
+    }
+    if (clean) {
+        return 0;
+    }
+
+    // Wielomian lokatorów błędów, współczynniki od najniższej potęgi
+    uint8_t locator[kMaxEcCodewords + 1] = {1};
+    uint8_t previous[kMaxEcCodewords + 1] = {1};
+    uint8_t saved[kMaxEcCodewords + 1];
+    int errors = 0;
+    int shift = 1;
+    uint8_t previousDiscrepancy = 1;
+    for (int n = 0; n < ecLength; n++) {
+        uint8_t discrepancy = syndromes[n];
+        for (int i = 1; i <= errors; i++) {
+            discrepancy ^= gf256::multiply(locator[i], syndromes[n - i]);
+        }
+        if (discrepancy == 0) {
+            shift++;
+            continue;
+        }
+        std::memcpy(saved, locator, sizeof(locator));
+        const uint8_t scale = gf256::divide(discrepancy, previousDiscrepancy);
+        for (int i = shift; i <= ecLength; i++) {
+            locator[i] ^= gf256::multiply(scale, previous[i - shift]);
+        }
+        if (2 * errors <= n) {
+            errors = n + 1 - errors;
+            std::memcpy(previous, saved, sizeof(saved));
+            previousDiscrepancy = discrepancy;
+            shift = 1;
+        } else {
+            shift++;
+        }
+    }
+    if (2 * errors > ecLength) {
+        return -1;
+    }
+
+    // Omega = S * lokator mod x^ecLength (wystarczą wyrazy stopnia < errors)
+    uint8_t evaluator[kMaxEcCodewords] = {};
+    for (int i = 0; i < errors; i++) {
+        for (int j = 0; j <= i; j++) {
+            evaluator[i] ^= gf256::multiply(syndromes[j], locator[i - j]);
+        }
+    }
+
+    // Chien: pozycja p odpowiada potędze x^(length-1-p), czyli lokatorowi
+    // X = 2^(length-1-p); błąd tam, gdzie lokator(X^-1) = 0
+    int positions[kMaxEcCodewords];
+    uint8_t magnitudes[kMaxEcCodewords];
+    int found = 0;
+    for (size_t p = 0; p < length && found <= errors; p++) {
+        const int exponent = static_cast<int>(length - 1 - p);
+        const uint8_t inverse = gf256::power(-exponent);
+        uint8_t value = 0;
+        uint8_t derivative = 0;
+        uint8_t term = 1;
+        for (int i = 0; i <= errors; i++) {
+            value ^= gf256::multiply(locator[i], term);
+            // Pochodna formalna w GF(2^m): zostają wyrazy nieparzystych potęg
+            if ((i & 1) != 0) {
+                derivative ^= gf256::multiply(locator[i], gf256::divide(term, inverse));
+            }
+            term = gf256::multiply(term, inverse);
+        }
+        if (value != 0) {
+            continue;
+        }
+        if (found == errors || derivative == 0) {
+            return -1;
+        }
+        uint8_t omega = 0;
+        term = 1;
+        for (int i = 0; i < errors; i++) {
+            omega ^= gf256::multiply(evaluator[i], term);
+            term = gf256::multiply(term, inverse);
+        }
+        // Forney dla pierwszego pierwiastka 2^0: e = X * Omega(X^-1) / lokator'(X^-1)
+        positions[found] = static_cast<int>(p);
+        magnitudes[found] = gf256::multiply(gf256::power(exponent), gf256::divide(omega, derivative));
+        found++;
+    }
+    if (found != errors) {
+        return -1;
+    }
+
+    for (int i = 0; i < found; i++) {
+        codeword[positions[i]] ^= magnitudes[i];
+    }
+    return found;
+}
+
+} // namespace qrcore
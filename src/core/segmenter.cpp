@@ -0,0 +1,254 @@
+#include "qrcore/segmenter.h"
+
+#include "qrcore/qr_tables.h"
+
+#include "encoder_internal.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QStringEncoder>
+
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace qrcore {
+
+namespace {
+
+constexpr int kModeCount = 4;  // indeksy jak w SegmentMode
+
+// Koszt znaku w 1/6 bitu: cyfra 10/3, znak alfanumeryczny 11/2, bajt 8,
+// znak Kanji 13 bitów
+constexpr int kNumericCost = 20;
+constexpr int kAlphanumericCost = 33;
+constexpr int kByteCost = 48;
+constexpr int kKanjiCost = 78;
+
+// Znak wejścia: zakres bajtów UTF-8 i tryby, w których da się go zapisać
+struct Character {
+    uint32_t offset = 0;
+    uint8_t length = 1;     // bajty UTF-8
+    bool numeric = false;
+    bool alphanumeric = false;
+    uint16_t kanji = 0;     // kod Shift JIS (0 = znak spoza trybu Kanji)
+};
+
+bool isAlphanumeric(char c)
+{
+    return c != '\0' && std::strchr("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:", c) != nullptr;
+}
+
+// Długość poprawnej sekwencji UTF-8 od pozycji i wraz z punktem kodowym;
+// 0 dla bajtu, który nie rozpoczyna poprawnej sekwencji
+int decodeUtf8(const std::string& data, size_t i, uint32_t& codePoint)
+{
+    const unsigned char lead = static_cast<unsigned char>(data[i]);
+    int length = 0;
+    if (lead < 0x80) {
+        codePoint = lead;
+        return 1;
+    } else if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        codePoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        codePoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        codePoint = lead & 0x07;
+    } else {
+        return 0;
+    }
+    if (i + static_cast<size_t>(length) > data.size()) {
+        return 0;
+    }
+    for (int j = 1; j < length; j++) {
+        const unsigned char next = static_cast<unsigned char>(data[i + j]);
+        if ((next & 0xC0) != 0x80) {
+            return 0;
+        }
+        codePoint = codePoint << 6 | (next & 0x3F);
+    }
+    return length;
+}
+
+// Kod Shift JIS znaku, jeśli mieści się w zakresach trybu Kanji; 0 w p.p.
+uint16_t kanjiCode(QStringEncoder& encoder, uint32_t codePoint)
+{
+    const char32_t character = codePoint;
+    encoder.resetState();
+    const QByteArray encoded = encoder.encode(QString::fromUcs4(&character, 1));
+    if (encoder.hasError() || encoded.size() != 2) {
+        return 0;
+    }
+    const uint16_t code = static_cast<uint16_t>(static_cast<unsigned char>(encoded[0]) << 8 |
+                                                static_cast<unsigned char>(encoded[1]));
+    const bool inRange = (code >= 0x8140 && code <= 0x9FFC) || (code >= 0xE040 && code <= 0xEBBF);
+    return inRange ? code : 0;
+}
+
+std::vector<Character> splitCharacters(const std::string& data, bool allowKanji)
+{
+    QStringEncoder encoder;
+    if (allowKanji) {
+        encoder = QStringEncoder("Shift_JIS", QStringConverter::Flag::Stateless);
+    }
+    const bool kanji = allowKanji && encoder.isValid();
+
+    std::vector<Character> characters;
+    characters.reserve(data.size());
+    for (size_t i = 0; i < data.size();) {
+        Character character;
+        character.offset = static_cast<uint32_t>(i);
+        uint32_t codePoint = 0;
+        const int length = decodeUtf8(data, i, codePoint);
+        if (length == 0) {
+            // Niepoprawny UTF-8 - pojedynczy bajt w trybie Byte
+            character.length = 1;
+        } else {
+            character.length = static_cast<uint8_t>(length);
+            if (length == 1) {
+                const char c = static_cast<char>(codePoint);
+                character.numeric = c >= '0' && c <= '9';
+                character.alphanumeric = isAlphanumeric(c);
+            } else if (kanji) {
+                character.kanji = kanjiCode(encoder, codePoint);
+            }
+        }
+        characters.push_back(character);
+        i += character.length;
+    }
+    return characters;
+}
+
+// Segmenty o najmniejszej długości dla zakresu wersji, do którego należy version
+std::vector<Segment> optimalSegments(const std::vector<Character>& characters, const std::string& data, int version)
+{
+    constexpr long kUnreachable = -1;
+
+    std::array<long, kModeCount> headCost{};
+    for (int mode = 0; mode < kModeCount; mode++) {
+        headCost[mode] = (4 + qrspec::characterCountBits(static_cast<SegmentMode>(mode), version)) * 6;
+    }
+
+    // from[i][m] - tryb znaku i, jeśli po nim bieżącym segmentem jest m
+    const size_t count = characters.size();
+    std::vector<std::array<int8_t, kModeCount>> from(count);
+    std::array<long, kModeCount> cost = headCost;
+
+    for (size_t i = 0; i < count; i++) {
+        const Character& character = characters[i];
+        std::array<long, kModeCount> next;
+        next.fill(kUnreachable);
+        from[i].fill(-1);
+
+        const auto extend = [&](SegmentMode mode, long charCost) {
+            const int m = static_cast<int>(mode);
+            next[m] = cost[m] + charCost;
+            from[i][m] = static_cast<int8_t>(m);
+        };
+        extend(SegmentMode::Byte, static_cast<long>(kByteCost) * character.length);
+        if (character.alphanumeric) {
+            extend(SegmentMode::Alphanumeric, kAlphanumericCost);
+        }
+        if (character.numeric) {
+            extend(SegmentMode::Numeric, kNumericCost);
+        }
+        if (character.kanji) {
+            extend(SegmentMode::Kanji, kKanjiCost);
+        }
+
+        // Zamknięcie segmentu po znaku i (dopełnienie do pełnego bitu)
+        // i otwarcie nowego w innym trybie
+        const std::array<long, kModeCount> ended = next;
+        const std::array<int8_t, kModeCount> endedMode = from[i];
+        for (int to = 0; to < kModeCount; to++) {
+            for (int mode = 0; mode < kModeCount; mode++) {
+                if (endedMode[mode] < 0 || mode == to) {
+                    continue;
+                }
+                const long switched = (ended[mode] + 5) / 6 * 6 + headCost[to];
+                if (next[to] == kUnreachable || switched < next[to]) {
+                    next[to] = switched;
+                    from[i][to] = endedMode[mode];
+                }
+            }
+        }
+        cost = next;
+    }
+
+    int mode = static_cast<int>(SegmentMode::Byte);
+    for (int m = 0; m < kModeCount; m++) {
+        if (cost[m] != kUnreachable && cost[m] < cost[mode]) {
+            mode = m;
+        }
+    }
+
+    // Odtworzenie trybów od końca i scalenie sąsiednich znaków w segmenty
+    std::vector<int8_t> modes(count);
+    for (size_t i = count; i-- > 0;) {
+        mode = from[i][mode];
+        modes[i] = static_cast<int8_t>(mode);
+    }
+
+    std::vector<Segment> segments;
+    for (size_t i = 0; i < count; i++) {
+        const SegmentMode segmentMode = static_cast<SegmentMode>(modes[i]);
+        if (segments.empty() || segments.back().mode != segmentMode) {
+            segments.push_back(Segment{segmentMode, std::string()});
+        }
+        std::string& target = segments.back().data;
+        if (segmentMode == SegmentMode::Kanji) {
+            target += static_cast<char>(characters[i].kanji >> 8);
+            target += static_cast<char>(characters[i].kanji & 0xFF);
+        } else {
+            target.append(data, characters[i].offset, characters[i].length);
+        }
+    }
+    return segments;
+}
+
+} // namespace
+
+SegmentPlan planSegments(const std::string& data, const EncodeOptions& options, long reservedBits)
+{
+    SegmentPlan plan;
+    if (data.empty()) {
+        return plan;
+    }
+
+    std::string text = data;
+    if (!options.caseSensitive) {
+        for (char& c : text) {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+    }
+
+    const std::vector<Character> characters = splitCharacters(text, options.allowKanji);
+    for (int range = 0; range < qrspec::kVersionRanges; range++) {
+        int first = qrspec::kVersionRangeFirst[range];
+        int last = qrspec::kVersionRangeLast[range];
+        if (options.version > 0) {
+            if (qrspec::versionRange(options.version) != range) {
+                continue;
+            }
+            first = last = options.version;
+        }
+
+        std::vector<Segment> segments = optimalSegments(characters, text, first);
+        const long bits = detail::segmentsBitLength(segments, first);
+        const int version = bits < 0 ? 0 : qrspec::smallestVersion(bits + reservedBits, options.ecLevel, first, last);
+        if (version > 0) {
+            plan.segments = std::move(segments);
+            plan.version = version;
+            plan.bits = bits;
+            return plan;
+        }
+    }
+    return plan;
+}
+
+} // namespace qrcore
@@ -0,0 +1,189 @@
+#include "qrcore/serial_encoder.h"
+
+#include "qrcore/qr_tables.h"
+#include "qrcore/reed_solomon.h"
+#include "qrcore/segmenter.h"
+
+#include "encoder_internal.h"
+
+#include <algorithm>
+
+namespace qrcore {
+
+namespace {
+
+// Największa liczba cyfr licznika mieszcząca się w uint64_t
+constexpr int kMaxDigits = 19;
+
+// Licznik dopełniony zerami z lewej; pusty, gdy ma więcej cyfr niż digits
+std::string counterText(uint64_t number, int digits)
+{
+    std::string text(static_cast<size_t>(digits), '0');
+    for (int i = digits - 1; i >= 0 && number > 0; i--) {
+        text[i] = static_cast<char>('0' + number % 10);
+        number /= 10;
+    }
+    return number > 0 ? std::string() : text;
+}
+
+} // namespace
+
+SerialEncoder::SerialEncoder(const std::string& prefix, int digits, const EncodeOptions& options)
+    : m_prefix(prefix), m_digits(digits), m_options(options)
+{
+    if (digits < 1 || digits > kMaxDigits) {
+        return;
+    }
+
+    // Segmenty i wersja dla numeru 0 - każda cyfra ma ten sam koszt w każdym
+    // trybie, więc podział jest optymalny dla całej serii
+    const std::string text = prefix + counterText(0, digits);
+    if (options.optimizeSegments) {
+        const SegmentPlan plan = planSegments(text, options);
+        m_segments = plan.segments;
+        m_version = plan.version;
+    } else {
+        m_segments = {Segment{SegmentMode::Byte, text}};
+        m_version = options.version > 0 ? options.version : detail::chooseVersion(m_segments, options.ecLevel);
+    }
+    if (m_version == 0) {
+        return;
+    }
+
+    m_data = detail::makeDataCodewords(m_segments, m_version, options.ecLevel);
+    if (m_data.empty()) {
+        return;
+    }
+
+    // Układ bloków jak w interleaveCodewords: krótkie bloki pierwsze
+    const int levelIndex = qrspec::levelIndex(options.ecLevel);
+    const int blocks = qrspec::kEcBlocks[levelIndex][m_version];
+    const int total = qrspec::totalCodewords(m_version);
+    const int shortBlocks = blocks - total % blocks;
+    m_ecLength = qrspec::kEcCodewordsPerBlock[levelIndex][m_version];
+    const int shortDataLength = total / blocks - m_ecLength;
+
+    std::vector<int> offsets(blocks + 1, 0);
+    m_dataBlock.resize(m_data.size());
+    m_dataDistance.resize(m_data.size());
+    m_ec.resize(static_cast<size_t>(blocks) * m_ecLength);
+    for (int b = 0; b < blocks; b++) {
+        const int length = shortDataLength + (b >= shortBlocks ? 1 : 0);
+        offsets[b + 1] = offsets[b] + length;
+        for (int i = 0; i < length; i++) {
+            m_dataBlock[offsets[b] + i] = b;
+            m_dataDistance[offsets[b] + i] = length - 1 - i;
+        }
+        rsEncode(m_data.data() + offsets[b], static_cast<size_t>(length), m_ecLength, m_ec.data() + b * m_ecLength);
+    }
+
+    int position = 0;
+    m_dataPosition.resize(m_data.size());
+    for (int i = 0; i <= shortDataLength; i++) {
+        for (int b = 0; b < blocks; b++) {
+            if (i < offsets[b + 1] - offsets[b]) {
+                m_dataPosition[offsets[b] + i] = position++;
+            }
+        }
+    }
+    m_ecPosition.resize(m_ec.size());
+    for (int i = 0; i < m_ecLength; i++) {
+        for (int b = 0; b < blocks; b++) {
+            m_ecPosition[b * m_ecLength + i] = position++;
+        }
+    }
+
+    // EC(x^d) dla d = 0..najdłuższy blok: EC(1) to współczynniki generatora,
+    // kolejne - mnożenie przez x modulo generator
+    const int maxLength = shortDataLength + 1;
+    m_unitEc.resize(static_cast<size_t>(maxLength) * m_ecLength);
+    const uint8_t one = 1;
+    rsEncode(&one, 1, m_ecLength, m_unitEc.data());
+    for (int d = 1; d < maxLength; d++) {
+        const uint8_t* previous = m_unitEc.data() + (d - 1) * m_ecLength;
+        uint8_t* current = m_unitEc.data() + d * m_ecLength;
+        for (int j = 0; j < m_ecLength; j++) {
+            const uint8_t shifted = j + 1 < m_ecLength ? previous[j + 1] : 0;
+            current[j] = shifted ^ gf256::multiply(previous[0], m_unitEc[j]);
+        }
+    }
+
+    // Pierwszy symbol ustala maskę i słowo formatu dla całej serii
+    m_symbol = detail::buildSymbol(detail::symbolLayout(m_version),
+                                   detail::interleaveCodewords(m_data, m_version, options.ecLevel),
+                                   options.ecLevel, -1, options.parallelMasks, &m_mask);
+}
+
+std::string SerialEncoder::text(uint64_t number) const
+{
+    return m_prefix + counterText(number, m_digits);
+}
+
+bool SerialEncoder::encode(uint64_t number, std::vector<ModulePosition>* changed)
+{
+    const std::string counter = counterText(number, m_digits);
+    if (isNull() || counter.empty()) {
+        return false;
+    }
+
+    // Licznik zajmuje ostatnie bajty ostatnich segmentów (nigdy Kanji)
+    size_t remaining = counter.size();
+    for (auto segment = m_segments.rbegin(); segment != m_segments.rend() && remaining > 0; ++segment) {
+        const size_t count = std::min(remaining, segment->data.size());
+        segment->data.replace(segment->data.size() - count, count, counter, remaining - count, count);
+        remaining -= count;
+    }
+
+    const std::vector<uint8_t> data = detail::makeDataCodewords(m_segments, m_version, m_options.ecLevel);
+    if (data.size() != m_data.size()) {
+        return false;
+    }
+
+    // Zmienione słowa danych (słowa prefiksu są zawsze te same) i poprawka
+    // EC ich bloków: delta * EC(x^odległość)
+    std::vector<bool> dirtyBlocks(m_ec.size() / m_ecLength, false);
+    for (size_t i = 0; i < data.size(); i++) {
+        const uint8_t delta = data[i] ^ m_data[i];
+        if (delta == 0) {
+            continue;
+        }
+        const int block = m_dataBlock[i];
+        const uint8_t* unit = m_unitEc.data() + m_dataDistance[i] * m_ecLength;
+        uint8_t* ec = m_ec.data() + block * m_ecLength;
+        for (int j = 0; j < m_ecLength; j++) {
+            ec[j] ^= gf256::multiply(delta, unit[j]);
+        }
+        dirtyBlocks[block] = true;
+        setCodeword(m_dataPosition[i], data[i], changed);
+    }
+    for (size_t block = 0; block < dirtyBlocks.size(); block++) {
+        if (dirtyBlocks[block]) {
+            for (int j = 0; j < m_ecLength; j++) {
+                const size_t index = block * m_ecLength + j;
+                setCodeword(m_ecPosition[index], m_ec[index], changed);
+            }
+        }
+    }
+    m_data = data;
+    return true;
+}
+
+void SerialEncoder::setCodeword(int index, uint8_t value, std::vector<ModulePosition>* changed)
+{
+    const detail::SymbolLayout& layout = detail::symbolLayout(m_version);
+    const QRMatrix& mask = layout.masks[m_mask];
+    for (int bit = 0; bit < 8; bit++) {
+        const uint32_t module = layout.dataOrder[static_cast<size_t>(index) * 8 + bit];
+        const int x = static_cast<int>(module % layout.size);
+        const int y = static_cast<int>(module / layout.size);
+        const bool dark = (((value >> (7 - bit)) & 1) != 0) != mask.module(x, y);
+        if (m_symbol.module(x, y) != dark) {
+            m_symbol.setModule(x, y, dark);
+            if (changed) {
+                changed->push_back(ModulePosition{x, y});
+            }
+        }
+    }
+}
+
+} // namespace qrcore
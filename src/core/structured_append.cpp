@@ -0,0 +1,224 @@
+#include "qrcore/structured_append.h"
+
+#include "qrcore/qr_tables.h"
+
+#include <opencv2/core.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+namespace qrcore {
+
+namespace {
+
+// Początki znaków UTF-8 (bajty inne niż kontynuacje 10xxxxxx) i koniec danych
+std::vector<size_t> characterBoundaries(const std::string& data)
+{
+    std::vector<size_t> boundaries;
+    for (size_t i = 0; i < data.size(); i++) {
+        if ((static_cast<unsigned char>(data[i]) & 0xC0) != 0x80) {
+            boundaries.push_back(i);
+        }
+    }
+    boundaries.push_back(data.size());
+    return boundaries;
+}
+
+// Wiadomość z kompletu części w kolejności numerów; false, gdy parzystość
+// nagłówka nie zgadza się z danymi (części różnych wiadomości)
+bool assemble(const std::vector<const DecodeResult*>& parts, int parity, DecodeResult& message)
+{
+    int dataParity = 0;
+    std::string text;
+    for (const DecodeResult* part : parts) {
+        dataParity ^= part->structuredAppend.dataParity;
+        text += part->text;
+    }
+    if (dataParity != parity) {
+        return false;
+    }
+    message = DecodeResult();
+    message.text = std::move(text);
+    message.corners = parts.front()->corners;
+    return true;
+}
+
+} // namespace
+
+std::vector<SegmentPlan> splitStructuredAppend(const std::string& data, int maxVersion, const EncodeOptions& options)
+{
+    if (data.empty() || maxVersion < qrspec::kMinVersion || maxVersion > qrspec::kMaxVersion) {
+        return {};
+    }
+
+    EncodeOptions planOptions = options;
+    planOptions.version = 0;
+    auto planFor = [&](size_t begin, size_t end) {
+        SegmentPlan plan = planSegments(data.substr(begin, end - begin), planOptions, kStructuredAppendHeaderBits);
+        if (plan.version > maxVersion) {
+            plan.version = 0;
+        }
+        return plan;
+    };
+
+    // Liczba znaków części ograniczona pojemnością (najtańsze są cyfry:
+    // 10 bitów na 3), dalej wyszukiwanie binarne najdłuższego prefiksu -
+    // długość optymalnego podziału rośnie monotonicznie z długością tekstu
+    const long capacity = qrspec::kDataCapacityBits.bits[qrspec::levelIndex(options.ecLevel)][maxVersion];
+    const size_t maxCharacters = static_cast<size_t>(capacity * 3 / 10 + 1);
+    const std::vector<size_t> boundaries = characterBoundaries(data);
+    const size_t characters = boundaries.size() - 1;
+
+    std::vector<SegmentPlan> parts;
+    for (size_t first = 0; first < characters;) {
+        if (parts.size() == kMaxStructuredAppendSymbols) {
+            return {};
+        }
+        size_t low = 0;
+        size_t high = std::min(characters - first, maxCharacters);
+        SegmentPlan best;
+        while (low < high) {
+            const size_t middle = (low + high + 1) / 2;
+            SegmentPlan plan = planFor(boundaries[first], boundaries[first + middle]);
+            if (plan.version > 0) {
+                low = middle;
+                best = std::move(plan);
+            } else {
+                high = middle - 1;
+            }
+        }
+        if (low == 0) {
+            return {};
+        }
+        parts.push_back(std::move(best));
+        first += low;
+    }
+
+    // Parzystość z bajtów segmentów (dla Kanji - bajtów Shift JIS), tak jak
+    // liczy ją czytnik
+    uint8_t parity = 0;
+    for (const SegmentPlan& part : parts) {
+        for (const Segment& segment : part.segments) {
+            for (char c : segment.data) {
+                parity ^= static_cast<uint8_t>(c);
+            }
+        }
+    }
+
+    const int total = static_cast<int>(parts.size());
+    for (int i = 0; i < total; i++) {
+        const char header[] = {static_cast<char>(total), static_cast<char>(i + 1), static_cast<char>(parity)};
+        parts[i].segments.insert(parts[i].segments.begin(), Segment{SegmentMode::StructuredAppend, std::string(header, 3)});
+        parts[i].bits += kStructuredAppendHeaderBits;
+    }
+    return parts;
+}
+
+std::vector<QRMatrix> encodeStructuredAppend(const std::string& data, int maxVersion, const EncodeOptions& options,
+                                             bool parallel)
+{
+    const std::vector<SegmentPlan> parts = splitStructuredAppend(data, maxVersion, options);
+    std::vector<QRMatrix> symbols(parts.size());
+    std::atomic<bool> failed{false};
+
+    auto worker = [&](const cv::Range& range) {
+        for (int i = range.start; i < range.end; i++) {
+            EncodeOptions partOptions = options;
+            partOptions.version = parts[i].version;
+            symbols[i] = encodeSegments(parts[i].segments, partOptions);
+            if (symbols[i].isNull()) {
+                failed = true;
+            }
+        }
+    };
+
+    if (parallel && parts.size() > 1) {
+        cv::parallel_for_(cv::Range(0, static_cast<int>(parts.size())), worker);
+    } else {
+        worker(cv::Range(0, static_cast<int>(parts.size())));
+    }
+
+    if (failed) {
+        return {};
+    }
+    return symbols;
+}
+
+StructuredAppendCollector::Progress StructuredAppendCollector::add(const DecodeResult& result)
+{
+    const StructuredAppendInfo& info = result.structuredAppend;
+    if (!info.isValid() || info.total < 1 || info.total > kMaxStructuredAppendSymbols || info.index >= info.total) {
+        return Progress();
+    }
+
+    Series& series = m_series[{info.total, info.parity}];
+    series.parts.resize(static_cast<size_t>(info.total));
+    DecodeResult& slot = series.parts[info.index];
+    if (!slot.structuredAppend.isValid()) {
+        slot = result;
+        series.received++;
+    }
+    return Progress{series.received, info.total};
+}
+
+bool StructuredAppendCollector::takeComplete(DecodeResult& message)
+{
+    for (auto it = m_series.begin(); it != m_series.end();) {
+        const Series& series = it->second;
+        if (series.received < static_cast<int>(series.parts.size())) {
+            ++it;
+            continue;
+        }
+
+        std::vector<const DecodeResult*> parts;
+        for (const DecodeResult& part : series.parts) {
+            parts.push_back(&part);
+        }
+        const bool assembled = assemble(parts, it->first.second, message);
+        it = m_series.erase(it);
+        if (assembled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<DecodeResult> mergeStructuredAppend(const std::vector<DecodeResult>& results)
+{
+    // Części pogrupowane według serii (liczba symboli, parzystość)
+    std::map<std::pair<int, int>, std::vector<const DecodeResult*>> series;
+    for (const DecodeResult& result : results) {
+        const StructuredAppendInfo& info = result.structuredAppend;
+        if (info.isValid() && info.total <= kMaxStructuredAppendSymbols && info.index < info.total) {
+            std::vector<const DecodeResult*>& parts = series[{info.total, info.parity}];
+            parts.resize(static_cast<size_t>(info.total), nullptr);
+            if (!parts[info.index]) {
+                parts[info.index] = &result;
+            }
+        }
+    }
+
+    std::map<std::pair<int, int>, DecodeResult> messages;
+    for (const auto& [key, parts] : series) {
+        DecodeResult message;
+        if (std::find(parts.begin(), parts.end(), nullptr) == parts.end() && assemble(parts, key.second, message)) {
+            messages.emplace(key, std::move(message));
+        }
+    }
+
+    std::vector<DecodeResult> merged;
+    for (const DecodeResult& result : results) {
+        const std::pair<int, int> key(result.structuredAppend.total, result.structuredAppend.parity);
+        const auto message = result.structuredAppend.isValid() ? messages.find(key) : messages.end();
+        if (message == messages.end()) {
+            merged.push_back(result);
+        } else if (!message->second.text.empty()) {
+            // Pierwsza część serii - dalsze części są już w wiadomości
+            merged.push_back(std::move(message->second));
+            message->second.text.clear();
+        }
+    }
+    return merged;
+}
+
+} // namespace qrcore
@@ -0,0 +1,38 @@
+#include "qrcore/symbol_cache.h"
+
+namespace qrcore {
+
+namespace {
+
+// Przybliżony narzut wpisu (węzeł listy, indeks, liczniki shared_ptr)
+constexpr size_t kEntryOverhead = 128;
+
+} // namespace
+
+SymbolCache::SymbolCache(size_t budgetBytes)
+    : m_cache(budgetBytes)
+{
+}
+
+std::shared_ptr<const QRMatrix> SymbolCache::encode(const std::string& data, const EncodeOptions& options)
+{
+    SymbolKey key{data, options};
+
+    std::shared_ptr<const QRMatrix> matrix;
+    if (m_cache.find(key, matrix)) {
+        return matrix;
+    }
+
+    // Kodowanie poza blokadą - równoległe chybienia nie czekają na siebie
+    QRMatrix encoded = qrcore::encode(data, options);
+    if (encoded.isNull()) {
+        return nullptr;
+    }
+
+    const size_t cost = encoded.byteSize() + data.size() * 2 + kEntryOverhead;
+    matrix = std::make_shared<const QRMatrix>(std::move(encoded));
+    m_cache.insert(key, matrix, cost);
+    return matrix;
+}
+
+} // namespace qrcore
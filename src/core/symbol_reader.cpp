@@ -0,0 +1,347 @@
+#include "qrcore/symbol_reader.h"
+
+#include "qrcore/qr_tables.h"
+#include "qrcore/reed_solomon.h"
+
+#include "encoder_internal.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QStringDecoder>
+
+#include <algorithm>
+#include <bitset>
+#include <vector>
+
+namespace qrcore {
+
+namespace {
+
+// Największa odległość Hamminga, przy której słowo formatu jest jeszcze
+// jednoznaczne (minimalna odległość kodu BCH(15,5) to 7)
+constexpr int kMaxFormatErrors = 3;
+
+const char kAlphanumericCharset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+
+// Czytnik bitów (MSB pierwszy) z kontrolą końca danych
+class BitReader
+{
+public:
+    explicit BitReader(const std::vector<uint8_t>& bytes) : m_bytes(bytes) {}
+
+    size_t available() const { return m_bytes.size() * 8 - m_position; }
+
+    bool read(int bits, uint32_t& value)
+    {
+        if (bits < 0 || static_cast<size_t>(bits) > available()) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < bits; i++, m_position++) {
+            value = value << 1 | ((m_bytes[m_position / 8] >> (7 - m_position % 8)) & 1);
+        }
+        return true;
+    }
+
+private:
+    const std::vector<uint8_t>& m_bytes;
+    size_t m_position = 0;
+};
+
+// Poziom i maska ze słowa formatu najbliższego odczytanym kopiom
+bool decodeFormat(const QRMatrix& grid, ErrorCorrection& level, int& mask)
+{
+    const std::array<uint32_t, 2> copies = detail::readFormat(grid);
+    int best = kMaxFormatErrors + 1;
+    for (int index = 0; index < 4; index++) {
+        for (int m = 0; m < 8; m++) {
+            const ErrorCorrection candidate = static_cast<ErrorCorrection>(index);
+            const uint32_t bits = qrspec::formatBits(candidate, m);
+            for (uint32_t copy : copies) {
+                const int distance = static_cast<int>(std::bitset<15>(bits ^ copy).count());
+                if (distance < best) {
+                    best = distance;
+                    level = candidate;
+                    mask = m;
+                }
+            }
+        }
+    }
+    return best <= kMaxFormatErrors;
+}
+
+// Słowa danych po korekcji: odczyt w kolejności rozmieszczenia, zdjęcie
+// maski i rozplecenie bloków (odwrotność interleaveCodewords)
+bool readCodewords(const QRMatrix& grid, const detail::SymbolLayout& layout, ErrorCorrection level, int mask,
+                   std::vector<uint8_t>& data, int& corrected)
+{
+    const int version = layout.version;
+    const int total = qrspec::totalCodewords(version);
+    std::vector<uint8_t> codewords(static_cast<size_t>(total), 0);
+    const QRMatrix& pattern = layout.masks[mask];
+    for (size_t bit = 0; bit < codewords.size() * 8; bit++) {
+        const uint32_t module = layout.dataOrder[bit];
+        const int x = static_cast<int>(module % layout.size);
+        const int y = static_cast<int>(module / layout.size);
+        if (grid.module(x, y) != pattern.module(x, y)) {
+            codewords[bit / 8] |= static_cast<uint8_t>(0x80 >> (bit % 8));
+        }
+    }
+
+    const int levelIndex = qrspec::levelIndex(level);
+    const int blocks = qrspec::kEcBlocks[levelIndex][version];
+    const int ecLength = qrspec::kEcCodewordsPerBlock[levelIndex][version];
+    const int shortBlocks = blocks - total % blocks;
+    const int shortDataLength = total / blocks - ecLength;
+
+    std::vector<std::vector<uint8_t>> blockData(static_cast<size_t>(blocks));
+    for (int b = 0; b < blocks; b++) {
+        blockData[b].resize(static_cast<size_t>(shortDataLength + (b >= shortBlocks ? 1 : 0) + ecLength));
+    }
+    size_t position = 0;
+    for (int i = 0; i <= shortDataLength; i++) {
+        for (int b = 0; b < blocks; b++) {
+            if (i < static_cast<int>(blockData[b].size()) - ecLength) {
+                blockData[b][i] = codewords[position++];
+            }
+        }
+    }
+    for (int i = 0; i < ecLength; i++) {
+        for (int b = 0; b < blocks; b++) {
+            blockData[b][blockData[b].size() - ecLength + i] = codewords[position++];
+        }
+    }
+
+    data.clear();
+    corrected = 0;
+    for (std::vector<uint8_t>& block : blockData) {
+        const int errors = rsDecode(block.data(), block.size(), ecLength);
+        if (errors < 0) {
+            return false;
+        }
+        corrected += errors;
+        data.insert(data.end(), block.begin(), block.end() - ecLength);
+    }
+    return true;
+}
+
+// Znaki Shift JIS z trybu Kanji jako UTF-8; bez konwertera - surowe bajty
+void appendShiftJis(const std::string& bytes, std::string& text)
+{
+    QStringDecoder decoder("Shift_JIS", QStringConverter::Flag::Stateless);
+    if (!decoder.isValid()) {
+        text += bytes;
+        return;
+    }
+    const QString decoded = decoder.decode(QByteArray::fromStdString(bytes));
+    text += decoded.toUtf8().toStdString();
+}
+
+// Rozbiór strumienia bitów na segmenty (ISO/IEC 18004, 7.4)
+bool parseSegments(const std::vector<uint8_t>& data, int version, SymbolContent& content)
+{
+    BitReader reader(data);
+    std::string text;
+    int parity = 0;
+    while (reader.available() >= 4) {
+        uint32_t mode = 0;
+        reader.read(4, mode);
+        if (mode == 0x0) {
+            break; // terminator
+        }
+
+        uint32_t count = 0;
+        uint32_t value = 0;
+        switch (mode) {
+            case 0x1: { // Numeric
+                if (!reader.read(qrspec::characterCountBits(SegmentMode::Numeric, version), count)) {
+                    return false;
+                }
+                for (; count > 0; count -= std::min<uint32_t>(count, 3)) {
+                    const int digits = static_cast<int>(std::min<uint32_t>(count, 3));
+                    if (!reader.read(digits * 3 + 1, value) || value >= (digits == 3 ? 1000u : digits == 2 ? 100u : 10u)) {
+                        return false;
+                    }
+                    char group[3];
+                    for (int i = digits - 1; i >= 0; i--, value /= 10) {
+                        group[i] = static_cast<char>('0' + value % 10);
+                    }
+                    for (int i = 0; i < digits; i++) {
+                        parity ^= static_cast<unsigned char>(group[i]);
+                    }
+                    text.append(group, static_cast<size_t>(digits));
+                }
+                break;
+            }
+
+            case 0x2: { // Alphanumeric
+                if (!reader.read(qrspec::characterCountBits(SegmentMode::Alphanumeric, version), count)) {
+                    return false;
+                }
+                for (; count > 0; count -= std::min<uint32_t>(count, 2)) {
+                    char pair[2];
+                    int length = 1;
+                    if (count >= 2) {
+                        if (!reader.read(11, value) || value >= 45 * 45) {
+                            return false;
+                        }
+                        pair[0] = kAlphanumericCharset[value / 45];
+                        pair[1] = kAlphanumericCharset[value % 45];
+                        length = 2;
+                    } else {
+                        if (!reader.read(6, value) || value >= 45) {
+                            return false;
+                        }
+                        pair[0] = kAlphanumericCharset[value];
+                    }
+                    for (int i = 0; i < length; i++) {
+                        parity ^= static_cast<unsigned char>(pair[i]);
+                        text += pair[i];
+                    }
+                }
+                break;
+            }
+
+            case 0x4: { // Byte
+                if (!reader.read(qrspec::characterCountBits(SegmentMode::Byte, version), count)) {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; i++) {
+                    if (!reader.read(8, value)) {
+                        return false;
+                    }
+                    parity ^= static_cast<int>(value);
+                    text += static_cast<char>(value);
+                }
+                break;
+            }
+
+            case 0x8: { // Kanji - 13 bitów na znak Shift JIS
+                if (!reader.read(qrspec::characterCountBits(SegmentMode::Kanji, version), count)) {
+                    return false;
+                }
+                std::string bytes;
+                for (uint32_t i = 0; i < count; i++) {
+                    if (!reader.read(13, value)) {
+                        return false;
+                    }
+                    uint32_t code = (value / 0xC0) << 8 | (value % 0xC0);
+                    code += code < 0x1F00 ? 0x8140 : 0xC140;
+                    bytes += static_cast<char>(code >> 8);
+                    bytes += static_cast<char>(code & 0xFF);
+                    parity ^= static_cast<int>((code >> 8) ^ (code & 0xFF));
+                }
+                appendShiftJis(bytes, text);
+                break;
+            }
+
+            case 0x3: { // Structured Append - numer, liczba symboli, parzystość
+                uint32_t index = 0;
+                uint32_t total = 0;
+                uint32_t messageParity = 0;
+                if (!reader.read(4, index) || !reader.read(4, total) || !reader.read(8, messageParity) ||
+                    index > total) {
+                    return false;
+                }
+                content.structuredAppend.index = static_cast<int>(index);
+                content.structuredAppend.total = static_cast<int>(total) + 1;
+                content.structuredAppend.parity = static_cast<int>(messageParity);
+                break;
+            }
+
+            case 0x7: { // ECI - desygnator 8, 16 lub 24 bity; bajty przekazywane bez zmian
+                if (!reader.read(8, value)) {
+                    return false;
+                }
+                const int extra = (value & 0x80) == 0 ? 0 : ((value & 0xC0) == 0x80 ? 8 : 16);
+                if (!reader.read(extra, value)) {
+                    return false;
+                }
+                break;
+            }
+
+            case 0x5: // FNC1 na pierwszej pozycji - bez pól
+                break;
+
+            case 0x9: // FNC1 na drugiej pozycji - identyfikator aplikacji
+                if (!reader.read(8, value)) {
+                    return false;
+                }
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    content.text = std::move(text);
+    content.structuredAppend.dataParity = parity;
+    return true;
+}
+
+bool readOriented(const QRMatrix& grid, SymbolContent& content)
+{
+    const int version = (grid.size() - 17) / 4;
+    if (version < qrspec::kMinVersion || version > qrspec::kMaxVersion || grid.size() != version * 4 + 17) {
+        return false;
+    }
+
+    SymbolContent result;
+    result.version = version;
+    if (!decodeFormat(grid, result.ecLevel, result.mask)) {
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    if (!readCodewords(grid, detail::symbolLayout(version), result.ecLevel, result.mask, data,
+                       result.correctedCodewords) ||
+        !parseSegments(data, version, result)) {
+        return false;
+    }
+    content = std::move(result);
+    return true;
+}
+
+} // namespace
+
+QRMatrix gridFromStraight(const cv::Mat& straight)
+{
+    if (straight.empty() || straight.rows != straight.cols || straight.type() != CV_8UC1) {
+        return QRMatrix();
+    }
+    const int size = straight.rows;
+    if (size < 21 || size > 177 || (size - 17) % 4 != 0) {
+        return QRMatrix();
+    }
+
+    QRMatrix grid(size, (size - 17) / 4);
+    for (int y = 0; y < size; y++) {
+        const uint8_t* row = straight.ptr<uint8_t>(y);
+        for (int x = 0; x < size; x++) {
+            if (row[x] < 128) {
+                grid.setModule(x, y, true);
+            }
+        }
+    }
+    return grid;
+}
+
+bool readSymbol(const QRMatrix& grid, SymbolContent& content)
+{
+    if (grid.isNull()) {
+        return false;
+    }
+    return readOriented(grid, content) || readOriented(detail::transposed(grid), content);
+}
+
+void readStructuredAppend(const cv::Mat& straight, DecodeResult& result)
+{
+    SymbolContent content;
+    if (!readSymbol(gridFromStraight(straight), content) || !content.structuredAppend.isValid()) {
+        return;
+    }
+    result.structuredAppend = content.structuredAppend;
+    result.text = std::move(content.text);
+}
+
+} // namespace qrcore
@@ -0,0 +1,150 @@
+#include "qrcore/thread_pool.h"
+
+#include <QtCore/QDebug>
+
+#include <chrono>
+#include <exception>
+
+namespace qrcore {
+
+namespace {
+
+// Pula i indeks kolejki bieżącego wątku roboczego
+thread_local const void* t_pool = nullptr;
+thread_local size_t t_index = 0;
+
+} // namespace
+
+int defaultThreadCount()
+{
+    const unsigned cores = std::thread::hardware_concurrency();
+    return cores > 0 ? static_cast<int>(cores) : 1;
+}
+
+ThreadPool::ThreadPool(int threads)
+{
+    if (threads <= 0) {
+        threads = defaultThreadCount();
+    }
+
+    for (int i = 0; i < threads; i++) {
+        m_queues.emplace_back(new WorkerQueue);
+    }
+    for (int i = 0; i < threads; i++) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    // Z wnętrza puli - do własnej kolejki; z zewnątrz - po kolei do wszystkich
+    const size_t index = (t_pool == this)
+        ? t_index
+        : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+    ++m_pending;
+    {
+        WorkerQueue& queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    ++m_queued;
+
+    // Pusta sekcja krytyczna zapobiega zgubieniu pobudki przez zasypiający wątek
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_idle.wait(lock, [this]() { return m_pending.load() == 0; });
+}
+
+bool ThreadPool::popLocal(size_t index, std::function<void()>& task)
+{
+    WorkerQueue& queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, std::function<void()>& task)
+{
+    const size_t count = m_queues.size();
+    for (size_t offset = 1; offset < count; offset++) {
+        WorkerQueue& queue = *m_queues[(thief + offset) % count];
+        std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.tasks.empty()) {
+            continue;
+        }
+
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        ++m_stolen;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+    t_pool = this;
+    t_index = index;
+
+    for (;;) {
+        std::function<void()> task;
+        if (popLocal(index, task) || steal(index, task)) {
+            --m_queued;
+            // Wyjątek zadania nie może zakończyć wątku (std::terminate) ani
+            // zostawić m_pending powyżej zera - wait() czekałby w nieskończoność
+            try {
+                task();
+            } catch (const std::exception& e) {
+                ++m_failed;
+                qWarning() << "Wyjątek w zadaniu puli wątków:" << e.what();
+            } catch (...) {
+                ++m_failed;
+                qWarning() << "Nieznany wyjątek w zadaniu puli wątków";
+            }
+
+            if (--m_pending == 0) {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        if (m_stopping && m_queued.load() == 0) {
+            return;
+        }
+        // Krótki limit czasu: kradzież przez try_lock mogła ominąć zajętą kolejkę
+        m_wake.wait_for(lock, std::chrono::milliseconds(10),
+                        [this]() { return m_stopping || m_queued.load() > 0; });
+    }
+}
+
+} // namespace qrcore
@@ -0,0 +1,274 @@
+#include "qrcore/vector_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace qrcore {
+
+namespace {
+
+// Kierunki krawędzi w kolejności zgodnej z ruchem wskazówek zegara (oś Y w dół)
+enum Direction { Right = 0, Down = 1, Left = 2, Up = 3 };
+constexpr int kStepX[4] = {1, 0, -1, 0};
+constexpr int kStepY[4] = {0, 1, 0, -1};
+
+// Liczba w zapisie dziesiętnym niezależnym od locale (deterministyczna)
+std::string number(double value)
+{
+    if (value == std::floor(value) && std::fabs(value) < 1e15) {
+        return std::to_string(static_cast<long long>(value));
+    }
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.4f", value);
+    std::string text = buffer;
+    text.erase(text.find_last_not_of('0') + 1);
+    if (!text.empty() && text.back() == '.') {
+        text.pop_back();
+    }
+    std::replace(text.begin(), text.end(), ',', '.');
+    return text;
+}
+
+// Strumień liczący zapisane bajty (przesunięcia obiektów w tablicy xref PDF)
+class CountingWriter
+{
+public:
+    explicit CountingWriter(std::ostream& output) : m_output(output) {}
+
+    CountingWriter& operator<<(const std::string& text)
+    {
+        m_output.write(text.data(), static_cast<std::streamsize>(text.size()));
+        m_count += text.size();
+        return *this;
+    }
+
+    uint64_t count() const { return m_count; }
+
+private:
+    std::ostream& m_output;
+    uint64_t m_count = 0;
+};
+
+} // namespace
+
+void traceOutlines(const QRMatrix& matrix,
+                   const std::function<void(const std::vector<OutlinePoint>&)>& polygon)
+{
+    if (matrix.isNull()) {
+        return;
+    }
+
+    const int size = matrix.size();
+    const int width = size + 1;
+    auto dark = [&](int x, int y) {
+        return x >= 0 && y >= 0 && x < size && y < size && matrix.module(x, y);
+    };
+
+    // Krawędzie wychodzące z każdego wierzchołka siatki (bity kierunków).
+    // Krawędź istnieje tylko między modułem ciemnym a jasnym.
+    std::vector<uint8_t> outgoing(static_cast<size_t>(width) * width, 0);
+    auto vertex = [&](int x, int y) -> uint8_t& { return outgoing[static_cast<size_t>(y) * width + x]; };
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            if (!matrix.module(x, y)) {
+                continue;
+            }
+            if (!dark(x, y - 1)) vertex(x, y) |= 1 << Right;
+            if (!dark(x + 1, y)) vertex(x + 1, y) |= 1 << Down;
+            if (!dark(x, y + 1)) vertex(x + 1, y + 1) |= 1 << Left;
+            if (!dark(x - 1, y)) vertex(x, y + 1) |= 1 << Up;
+        }
+    }
+
+    std::vector<OutlinePoint> corners;
+    for (int startY = 0; startY < width; startY++) {
+        for (int startX = 0; startX < width; startX++) {
+            while (vertex(startX, startY) != 0) {
+                // Pierwszy dostępny kierunek startowy
+                int direction = 0;
+                while (!(vertex(startX, startY) & (1 << direction))) {
+                    direction++;
+                }
+                const int startDirection = direction;
+
+                corners.clear();
+                int x = startX;
+                int y = startY;
+                for (;;) {
+                    vertex(x, y) &= static_cast<uint8_t>(~(1 << direction));
+                    x += kStepX[direction];
+                    y += kStepY[direction];
+
+                    if (x == startX && y == startY) {
+                        break;
+                    }
+
+                    // W wierzchołku stykających się narożnikami modułów są dwie
+                    // krawędzie wyjściowe - skręt w prawo oddziela te moduły
+                    const uint8_t options = vertex(x, y);
+                    const int right = (direction + 1) & 3;
+                    const int left = (direction + 3) & 3;
+                    int next = direction;
+                    if (options & (1 << right)) {
+                        next = right;
+                    } else if (options & (1 << direction)) {
+                        next = direction;
+                    } else {
+                        next = left;
+                    }
+
+                    if (next != direction) {
+                        corners.push_back({x, y});
+                    }
+                    direction = next;
+                }
+
+                // Punkt startowy jest narożnikiem, jeśli kontur skręca w nim
+                if (direction != startDirection) {
+                    corners.insert(corners.begin(), OutlinePoint{startX, startY});
+                }
+                polygon(corners);
+            }
+        }
+    }
+}
+
+bool vectorFormatForPath(const std::string& path, VectorFormat& format)
+{
+    const size_t dot = path.rfind('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+
+    std::string extension = path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (extension == "svg") {
+        format = VectorFormat::Svg;
+    } else if (extension == "pdf") {
+        format = VectorFormat::Pdf;
+    } else if (extension == "eps") {
+        format = VectorFormat::Eps;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool writeVector(const QRMatrix& matrix, VectorFormat format, std::ostream& output, const VectorOptions& options)
+{
+    if (matrix.isNull() || options.border < 0 || options.moduleSize <= 0.0) {
+        return false;
+    }
+
+    const int border = options.border;
+    const int fullSize = matrix.size() + 2 * border;
+    const double pageSize = fullSize * options.moduleSize;
+    const std::string page = number(pageSize);
+    const std::string modules = std::to_string(fullSize);
+
+    if (format == VectorFormat::Svg) {
+        CountingWriter out(output);
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\"" + page + "\" height=\"" + page +
+               "\" viewBox=\"0 0 " + modules + " " + modules + "\" shape-rendering=\"crispEdges\">\n";
+        if (options.background) {
+            out << "<rect width=\"" + modules + "\" height=\"" + modules + "\" fill=\"#ffffff\"/>\n";
+        }
+
+        // Ścieżka złożona wyłącznie z odcinków H/V (jeden znak + liczba)
+        out << "<path fill=\"#000000\" d=\"";
+        traceOutlines(matrix, [&](const std::vector<OutlinePoint>& corners) {
+            std::string d = "M" + std::to_string(corners[0].x + border) + " " + std::to_string(corners[0].y + border);
+            for (size_t i = 1; i < corners.size(); i++) {
+                if (corners[i].y == corners[i - 1].y) {
+                    d += "H" + std::to_string(corners[i].x + border);
+                } else {
+                    d += "V" + std::to_string(corners[i].y + border);
+                }
+            }
+            out << d + "Z";
+        });
+        out << "\"/>\n</svg>\n";
+        return static_cast<bool>(output);
+    }
+
+    // Współrzędne w modułach; odwrócenie osi Y przekształceniem macierzowym
+    const std::string scale = number(options.moduleSize);
+    auto pathCommands = [&](CountingWriter& out, const char* move, const char* line, const char* close) {
+        traceOutlines(matrix, [&](const std::vector<OutlinePoint>& corners) {
+            std::string commands;
+            for (size_t i = 0; i < corners.size(); i++) {
+                commands += std::to_string(corners[i].x + border) + " " + std::to_string(corners[i].y + border) +
+                            (i == 0 ? move : line);
+            }
+            out << commands + close;
+        });
+    };
+
+    if (format == VectorFormat::Eps) {
+        CountingWriter out(output);
+        const std::string bounding = std::to_string(static_cast<long long>(std::ceil(pageSize)));
+        out << "%!PS-Adobe-3.0 EPSF-3.0\n"
+            << "%%BoundingBox: 0 0 " + bounding + " " + bounding + "\n"
+            << "%%HiResBoundingBox: 0 0 " + page + " " + page + "\n"
+            << "%%Creator: QR Generator\n%%EndComments\n"
+            << "/m {moveto} bind def /l {lineto} bind def /h {closepath} bind def\n"
+            << "gsave\n0 " + page + " translate " + scale + " -" + scale + " scale\n";
+        if (options.background) {
+            out << "1 setgray 0 0 " + modules + " " + modules + " rectfill\n";
+        }
+        out << "0 setgray newpath\n";
+        pathCommands(out, " m\n", " l\n", "h\n");
+        out << "fill\ngrestore\nshowpage\n%%EOF\n";
+        return static_cast<bool>(output);
+    }
+
+    // PDF: długość strumienia treści jest obiektem pośrednim zapisanym po
+    // strumieniu, dzięki czemu treść powstaje jednoprzebiegowo
+    CountingWriter out(output);
+    std::vector<uint64_t> offsets;
+
+    out << "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n";
+    offsets.push_back(out.count());
+    out << "1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj\n";
+    offsets.push_back(out.count());
+    out << "2 0 obj\n<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n";
+    offsets.push_back(out.count());
+    out << "3 0 obj\n<< /Type /Page /Parent 2 0 R /MediaBox [0 0 " + page + " " + page +
+           "] /Resources << >> /Contents 4 0 R >>\nendobj\n";
+    offsets.push_back(out.count());
+    out << "4 0 obj\n<< /Length 5 0 R >>\nstream\n";
+
+    const uint64_t streamStart = out.count();
+    out << "q " + scale + " 0 0 -" + scale + " 0 " + page + " cm\n";
+    if (options.background) {
+        out << "1 g 0 0 " + modules + " " + modules + " re f\n";
+    }
+    out << "0 g\n";
+    pathCommands(out, " m\n", " l\n", "h\n");
+    out << "f\nQ";
+    // Znak końca wiersza przed endstream nie należy do strumienia (PDF 7.3.8)
+    const uint64_t streamLength = out.count() - streamStart;
+
+    out << "\nendstream\nendobj\n";
+    offsets.push_back(out.count());
+    out << "5 0 obj\n" + std::to_string(streamLength) + "\nendobj\n";
+
+    const uint64_t xrefOffset = out.count();
+    out << "xref\n0 " + std::to_string(offsets.size() + 1) + "\n0000000000 65535 f \n";
+    for (uint64_t offset : offsets) {
+        char entry[32];
+        std::snprintf(entry, sizeof(entry), "%010llu 00000 n \n", static_cast<unsigned long long>(offset));
+        out << entry;
+    }
+    out << "trailer\n<< /Size " + std::to_string(offsets.size() + 1) + " /Root 1 0 R >>\nstartxref\n" +
+           std::to_string(xrefOffset) + "\n%%EOF\n";
+    return static_cast<bool>(output);
+}
+
+} // namespace qrcore
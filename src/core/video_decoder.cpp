@@ -0,0 +1,307 @@
+#include "qrcore/video_decoder.h"
+
+#include "qrcore/decoder_backend.h"
+#include "qrcore/thread_pool.h"
+
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace qrcore {
+
+namespace {
+
+// Zakres klatek [begin, end); end < 0 - do końca pliku (liczba klatek
+// z kontenera bywa przybliżona, więc ostatni segment czyta do EOF)
+struct VideoSegment {
+    int64_t begin = 0;
+    int64_t end = -1;
+};
+
+struct SegmentResult {
+    std::vector<VideoCodeRecord> records;
+    int64_t frames = 0;
+    int64_t decodedFrames = 0;
+};
+
+std::vector<VideoSegment> makeSegments(int64_t frameCount, double fps, const VideoDecodeOptions& options, int threads)
+{
+    std::vector<VideoSegment> segments;
+    if (frameCount <= 0 || fps <= 0.0) {
+        segments.push_back(VideoSegment());
+        return segments;
+    }
+
+    // Kilka segmentów na wątek wyrównuje obciążenie, ale żaden nie jest
+    // krótszy niż segmentSeconds - każdy otwiera plik i przewija
+    const int64_t minimum = std::max<int64_t>(1, static_cast<int64_t>(options.segmentSeconds * fps));
+    const int64_t count = std::max<int64_t>(1, std::min<int64_t>(frameCount / minimum, threads * 4));
+    const int64_t length = (frameCount + count - 1) / count;
+    for (int64_t begin = 0; begin < frameCount; begin += length) {
+        segments.push_back(VideoSegment{begin, begin + length});
+    }
+    segments.back().end = -1;
+    return segments;
+}
+
+// Numery klatek kluczowych z pakietów kontenera, bez dekodowania obrazu
+// (FFmpeg w trybie surowym zwraca z grab() pakiety i oznacza te, od których
+// zaczyna się GOP). Pusty wynik - backend nie podaje tej informacji.
+std::vector<int64_t> keyFrames(const std::string& path, const std::atomic<bool>* cancel)
+{
+    std::vector<int64_t> frames;
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 7)
+    cv::VideoCapture packets(path, cv::CAP_FFMPEG, {cv::CAP_PROP_FORMAT, -1});
+    if (!packets.isOpened()) {
+        return frames;
+    }
+    for (int64_t index = 0; packets.grab(); index++) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            break;
+        }
+        if (packets.get(cv::CAP_PROP_LRF_HAS_KEY_FRAME) != 0.0) {
+            frames.push_back(index);
+        }
+    }
+#else
+    (void)path;
+    (void)cancel;
+#endif
+    return frames;
+}
+
+// Przesuwa granice segmentów na klatki kluczowe - przewinięcie nie rozpakowuje
+// wtedy klatek poprzedniego GOP. Bez listy klatek kluczowych granica jest
+// sprawdzana przewinięciem, a segment zaczyna się tam, gdzie backend stanął
+// (CAP_PROP_POS_FRAMES). Nagranie, którego nie da się przewinąć, jest jednym
+// segmentem czytanym po kolei.
+std::vector<VideoSegment> alignSegments(const std::vector<VideoSegment>& segments, const std::vector<int64_t>& keys,
+                                        cv::VideoCapture& probe)
+{
+    std::vector<int64_t> starts{0};
+    for (size_t i = 1; i < segments.size(); i++) {
+        int64_t start = segments[i].begin;
+        if (!keys.empty()) {
+            // Najbliższa klatka kluczowa
+            auto next = std::lower_bound(keys.begin(), keys.end(), start);
+            if (next == keys.end() || (next != keys.begin() && start - *std::prev(next) <= *next - start)) {
+                --next;
+            }
+            start = *next;
+        } else {
+            if (!probe.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(start))) {
+                return {VideoSegment()};
+            }
+            start = static_cast<int64_t>(probe.get(cv::CAP_PROP_POS_FRAMES));
+        }
+        // Dwie granice na tej samej klatce kluczowej - jeden segment
+        if (start > starts.back()) {
+            starts.push_back(start);
+        }
+    }
+
+    std::vector<VideoSegment> aligned;
+    for (size_t i = 0; i < starts.size(); i++) {
+        aligned.push_back(VideoSegment{starts[i], i + 1 < starts.size() ? starts[i + 1] : -1});
+    }
+    return aligned;
+}
+
+// Odstęp, po którym ta sama treść jest nowym rekordem: nie mniejszy niż
+// odstęp dekodowanych klatek (z zapasem pół klatki na zaokrąglenia czasu),
+// inaczej przy rzadkim próbkowaniu każda klatka byłaby osobnym rekordem
+double effectiveGap(const VideoDecodeOptions& options, double fps)
+{
+    if (fps <= 0.0) {
+        return options.mergeGap;
+    }
+    return std::max(options.mergeGap, (std::max(1, options.frameStep) + 0.5) / fps);
+}
+
+void decodeSegment(const std::string& path, const VideoSegment& segment, double fps,
+                   const VideoDecodeOptions& options, const std::atomic<bool>& cancelled, SegmentResult& output)
+{
+    cv::VideoCapture capture(path);
+    if (!capture.isOpened()) {
+        return;
+    }
+
+    // Przewijanie sprawdziło już alignSegments - bez niego jest tylko jeden segment
+    int64_t index = segment.begin;
+    if (index > 0 && !capture.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(index))) {
+        qWarning() << "Nie można przewinąć nagrania do klatki" << index;
+        return;
+    }
+
+    DecoderCascade cascade;
+    cv::Mat frame;
+    cv::Mat gray;
+    std::map<std::string, size_t> open; // treść -> ostatni rekord tej treści
+    std::set<std::string> inFrame;       // treści już policzone w bieżącej klatce
+    const int step = std::max(1, options.frameStep);
+    const double gap = effectiveGap(options, fps);
+
+    for (; segment.end < 0 || index < segment.end; index++) {
+        if (cancelled.load(std::memory_order_relaxed) ||
+            (options.cancel && options.cancel->load(std::memory_order_relaxed))) {
+            return;
+        }
+        if (index % step != 0) {
+            if (!capture.grab()) {
+                break;
+            }
+            output.frames++;
+            continue;
+        }
+        if (!capture.read(frame) || frame.empty()) {
+            break;
+        }
+        output.frames++;
+
+        switch (frame.channels()) {
+            case 3:
+                cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+                break;
+            case 4:
+                cv::cvtColor(frame, gray, cv::COLOR_BGRA2GRAY);
+                break;
+            default:
+                gray = frame;
+                break;
+        }
+
+        const std::vector<DecodeResult> results = cascade.decode(gray, options.multiple);
+        output.decodedFrames++;
+        if (results.empty()) {
+            continue;
+        }
+
+        const double timestamp = fps > 0.0 ? index / fps : capture.get(cv::CAP_PROP_POS_MSEC) / 1000.0;
+        inFrame.clear();
+        for (const DecodeResult& result : results) {
+            // Dwie jednakowe etykiety w kadrze to jedno wystąpienie w tej klatce
+            if (!inFrame.insert(result.text).second) {
+                continue;
+            }
+
+            auto it = open.find(result.text);
+            if (it != open.end() && timestamp - output.records[it->second].lastSeen <= gap) {
+                VideoCodeRecord& record = output.records[it->second];
+                record.lastSeen = timestamp;
+                record.frames++;
+                continue;
+            }
+
+            VideoCodeRecord record;
+            record.timestamp = timestamp;
+            record.lastSeen = timestamp;
+            record.frame = index;
+            record.frames = 1;
+            record.payload = result.text;
+            record.polygon = result.corners;
+            open[result.text] = output.records.size();
+            output.records.push_back(std::move(record));
+        }
+    }
+}
+
+// Łączy rekordy tej samej treści rozcięte granicą segmentów
+std::vector<VideoCodeRecord> mergeRecords(std::vector<VideoCodeRecord> records, double gap)
+{
+    std::sort(records.begin(), records.end(), [](const VideoCodeRecord& a, const VideoCodeRecord& b) {
+        return a.payload != b.payload ? a.payload < b.payload : a.frame < b.frame;
+    });
+
+    std::vector<VideoCodeRecord> merged;
+    for (VideoCodeRecord& record : records) {
+        if (!merged.empty() && merged.back().payload == record.payload &&
+            record.timestamp - merged.back().lastSeen <= gap) {
+            merged.back().lastSeen = std::max(merged.back().lastSeen, record.lastSeen);
+            merged.back().frames += record.frames;
+            continue;
+        }
+        merged.push_back(std::move(record));
+    }
+
+    std::sort(merged.begin(), merged.end(), [](const VideoCodeRecord& a, const VideoCodeRecord& b) {
+        return a.frame != b.frame ? a.frame < b.frame : a.payload < b.payload;
+    });
+    return merged;
+}
+
+} // namespace
+
+std::vector<VideoCodeRecord> decodeVideoFile(const std::string& path, const VideoDecodeOptions& options,
+                                             VideoDecodeStats* stats)
+{
+    VideoDecodeStats local;
+    VideoDecodeStats& summary = stats ? *stats : local;
+    summary = VideoDecodeStats();
+    const auto start = std::chrono::steady_clock::now();
+
+    ThreadPool pool(options.threads);
+    int64_t frameCount = 0;
+    double fps = 0.0;
+    std::vector<VideoSegment> segments;
+    {
+        cv::VideoCapture probe(path);
+        if (!probe.isOpened()) {
+            qWarning() << "Nie można otworzyć nagrania:" << path.c_str();
+            return {};
+        }
+        frameCount = static_cast<int64_t>(probe.get(cv::CAP_PROP_FRAME_COUNT));
+        fps = probe.get(cv::CAP_PROP_FPS);
+        segments = makeSegments(frameCount, fps, options, pool.threadCount());
+        if (segments.size() > 1) {
+            segments = alignSegments(segments, keyFrames(path, options.cancel), probe);
+        }
+    }
+    std::vector<SegmentResult> results(segments.size());
+    std::atomic<bool> cancelled{false};
+    std::mutex progressMutex;
+    int done = 0;
+
+    for (size_t i = 0; i < segments.size(); i++) {
+        pool.submit([&, i]() {
+            try {
+                decodeSegment(path, segments[i], fps, options, cancelled, results[i]);
+            } catch (const std::exception& e) {
+                qWarning() << "Błąd dekodowania segmentu nagrania:" << e.what();
+            }
+
+            std::lock_guard<std::mutex> lock(progressMutex);
+            ++done;
+            if (options.progress && !options.progress(done, static_cast<int>(segments.size()))) {
+                cancelled = true;
+            }
+        });
+    }
+    pool.wait();
+
+    std::vector<VideoCodeRecord> records;
+    for (SegmentResult& result : results) {
+        summary.frames += result.frames;
+        summary.decodedFrames += result.decodedFrames;
+        std::move(result.records.begin(), result.records.end(), std::back_inserter(records));
+    }
+
+    summary.segments = static_cast<int>(segments.size());
+    if (fps > 0.0) {
+        summary.duration = (frameCount > 0 ? frameCount : summary.frames) / fps;
+    }
+    summary.cancelled = cancelled.load() || (options.cancel && options.cancel->load());
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return mergeRecords(std::move(records), effectiveGap(options, fps));
+}
+
+} // namespace qrcore
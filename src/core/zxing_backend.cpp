@@ -0,0 +1,82 @@
+#include "qrcore/decoder_backend.h"
+
+#include "decoder_internal.h"
+
+#include <ZXing/ReadBarcode.h>
+
+#include <cstdlib>
+
+namespace qrcore {
+
+namespace {
+
+class ZxingBackend : public DecoderBackend
+{
+public:
+    ZxingBackend()
+    {
+        m_options.setFormats(ZXing::BarcodeFormat::QRCode);
+        m_options.setTryHarder(true);
+        m_options.setTryRotate(true);
+    }
+
+    const char* name() const override { return "zxing"; }
+
+    std::vector<DecodeResult> decode(const cv::Mat& gray, bool multiple) override
+    {
+        std::vector<DecodeResult> results;
+        if (gray.empty() || gray.type() != CV_8UC1) {
+            return results;
+        }
+
+        // Widok na bufor cv::Mat - bez kopiowania pikseli
+        const ZXing::ImageView view(gray.data, gray.cols, gray.rows, ZXing::ImageFormat::Lum,
+                                    static_cast<int>(gray.step));
+        m_options.setMaxNumberOfSymbols(multiple ? 0xFF : 1);
+
+        for (const auto& barcode : ZXing::ReadBarcodes(view, m_options)) {
+            if (!barcode.isValid() || barcode.text().empty()) {
+                continue;
+            }
+
+            DecodeResult result;
+            result.text = barcode.text();
+            const ZXing::Position& position = barcode.position();
+            for (const ZXing::PointI& point :
+                 {position.topLeft(), position.topRight(), position.bottomRight(), position.bottomLeft()}) {
+                result.corners.emplace_back(static_cast<float>(point.x), static_cast<float>(point.y));
+            }
+
+            // ZXing udostępnia nagłówek Structured Append (identyfikator serii
+            // QR to parzystość zapisana dziesiętnie); parzystość danych
+            // liczymy z bajtów segmentów, tak jak czytnik siatki
+            if (barcode.sequenceSize() > 1 && barcode.sequenceIndex() >= 0) {
+                StructuredAppendInfo& info = result.structuredAppend;
+                info.index = barcode.sequenceIndex();
+                info.total = barcode.sequenceSize();
+                info.parity = std::atoi(barcode.sequenceId().c_str());
+                for (uint8_t byte : barcode.bytes()) {
+                    info.dataParity ^= byte;
+                }
+            }
+            results.push_back(std::move(result));
+        }
+        return results;
+    }
+
+private:
+    ZXing::ReaderOptions m_options;
+};
+
+} // namespace
+
+namespace detail {
+
+std::unique_ptr<DecoderBackend> createZxingBackend()
+{
+    return std::make_unique<ZxingBackend>();
+}
+
+} // namespace detail
+
+} // namespace qrcore
@@ -1,7 +1,13 @@
 #include "qrgenerator.h"
+#include "cli_commands.h"
 
 int main(int argc, char *argv[])
 {
+    // Tryb wiersza poleceń działa bez QApplication (np. na serwerze bez X/Wayland)
+    if (cli::isCliInvocation(argc, argv)) {
+        return cli::run(argc, argv);
+    }
+    
     QApplication app(argc, argv);
     
     // Ustawienia aplikacji
@@ -2,14 +2,43 @@
 
 // Implementacja metod generowania kodów QR
 
+namespace {
+
+// Symbole serii Structured Append ułożone w siatce (wierszami, w kolejności numerów)
+QImage composeSymbols(const std::vector<qrcore::QRMatrix>& symbols)
+{
+    std::vector<QImage> images;
+    int cell = 0;
+    for (const qrcore::QRMatrix& symbol : symbols) {
+        images.push_back(qrcore::renderImage(symbol));
+        cell = qMax(cell, qMax(images.back().width(), images.back().height()));
+    }
+    
+    const int count = static_cast<int>(images.size());
+    int columns = 1;
+    while (columns * columns < count) {
+        ++columns;
+    }
+    const int rows = (count + columns - 1) / columns;
+    QImage composite(columns * cell, rows * cell, QImage::Format_RGB32);
+    composite.fill(Qt::white);
+    
+    QPainter painter(&composite);
+    for (int i = 0; i < count; ++i) {
+        const QImage& image = images[i];
+        painter.drawImage((i % columns) * cell + (cell - image.width()) / 2,
+                          (i / columns) * cell + (cell - image.height()) / 2, image);
+    }
+    return composite;
+}
+
+} // namespace
+
 void QRGenerator::generateUrlQR()
 {
-    QString url = m_urlEdit->text().trimmed();
+    // Protokół https:// jest dodawany, jeśli go brakuje
+    QString url = qrcore::urlPayload(m_urlEdit->text().trimmed());
     if (!url.isEmpty()) {
-        // Dodaj protokół jeśli brakuje
-        if (!url.startsWith("http://") && !url.startsWith("https://")) {
-            url = "https://" + url;
-        }
         generateQRCode(url);
     } else {
         clearQR();
@@ -48,125 +77,160 @@ void QRGenerator::generateWiFiQR()
 
 void QRGenerator::generateQRCode(const QString& data)
 {
+    // Każde wywołanie (np. naciśnięcie klawisza) unieważnia poprzednie żądania.
+    // Zapamiętujemy tylko najnowsze dane - pośrednie stany nie są renderowane.
+    ++m_previewRequestId;
+    m_pendingPreviewData = data;
+    m_previewData = data;
+    m_previewPending = true;
+    
+    if (!m_previewWatcher->isRunning()) {
+        startPreviewJob();
+    }
+}
+
+void QRGenerator::startPreviewJob()
+{
+    const QString data = m_pendingPreviewData;
+    const QSize targetSize = m_qrLabel->size();
+    const int maxVersion = m_maxVersionSpin->value();
+    const quint64 requestId = m_previewRequestId.load();
+    const std::atomic<quint64>* latestRequest = &m_previewRequestId;
+    qrcore::SymbolCache* symbolCache = &m_symbolCache;
+    PreviewImageCache* imageCache = &m_previewCache;
+    
+    m_previewPending = false;
+    m_pendingPreviewData.clear();
+    
+    // Kodowanie, rasteryzacja i skalowanie poza wątkiem GUI
+    m_previewWatcher->setFuture(QtConcurrent::run([=]() {
+        return renderPreview(data, targetSize, maxVersion, requestId, latestRequest, symbolCache, imageCache);
+    }));
+}
+
+PreviewResult QRGenerator::renderPreview(const QString& data, const QSize& targetSize, int maxVersion,
+                                         quint64 requestId, const std::atomic<quint64>* latestRequest,
+                                         qrcore::SymbolCache* symbolCache, PreviewImageCache* imageCache)
+{
+    PreviewResult result;
+    result.requestId = requestId;
+    
+    // Pomiędzy etapami sprawdzamy, czy żądanie nie zostało zastąpione nowszym
+    auto superseded = [&]() {
+        result.cancelled = latestRequest->load(std::memory_order_relaxed) != requestId;
+        return result.cancelled;
+    };
+    
+    if (superseded()) {
+        return result;
+    }
+    
     try {
-        // Utworzenie kodu QR przy użyciu libqrencode
-        QRcode* qrCode = QRcode_encodeString(data.toUtf8().constData(), 
-                                           0, // wersja (0 = auto)
-                                           QR_ECLEVEL_M, // poziom korekcji błędów
-                                           QR_MODE_8, // tryb kodowania
-                                           1); // case sensitive
+        const std::string payload = data.toUtf8().toStdString();
         
-        if (!qrCode) {
-            showError("Nie można wygenerować kodu QR");
-            return;
+        // Gotowy podgląd dla tej samej treści i rozmiaru (np. powrót do zakładki)
+        const std::string imageKey = std::to_string(targetSize.width()) + "x" +
+                                     std::to_string(targetSize.height()) + "|v" +
+                                     std::to_string(maxVersion) + "|" + payload;
+        PreviewResult cached;
+        if (imageCache->find(imageKey, cached)) {
+            result.fullImage = cached.fullImage;
+            result.scaledImage = cached.scaledImage;
+            result.matrix = cached.matrix;
+            result.symbolCount = cached.symbolCount;
+            return result;
         }
         
-        // Konwersja do QPixmap
-        int qrSize = qrCode->width;
-        int scale = 8; // skalowanie pikseli
-        int border = 4; // ramka
-        int imageSize = (qrSize + 2 * border) * scale;
-        
-        QImage qrImage(imageSize, imageSize, QImage::Format_RGB32);
-        qrImage.fill(Qt::white);
+        // Kodowanie (lub macierz z pamięci podręcznej) w bibliotece qrcore
+        std::shared_ptr<const qrcore::QRMatrix> matrix = symbolCache->encode(payload);
+        if (superseded()) {
+            return result;
+        }
         
-        // Rysowanie kodu QR
-        for (int y = 0; y < qrSize; y++) {
-            for (int x = 0; x < qrSize; x++) {
-                if (qrCode->data[y * qrSize + x] & 1) {
-                    // Czarny piksel
-                    for (int dy = 0; dy < scale; dy++) {
-                        for (int dx = 0; dx < scale; dx++) {
-                            int px = (x + border) * scale + dx;
-                            int py = (y + border) * scale + dy;
-                            if (px < imageSize && py < imageSize) {
-                                qrImage.setPixel(px, py, qRgb(0, 0, 0));
-                            }
-                        }
-                    }
-                }
+        if (matrix && matrix->version() <= maxVersion) {
+            result.matrix = matrix;
+            
+            // Symbol w skali 8 z ramką 4 moduły
+            result.fullImage = qrcore::renderImage(*matrix);
+        } else {
+            // Treść przekracza maksymalną wersję (lub pojemność QR) - seria
+            // symboli Structured Append kodowanych równolegle
+            const std::vector<qrcore::QRMatrix> symbols = qrcore::encodeStructuredAppend(payload, maxVersion);
+            if (symbols.empty() || superseded()) {
+                return result;
             }
+            result.symbolCount = static_cast<int>(symbols.size());
+            result.fullImage = composeSymbols(symbols);
+        }
+        if (superseded()) {
+            return result;
         }
-        
-        // Zwolnienie pamięci
-        QRcode_free(qrCode);
-        
-        // Konwersja do pixmap i wyświetlenie
-        m_currentQR = QPixmap::fromImage(qrImage);
         
         // Skalowanie do rozmiaru labela z zachowaniem proporcji
-        QPixmap scaledQR = m_currentQR.scaled(m_qrLabel->size(), 
-                                            Qt::KeepAspectRatio, 
-                                            Qt::SmoothTransformation);
-        
-        m_qrLabel->setPixmap(scaledQR);
+        result.scaledImage = result.fullImage.scaled(targetSize, 
+                                                     Qt::KeepAspectRatio, 
+                                                     Qt::SmoothTransformation);
         
+        imageCache->insert(imageKey, result,
+                           result.fullImage.sizeInBytes() + result.scaledImage.sizeInBytes() + imageKey.size());
     } catch (const std::exception& e) {
-        showError(QString("Błąd podczas generowania QR: %1").arg(e.what()));
+        qWarning() << "Błąd podczas generowania QR:" << e.what();
+        result.fullImage = QImage();
     }
+    
+    return result;
 }
 
-QString QRGenerator::generateVCard() const
+void QRGenerator::onPreviewFinished()
 {
-    QString firstName = m_firstNameEdit->text().trimmed();
-    QString lastName = m_lastNameEdit->text().trimmed();
-    QString phone = m_phoneEdit->text().trimmed();
-    QString email = m_emailEdit->text().trimmed();
-    QString company = m_companyEdit->text().trimmed();
-    QString website = m_websiteEdit->text().trimmed();
-    
-    // Sprawdź czy są jakieś dane
-    if (firstName.isEmpty() && lastName.isEmpty() && phone.isEmpty() && 
-        email.isEmpty() && company.isEmpty() && website.isEmpty()) {
-        return QString();
+    // W trakcie pracy nadeszły nowe dane - wynik jest nieaktualny,
+    // od razu renderujemy najnowsze żądanie
+    if (m_previewPending) {
+        startPreviewJob();
+        return;
     }
     
-    // Generuj vCard
-    QString vcard = "BEGIN:VCARD\n";
-    vcard += "VERSION:3.0\n";
+    const PreviewResult result = m_previewWatcher->result();
     
-    if (!firstName.isEmpty() || !lastName.isEmpty()) {
-        QString fullName = (firstName + " " + lastName).trimmed();
-        vcard += "FN:" + fullName + "\n";
-        vcard += "N:" + lastName + ";" + firstName + ";;;\n";
+    // Żądanie anulowane (np. przez clearQR) lub zastąpione nowszym
+    if (result.cancelled || result.requestId != m_previewRequestId.load()) {
+        return;
     }
     
-    if (!phone.isEmpty()) {
-        vcard += "TEL:" + phone + "\n";
+    if (result.fullImage.isNull()) {
+        showError("Nie można wygenerować kodu QR");
+        return;
     }
     
-    if (!email.isEmpty()) {
-        vcard += "EMAIL:" + email + "\n";
-    }
-    
-    if (!company.isEmpty()) {
-        vcard += "ORG:" + company + "\n";
-    }
-    
-    if (!website.isEmpty()) {
-        vcard += "URL:" + website + "\n";
-    }
-    
-    vcard += "END:VCARD";
+    // Konwersja do pixmap i wyświetlenie (QPixmap tylko w wątku GUI)
+    m_currentQR = QPixmap::fromImage(result.fullImage);
+    m_currentMatrix = result.matrix;
+    m_qrLabel->setPixmap(QPixmap::fromImage(result.scaledImage));
+    m_qrLabel->setToolTip(result.symbolCount > 1
+        ? QString("Treść podzielona na %1 symboli Structured Append (zapis tylko jako PNG)").arg(result.symbolCount)
+        : QString());
+}
+
+QString QRGenerator::generateVCard() const
+{
+    qrcore::ContactData contact;
+    contact.firstName = m_firstNameEdit->text().trimmed();
+    contact.lastName = m_lastNameEdit->text().trimmed();
+    contact.phone = m_phoneEdit->text().trimmed();
+    contact.email = m_emailEdit->text().trimmed();
+    contact.company = m_companyEdit->text().trimmed();
+    contact.website = m_websiteEdit->text().trimmed();
     
-    return vcard;
+    return qrcore::vCardPayload(contact);
 }
 
 QString QRGenerator::generateWiFiString() const
 {
-    QString ssid = m_wifiSSIDEdit->text().trimmed();
-    if (ssid.isEmpty()) {
-        return QString();
-    }
-    
-    QString password = m_wifiPasswordEdit->text();
-    QString security = m_wifiSecurityCombo->currentText();
-    QString hidden = m_wifiHiddenCheck->isChecked() ? "true" : "false";
+    qrcore::WiFiData wifi;
+    wifi.ssid = m_wifiSSIDEdit->text().trimmed();
+    wifi.password = m_wifiPasswordEdit->text();
+    wifi.security = m_wifiSecurityCombo->currentText();
+    wifi.hidden = m_wifiHiddenCheck->isChecked();
     
-    // Format: WIFI:T:WPA;S:mynetwork;P:mypass;H:false;;
-    return QString("WIFI:T:%1;S:%2;P:%3;H:%4;;")
-           .arg(security)
-           .arg(ssid)
-           .arg(password)
-           .arg(hidden);
+    return qrcore::wifiPayload(wifi);
 }
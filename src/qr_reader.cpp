@@ -2,6 +2,30 @@
 
 // Implementacja metod odczytu QR
 
+namespace {
+
+// Wielokąt kodu w czytelnej postaci: (x1,y1) (x2,y2) ...
+QString formatPolygon(const std::vector<cv::Point2f>& corners)
+{
+    QStringList points;
+    for (const cv::Point2f& point : corners) {
+        points << QString("(%1,%2)").arg(qRound(point.x)).arg(qRound(point.y));
+    }
+    return points.join(' ');
+}
+
+// Czas w nagraniu: mm:ss.zzz
+QString formatVideoTime(double seconds)
+{
+    const qint64 milliseconds = qRound64(seconds * 1000.0);
+    return QString("%1:%2.%3")
+        .arg(milliseconds / 60000, 2, 10, QChar('0'))
+        .arg(milliseconds / 1000 % 60, 2, 10, QChar('0'))
+        .arg(milliseconds % 1000, 3, 10, QChar('0'));
+}
+
+} // namespace
+
 void QRGenerator::readQRFromFile()
 {
     QString fileName = QFileDialog::getOpenFileName(this,
@@ -14,20 +38,25 @@ void QRGenerator::readQRFromFile()
     }
     
     try {
-        // Wczytanie obrazu przez OpenCV
-        cv::Mat image = cv::imread(fileName.toStdString());
+        // Zdjęcia JPEG są dekompresowane od razu w skali szarości i w pomniejszeniu
+        // (DCT), a pełna rozdzielczość jest wczytywana tylko w razie potrzeby.
+        // Zdjęcia półek i arkusze etykiet zawierają wiele kodów - zwróć wszystkie.
+        // Komplety części Structured Append są składane w jedną wiadomość.
+        qrcore::PhotoDecodeInfo info;
+        const std::vector<qrcore::DecodeResult> results =
+            qrcore::mergeStructuredAppend(qrcore::decodePhotoFile(fileName.toStdString(), {}, &info));
         
-        if (image.empty()) {
+        if (info.fullSize.empty()) {
             showError("Nie można wczytać pliku obrazu");
             return;
         }
         
-        QString result = decodeQRFromImage(image);
+        const QString source = "Plik: " + QFileInfo(fileName).fileName();
         
-        if (!result.isEmpty()) {
-            displayQRResult(result, "Plik: " + QFileInfo(fileName).fileName());
-        } else {
+        if (results.empty()) {
             displayQRResult("Nie znaleziono kodu QR w obrazie", "Błąd odczytu");
+        } else {
+            displayQRResults(results, source);
         }
         
     } catch (const std::exception& e) {
@@ -39,123 +68,233 @@ void QRGenerator::readQRFromCamera()
 {
     try {
         // Sprawdź czy kamera jest już włączona
-        if (m_cameraTimer->isActive()) {
+        if (m_cameraPipeline->isRunning()) {
             // Zatrzymaj kamerę
-            m_cameraTimer->stop();
-            m_camera.release();
-            m_readCameraButton->setText("Użyj kamery");
+            stopCamera();
             return;
         }
         
-        // Włącz kamerę
-        m_camera.open(0); // Domyślna kamera
-        
-        if (!m_camera.isOpened()) {
+        // Włącz kamerę - przechwytywanie i dekodowanie działają w osobnych wątkach
+        if (!m_cameraPipeline->start(0)) { // Domyślna kamera
             showError("Nie można otworzyć kamery");
             return;
         }
         
         m_readCameraButton->setText("Zatrzymaj kamerę");
         
-        // Uruchom timer do cyklicznego odczytu z kamery
-        m_cameraTimer->start(100); // Co 100ms
-        
-        // Funkcja wywoływana przez timer
-        connect(m_cameraTimer, &QTimer::timeout, [this]() {
-            cv::Mat frame;
-            m_camera >> frame;
-            
-            if (!frame.empty()) {
-                QString result = decodeQRFromImage(frame);
-                if (!result.isEmpty()) {
-                    // Znaleziono kod QR - zatrzymaj kamerę
-                    m_cameraTimer->stop();
-                    m_camera.release();
-                    m_readCameraButton->setText("Użyj kamery");
-                    
-                    displayQRResult(result, "Kamera");
-                }
-            }
-        });
-        
     } catch (const std::exception& e) {
         showError(QString("Błąd kamery: %1").arg(e.what()));
     }
 }
 
-void QRGenerator::readQRFromScreen()
+void QRGenerator::stopCamera()
 {
-    // Ukryj okno aplikacji na czas robienia zrzutu
-    hide();
-    
-    // Daj użytkownikowi czas na przygotowanie
-    QTimer::singleShot(1000, [this]() {
-        try {
-            // Zrób zrzut całego ekranu
-            QScreen* screen = QGuiApplication::primaryScreen();
-            QPixmap screenshot = screen->grabWindow(0);
-            
-            // Pokaż okno z powrotem
-            show();
-            
-            // Konwertuj QPixmap do cv::Mat
-            QImage qimage = screenshot.toImage();
-            qimage = qimage.convertToFormat(QImage::Format_RGB888);
-            
-            cv::Mat image(qimage.height(), qimage.width(), CV_8UC3, 
-                         (void*)qimage.constBits(), qimage.bytesPerLine());
-            cv::cvtColor(image, image, cv::COLOR_RGB2BGR);
-            
-            QString result = decodeQRFromImage(image);
-            
-            if (!result.isEmpty()) {
-                displayQRResult(result, "Zrzut ekranu");
-            } else {
-                displayQRResult("Nie znaleziono kodu QR na ekranie", "Błąd odczytu");
-            }
-            
-        } catch (const std::exception& e) {
-            show(); // Upewnij się, że okno jest widoczne
-            showError(QString("Błąd podczas robienia zrzutu ekranu: %1").arg(e.what()));
-        }
-    });
+    m_cameraPipeline->stop();
+    m_readCameraButton->setText("Użyj kamery");
+    
+    // Potok mógł zasilać odbiór transmisji animowanej
+    m_transferReceiving = false;
+    m_transferCameraButton->setText("Odbierz z kamery");
+    m_transferRecordingButton->setText("Odbierz z nagrania");
 }
 
-QString QRGenerator::decodeQRFromImage(const cv::Mat& image)
+void QRGenerator::onCameraCodeDecoded(const QByteArray& payload, const QPolygonF& corners)
+{
+    Q_UNUSED(corners);
+    
+    // Kilka dekoderów mogło znaleźć kod równocześnie - obsłuż tylko pierwszy wynik
+    if (!m_cameraPipeline->isRunning()) {
+        return;
+    }
+    
+    // Ramki transmisji animowanej - kamera działa do odebrania całego pliku
+    if (m_transferReceiving) {
+        handleTransferFrame(payload);
+        return;
+    }
+    
+    // Znaleziono kod QR (lub złożono całą serię Structured Append) - zatrzymaj kamerę
+    stopCamera();
+    displayQRResult(QString::fromUtf8(payload), "Kamera");
+}
+
+void QRGenerator::onCameraStructuredAppendProgress(int received, int total)
+{
+    // Pozostałe części serii mogą pojawić się w kolejnych klatkach - postęp
+    // na przycisku, kamera działa dalej
+    if (m_cameraPipeline->isRunning()) {
+        m_readCameraButton->setText(QString("Zatrzymaj kamerę (%1/%2)").arg(received).arg(total));
+    }
+}
+
+void QRGenerator::onCameraFailed(const QString& message)
+{
+    stopCamera();
+    showError(message);
+}
+
+void QRGenerator::onCameraSourceFinished()
+{
+    // Nagranie skończyło się przed odebraniem kompletu bloków
+    const bool receiving = m_transferReceiving;
+    stopCamera();
+    if (receiving && !m_fountainDecoder.isComplete()) {
+        showError(QString("Nagranie zakończyło się przed odebraniem całego pliku (bloki: %1/%2)")
+                      .arg(m_fountainDecoder.resolvedBlocks())
+                      .arg(m_fountainDecoder.blockCount()));
+    }
+}
+
+void QRGenerator::readQRFromScreen()
 {
     try {
-        // Tu powinna być implementacja dekodowania QR przy użyciu biblioteki ZXing
-        // Ponieważ ZXing-C++ może być skomplikowane w konfiguracji, 
-        // przedstawię uproszczoną wersję z użyciem OpenCV QRCodeDetector
-        
-        cv::QRCodeDetector qrDecoder;
+        // Zrzut wszystkich ekranów od razu - bez ukrywania okna i sztucznego opóźnienia
+        const QList<QScreen*> screens = QGuiApplication::screens();
+        std::vector<QImage> screenshots;
+        screenshots.reserve(screens.size());
         
-        // Próba dekodowania
-        std::string decodedText = qrDecoder.detectAndDecode(image);
-        
-        if (!decodedText.empty()) {
-            return QString::fromStdString(decodedText);
-        }
-        
-        // Jeśli nie udało się, spróbuj z konwersją do skali szarości
-        cv::Mat grayImage;
-        if (image.channels() > 1) {
-            cv::cvtColor(image, grayImage, cv::COLOR_BGR2GRAY);
-        } else {
-            grayImage = image;
+        for (QScreen* screen : screens) {
+            screenshots.push_back(screen->grabWindow(0).toImage());
         }
         
-        decodedText = qrDecoder.detectAndDecode(grayImage);
+        // Bufory QImage są opakowywane jako cv::Mat bez kopiowania (BGRA -> gray
+        // w jednym przebiegu), a każdy ekran jest dekodowany w osobnym wątku
+        const std::vector<std::vector<qrcore::DecodeResult>> results = qrcore::decodeImages(screenshots);
         
-        if (!decodedText.empty()) {
-            return QString::fromStdString(decodedText);
+        bool found = false;
+        for (int i = 0; i < screens.size(); ++i) {
+            if (results[i].empty()) {
+                continue;
+            }
+            
+            found = true;
+            const QString source = screens.size() > 1
+                ? QString("Zrzut ekranu %1 (%2)").arg(i + 1).arg(screens[i]->name())
+                : QString("Zrzut ekranu");
+            displayQRResults(qrcore::mergeStructuredAppend(results[i]), source);
         }
         
-        return QString(); // Nie znaleziono kodu QR
+        if (!found) {
+            displayQRResult("Nie znaleziono kodu QR na ekranie", "Błąd odczytu");
+        }
         
     } catch (const std::exception& e) {
-        qWarning() << "Błąd dekodowania QR:" << e.what();
-        return QString();
+        showError(QString("Błąd podczas robienia zrzutu ekranu: %1").arg(e.what()));
+    }
+}
+
+void QRGenerator::readQRFromVideo()
+{
+    // Drugie kliknięcie przerywa trwającą analizę
+    if (m_videoWatcher->isRunning()) {
+        m_videoScanCancelled = true;
+        m_readVideoButton->setText("Przerywanie...");
+        return;
+    }
+    
+    QString fileName = QFileDialog::getOpenFileName(this,
+        "Wybierz nagranie z kodami QR",
+        QStandardPaths::writableLocation(QStandardPaths::MoviesLocation),
+        "Pliki wideo (*.mp4 *.avi *.mkv *.mov *.webm)");
+    
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    // Segmenty nagrania są dekodowane równolegle w tle; postęp na przycisku
+    m_videoScanCancelled = false;
+    m_readVideoButton->setText("Przerwij analizę");
+    
+    // Flaga przerwania jest sprawdzana przed każdą klatką każdego segmentu
+    qrcore::VideoDecodeOptions options;
+    options.cancel = &m_videoScanCancelled;
+    options.progress = [this](int done, int total) {
+        QMetaObject::invokeMethod(this, [this, done, total]() {
+            if (m_videoWatcher->isRunning() && !m_videoScanCancelled) {
+                m_readVideoButton->setText(QString("Przerwij analizę (%1/%2)").arg(done).arg(total));
+            }
+        }, Qt::QueuedConnection);
+        return true;
+    };
+    
+    m_videoWatcher->setFuture(QtConcurrent::run([fileName, options]() {
+        VideoScanResult result;
+        result.fileName = fileName;
+        result.records = qrcore::decodeVideoFile(fileName.toStdString(), options, &result.stats);
+        return result;
+    }));
+}
+
+void QRGenerator::onVideoScanFinished()
+{
+    m_readVideoButton->setText("Analizuj nagranie");
+    
+    const VideoScanResult result = m_videoWatcher->result();
+    if (result.stats.frames == 0) {
+        showError("Nie można odczytać nagrania");
+        return;
+    }
+    
+    const QString source = "Nagranie: " + QFileInfo(result.fileName).fileName();
+    if (result.records.empty()) {
+        displayQRResult(result.stats.cancelled ? "Przerwano analizę nagrania"
+                                               : "Nie znaleziono kodu QR w nagraniu",
+                        "Błąd odczytu");
+        return;
+    }
+    
+    for (const qrcore::VideoCodeRecord& record : result.records) {
+        displayQRResult(QString::fromStdString(record.payload),
+                        QString("%1 - %2-%3 (klatek: %4), położenie %5")
+                            .arg(source)
+                            .arg(formatVideoTime(record.timestamp))
+                            .arg(formatVideoTime(record.lastSeen))
+                            .arg(record.frames)
+                            .arg(formatPolygon(record.polygon)));
+    }
+    
+    if (result.stats.cancelled) {
+        displayQRResult("Przerwano analizę - wyniki dotyczą tylko przetworzonych fragmentów", source);
+    }
+}
+
+QString QRGenerator::decodeQRFromImage(const cv::Mat& image)
+{
+    // Dekodowanie realizuje biblioteka qrcore; wszystkie symbole obrazu są
+    // odczytywane, by złożyć serię Structured Append w jedną wiadomość
+    const std::vector<qrcore::DecodeResult> results = qrcore::mergeStructuredAppend(qrcore::decodeMulti(image));
+    
+    if (!results.empty()) {
+        return QString::fromStdString(results.front().text);
+    }
+    
+    return QString(); // Nie znaleziono kodu QR
+}
+
+void QRGenerator::displayQRResults(const std::vector<qrcore::DecodeResult>& results, const QString& type)
+{
+    // Część serii Structured Append, której pozostałych symboli nie znaleziono
+    auto partLabel = [](const qrcore::DecodeResult& result) {
+        const qrcore::StructuredAppendInfo& info = result.structuredAppend;
+        return info.isValid()
+            ? QString(" (część %1/%2 serii Structured Append - brak pozostałych)").arg(info.index + 1).arg(info.total)
+            : QString();
+    };
+    
+    if (results.size() == 1) {
+        displayQRResult(QString::fromStdString(results.front().text), type + partLabel(results.front()));
+        return;
+    }
+    
+    for (size_t i = 0; i < results.size(); ++i) {
+        const qrcore::DecodeResult& result = results[i];
+        displayQRResult(QString::fromStdString(result.text),
+                        QString("%1 - kod %2/%3, położenie %4%5")
+                            .arg(type)
+                            .arg(i + 1)
+                            .arg(results.size())
+                            .arg(formatPolygon(result.corners))
+                            .arg(partLabel(result)));
     }
 }
 
@@ -1,7 +1,13 @@
 #include "qrgenerator.h"
 
 // Implementacja konstruktora
-QRGenerator::QRGenerator(QWidget *parent) : QMainWindow(parent), m_tabWidget(nullptr), m_qrLabel(nullptr), m_passwordVisible(false), m_cameraTimer(new QTimer(this))
+QRGenerator::QRGenerator(QWidget *parent) : QMainWindow(parent), m_tabWidget(nullptr), m_qrLabel(nullptr), m_maxVersionSpin(nullptr),
+    m_previewWatcher(new QFutureWatcher<PreviewResult>(this)), m_previewRequestId(0), m_previewPending(false),
+    m_previewCache(32 * 1024 * 1024),
+    m_passwordVisible(false),
+    m_videoWatcher(new QFutureWatcher<VideoScanResult>(this)), m_videoScanCancelled(false),
+    m_transferTimer(new QTimer(this)), m_transferSeed(0), m_transferReceiving(false),
+    m_cameraPipeline(new qrcore::CameraPipeline(this))
 {
     // Ustawienie podstawowych właściwości okna
     setWindowTitle("Generator Kodów QR - C++ Qt");
@@ -20,16 +26,35 @@ QRGenerator::QRGenerator(QWidget *parent) : QMainWindow(parent), m_tabWidget(nul
     // Ustawienie interfejsu użytkownika
     setupUI();
     
-    // Połączenie timera kamery
-    connect(m_cameraTimer, &QTimer::timeout, this, &QRGenerator::readQRFromCamera);
+    // Odbiór wyników podglądu generowanego w tle
+    connect(m_previewWatcher, &QFutureWatcher<PreviewResult>::finished, this, &QRGenerator::onPreviewFinished);
+    
+    // Odbiór wyników analizy nagrania
+    connect(m_videoWatcher, &QFutureWatcher<VideoScanResult>::finished, this, &QRGenerator::onVideoScanFinished);
+    
+    // Wyniki potoku kamery (jedno połączenie na cały czas życia okna)
+    connect(m_cameraPipeline, &qrcore::CameraPipeline::codeDecoded, this, &QRGenerator::onCameraCodeDecoded);
+    connect(m_cameraPipeline, &qrcore::CameraPipeline::structuredAppendProgress,
+            this, &QRGenerator::onCameraStructuredAppendProgress);
+    connect(m_cameraPipeline, &qrcore::CameraPipeline::captureFailed, this, &QRGenerator::onCameraFailed);
+    connect(m_cameraPipeline, &qrcore::CameraPipeline::sourceFinished, this, &QRGenerator::onCameraSourceFinished);
+    
+    // Kolejne ramki transmisji animowanej
+    connect(m_transferTimer, &QTimer::timeout, this, &QRGenerator::showNextTransferFrame);
 }
 
 QRGenerator::~QRGenerator()
 {
-    // Zwolnienie zasobów kamery
-    if (m_camera.isOpened()) {
-        m_camera.release();
-    }
+    // Przerwij i poczekaj na zadanie podglądu (korzysta z m_previewRequestId)
+    ++m_previewRequestId;
+    m_previewWatcher->waitForFinished();
+    
+    // Przerwij analizę nagrania (segmenty kończą się po bieżącej klatce)
+    m_videoScanCancelled = true;
+    m_videoWatcher->waitForFinished();
+    
+    // Zatrzymanie wątków kamery i zwolnienie urządzenia
+    m_cameraPipeline->stop();
     
     // Zapisanie konfiguracji WiFi
     saveWiFiNetworks();
@@ -66,6 +91,7 @@ void QRGenerator::setupUI()
     setupContactTab();
     setupWiFiTab();
     setupReaderTab();
+    setupTransferTab();
     
     // Ustawienie panelu QR
     setupQRPanel(rightPanel);
@@ -0,0 +1,229 @@
+#include "qrgenerator.h"
+
+// Implementacja transmisji animowanej (kod fontannowy LT)
+
+namespace {
+
+// Ramki są gęste, więc wybieramy najniższy poziom korekcji
+constexpr qrcore::ErrorCorrection kTransferLevel = qrcore::ErrorCorrection::Low;
+
+QString formatRate(double bytesPerSecond)
+{
+    if (bytesPerSecond >= 1024.0) {
+        return QString("%1 KB/s").arg(bytesPerSecond / 1024.0, 0, 'f', 1);
+    }
+    return QString("%1 B/s").arg(bytesPerSecond, 0, 'f', 0);
+}
+
+} // namespace
+
+void QRGenerator::chooseTransferFile()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Wybierz plik do wysłania",
+        QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation));
+
+    if (!fileName.isEmpty()) {
+        m_transferFileEdit->setText(fileName);
+    }
+}
+
+void QRGenerator::toggleTransferSending()
+{
+    if (m_transferTimer->isActive()) {
+        stopTransferSending();
+        return;
+    }
+
+    QFile file(m_transferFileEdit->text());
+    if (file.fileName().isEmpty() || !file.open(QIODevice::ReadOnly)) {
+        showError("Nie można otworzyć pliku do wysłania");
+        return;
+    }
+    if (file.size() > static_cast<qint64>(qrcore::kMaxTransferFileSize)) {
+        showError(QString("Plik jest zbyt duży (maks. %1 MB)").arg(qrcore::kMaxTransferFileSize / (1024 * 1024)));
+        return;
+    }
+
+    const std::string message = qrcore::packTransferFile(QFileInfo(file).fileName().toStdString(),
+                                                         file.readAll().toStdString());
+    const int blockSize = qrcore::FountainEncoder::blockSizeFor(m_transferVersionSpin->value(), kTransferLevel);
+    m_fountainEncoder = qrcore::FountainEncoder(message, blockSize);
+    if (m_fountainEncoder.isNull()) {
+        showError("Nie można przygotować transmisji pliku");
+        return;
+    }
+
+    // Numery ramek rosną bez końca - pierwsze K ramek niesie bloki wprost,
+    // dalsze uzupełniają klatki zgubione przez odbiorcę
+    m_transferSeed = 0;
+    m_transferTimer->start(1000 / m_transferFpsSpin->value());
+    m_transferSendButton->setText("Zatrzymaj nadawanie");
+    m_transferFileEdit->setEnabled(false);
+    m_transferVersionSpin->setEnabled(false);
+    m_transferFrameLabel->setToolTip(QString("Bloki: %1 x %2 B").arg(m_fountainEncoder.blockCount())
+                                         .arg(m_fountainEncoder.blockSize()));
+    showNextTransferFrame();
+}
+
+void QRGenerator::stopTransferSending()
+{
+    m_transferTimer->stop();
+    m_fountainEncoder = qrcore::FountainEncoder();
+    m_transferSendButton->setText("Rozpocznij nadawanie");
+    m_transferFileEdit->setEnabled(true);
+    m_transferVersionSpin->setEnabled(true);
+    m_transferFrameLabel->clear();
+    m_transferFrameLabel->setToolTip(QString());
+}
+
+void QRGenerator::showNextTransferFrame()
+{
+    if (m_fountainEncoder.isNull()) {
+        return;
+    }
+
+    // Stała wersja - wszystkie klatki mają ten sam rozmiar i położenie modułów
+    qrcore::EncodeOptions options;
+    options.ecLevel = kTransferLevel;
+    options.version = m_transferVersionSpin->value();
+    const qrcore::QRMatrix matrix = qrcore::encode(m_fountainEncoder.frame(m_transferSeed++), options);
+    if (matrix.isNull()) {
+        stopTransferSending();
+        showError("Nie można zakodować ramki transmisji");
+        return;
+    }
+
+    const int size = qMin(m_transferFrameLabel->width(), m_transferFrameLabel->height());
+    qrcore::RenderOptions renderOptions;
+    renderOptions.scale = qrcore::scaleForSize(matrix, size, renderOptions.border);
+    m_transferFrameLabel->setPixmap(QPixmap::fromImage(qrcore::renderImage(matrix, renderOptions)));
+}
+
+void QRGenerator::receiveTransferFromCamera()
+{
+    if (m_transferReceiving) {
+        stopCamera();
+        return;
+    }
+    if (startTransferReceiving(QString())) {
+        m_transferCameraButton->setText("Zatrzymaj odbiór");
+    }
+}
+
+void QRGenerator::receiveTransferFromRecording()
+{
+    if (m_transferReceiving) {
+        stopCamera();
+        return;
+    }
+
+    QString fileName = QFileDialog::getOpenFileName(this, "Wybierz nagranie transmisji",
+        QStandardPaths::writableLocation(QStandardPaths::MoviesLocation),
+        "Pliki wideo (*.mp4 *.avi *.mkv *.mov *.webm)");
+
+    if (!fileName.isEmpty() && startTransferReceiving(fileName)) {
+        m_transferRecordingButton->setText("Zatrzymaj odbiór");
+    }
+}
+
+bool QRGenerator::startTransferReceiving(const QString& recordingPath)
+{
+    // Potok kamery jest wspólny z czytnikiem - bieżący odczyt zostaje przerwany
+    stopCamera();
+
+    const bool started = recordingPath.isEmpty()
+        ? m_cameraPipeline->start(0)
+        : m_cameraPipeline->startFile(QFile::encodeName(recordingPath).toStdString());
+    if (!started) {
+        showError(recordingPath.isEmpty() ? "Nie można otworzyć kamery" : "Nie można otworzyć nagrania");
+        return false;
+    }
+
+    m_fountainDecoder.reset();
+    m_transferReceiving = true;
+    m_readCameraButton->setText("Zatrzymaj kamerę");
+    updateTransferStatus();
+    return true;
+}
+
+void QRGenerator::handleTransferFrame(const QByteArray& payload)
+{
+    using FrameStatus = qrcore::FountainDecoder::FrameStatus;
+
+    const bool firstFrame = !m_fountainDecoder.isStarted();
+    const FrameStatus status = m_fountainDecoder.addFrame(payload.toStdString());
+    if (status != FrameStatus::Accepted) {
+        return; // inne kody w kadrze, powtórzone klatki
+    }
+    if (firstFrame) {
+        m_transferClock.start();
+    }
+
+    updateTransferStatus();
+    if (m_fountainDecoder.isComplete()) {
+        finishTransfer();
+    }
+}
+
+void QRGenerator::updateTransferStatus()
+{
+    if (!m_fountainDecoder.isStarted()) {
+        m_transferProgress->setRange(0, 1);
+        m_transferProgress->setValue(0);
+        m_transferStatusLabel->setText(m_transferReceiving ? "Oczekiwanie na pierwszą ramkę..."
+                                                           : "Oczekiwanie na transmisję");
+        return;
+    }
+
+    // Przepustowość: odtworzone bajty od pierwszej przyjętej ramki
+    const qint64 elapsed = qMax<qint64>(m_transferClock.elapsed(), 1);
+    const double bytes = qMin<double>(static_cast<double>(m_fountainDecoder.resolvedBlocks()) *
+                                          m_fountainDecoder.blockSize(),
+                                      static_cast<double>(m_fountainDecoder.messageSize()));
+    m_transferProgress->setRange(0, m_fountainDecoder.blockCount());
+    m_transferProgress->setValue(m_fountainDecoder.resolvedBlocks());
+    m_transferStatusLabel->setText(QString("Bloki: %1/%2, ramki: %3, %4")
+                                       .arg(m_fountainDecoder.resolvedBlocks())
+                                       .arg(m_fountainDecoder.blockCount())
+                                       .arg(m_fountainDecoder.acceptedFrames())
+                                       .arg(formatRate(bytes * 1000.0 / elapsed)));
+}
+
+void QRGenerator::finishTransfer()
+{
+    stopCamera();
+
+    std::string message;
+    std::string name;
+    std::string contents;
+    if (!m_fountainDecoder.message(message) || !qrcore::unpackTransferFile(message, name, contents)) {
+        showError("Odebrany plik jest uszkodzony (niezgodna suma kontrolna)");
+        return;
+    }
+
+    const qint64 elapsed = qMax<qint64>(m_transferClock.elapsed(), 1);
+    const QString summary = QString("Odebrano %1 B w %2 s (%3, ramki: %4)")
+        .arg(contents.size())
+        .arg(elapsed / 1000.0, 0, 'f', 1)
+        .arg(formatRate(message.size() * 1000.0 / elapsed))
+        .arg(m_fountainDecoder.acceptedFrames());
+    m_transferStatusLabel->setText(summary);
+
+    // Nazwa od nadawcy bez ścieżki - zapis zawsze tam, gdzie wskaże użytkownik
+    const QString suggested = QFileInfo(QString::fromStdString(name)).fileName();
+    QString fileName = QFileDialog::getSaveFileName(this, "Zapisz odebrany plik",
+        QStandardPaths::writableLocation(QStandardPaths::DownloadLocation) + "/" +
+            (suggested.isEmpty() ? QString("transmisja.bin") : suggested));
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+        file.write(contents.data(), static_cast<qint64>(contents.size())) == static_cast<qint64>(contents.size())) {
+        showInfo(summary + "\nZapisano jako: " + QFileInfo(fileName).fileName());
+    } else {
+        showError("Nie można zapisać odebranego pliku");
+    }
+}
@@ -214,10 +214,13 @@ void QRGenerator::setupReaderTab()
     m_readCameraButton->setToolTip("Włącz kamerę do skanowania kodów QR");
     m_readScreenButton = new QPushButton("Zrzut ekranu");
     m_readScreenButton->setToolTip("Zrób zrzut ekranu i znajdź kod QR");
+    m_readVideoButton = new QPushButton("Analizuj nagranie");
+    m_readVideoButton->setToolTip("Znajdź wszystkie kody QR w pliku wideo (z czasem wystąpienia)");
     
     sourceLayout->addWidget(m_readFileButton);
     sourceLayout->addWidget(m_readCameraButton);
     sourceLayout->addWidget(m_readScreenButton);
+    sourceLayout->addWidget(m_readVideoButton);
     
     layout->addWidget(sourceGroup);
     
@@ -239,11 +242,91 @@ void QRGenerator::setupReaderTab()
     connect(m_readFileButton, &QPushButton::clicked, this, &QRGenerator::readQRFromFile);
     connect(m_readCameraButton, &QPushButton::clicked, this, &QRGenerator::readQRFromCamera);
     connect(m_readScreenButton, &QPushButton::clicked, this, &QRGenerator::readQRFromScreen);
+    connect(m_readVideoButton, &QPushButton::clicked, this, &QRGenerator::readQRFromVideo);
     connect(copyResultButton, &QPushButton::clicked, this, &QRGenerator::copyResult);
     
     m_tabWidget->addTab(readerWidget, "Czytnik QR");
 }
 
+void QRGenerator::setupTransferTab()
+{
+    QWidget* transferWidget = new QWidget();
+    QVBoxLayout* layout = new QVBoxLayout(transferWidget);
+    
+    QLabel* titleLabel = new QLabel("Transmisja pliku animowanym kodem QR");
+    titleLabel->setStyleSheet("font-weight: bold; font-size: 14px; margin-bottom: 10px;");
+    layout->addWidget(titleLabel);
+    
+    // Nadawanie - plik wyświetlany jako ciąg ramek kodu fontannowego
+    QGroupBox* sendGroup = new QGroupBox("Nadawanie");
+    QFormLayout* sendLayout = new QFormLayout(sendGroup);
+    
+    QHBoxLayout* fileLayout = new QHBoxLayout();
+    m_transferFileEdit = new QLineEdit();
+    m_transferFileEdit->setPlaceholderText("Wybierz plik do wysłania");
+    QPushButton* browseButton = new QPushButton("Wybierz...");
+    fileLayout->addWidget(m_transferFileEdit);
+    fileLayout->addWidget(browseButton);
+    sendLayout->addRow("Plik:", fileLayout);
+    
+    m_transferVersionSpin = new QSpinBox();
+    m_transferVersionSpin->setRange(10, 40);
+    m_transferVersionSpin->setValue(20);
+    m_transferVersionSpin->setToolTip("Większe symbole niosą więcej danych, ale wymagają ostrzejszego obrazu");
+    sendLayout->addRow("Wersja symbolu:", m_transferVersionSpin);
+    
+    m_transferFpsSpin = new QSpinBox();
+    m_transferFpsSpin->setRange(1, 60);
+    m_transferFpsSpin->setValue(20);
+    m_transferFpsSpin->setSuffix(" klatek/s");
+    sendLayout->addRow("Tempo:", m_transferFpsSpin);
+    
+    m_transferSendButton = new QPushButton("Rozpocznij nadawanie");
+    sendLayout->addRow(m_transferSendButton);
+    
+    m_transferFrameLabel = new QLabel();
+    m_transferFrameLabel->setMinimumSize(300, 300);
+    m_transferFrameLabel->setAlignment(Qt::AlignCenter);
+    m_transferFrameLabel->setStyleSheet("background-color: white;");
+    sendLayout->addRow(m_transferFrameLabel);
+    
+    layout->addWidget(sendGroup, 1);
+    
+    // Odbiór - ramki z kamery lub z nagrania animacji
+    QGroupBox* receiveGroup = new QGroupBox("Odbiór");
+    QVBoxLayout* receiveLayout = new QVBoxLayout(receiveGroup);
+    
+    QHBoxLayout* receiveButtons = new QHBoxLayout();
+    m_transferCameraButton = new QPushButton("Odbierz z kamery");
+    m_transferRecordingButton = new QPushButton("Odbierz z nagrania");
+    m_transferRecordingButton->setToolTip("Odtwórz nagranie animacji w miejsce kamery");
+    receiveButtons->addWidget(m_transferCameraButton);
+    receiveButtons->addWidget(m_transferRecordingButton);
+    receiveLayout->addLayout(receiveButtons);
+    
+    m_transferProgress = new QProgressBar();
+    m_transferProgress->setRange(0, 1);
+    m_transferProgress->setValue(0);
+    receiveLayout->addWidget(m_transferProgress);
+    
+    m_transferStatusLabel = new QLabel("Oczekiwanie na transmisję");
+    m_transferStatusLabel->setStyleSheet("color: gray; font-size: 11px;");
+    receiveLayout->addWidget(m_transferStatusLabel);
+    
+    layout->addWidget(receiveGroup);
+    
+    // Połączenia sygnałów
+    connect(browseButton, &QPushButton::clicked, this, &QRGenerator::chooseTransferFile);
+    connect(m_transferSendButton, &QPushButton::clicked, this, &QRGenerator::toggleTransferSending);
+    connect(m_transferCameraButton, &QPushButton::clicked, this, &QRGenerator::receiveTransferFromCamera);
+    connect(m_transferRecordingButton, &QPushButton::clicked, this, &QRGenerator::receiveTransferFromRecording);
+    connect(m_transferFpsSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int fps) {
+        m_transferTimer->setInterval(1000 / fps);
+    });
+    
+    m_tabWidget->addTab(transferWidget, "Transmisja");
+}
+
 void QRGenerator::setupQRPanel(QWidget* parent)
 {
     QVBoxLayout* layout = new QVBoxLayout(parent);
@@ -263,6 +346,17 @@ void QRGenerator::setupQRPanel(QWidget* parent)
     m_qrLabel->setText("Kod QR pojawi się tutaj");
     layout->addWidget(m_qrLabel);
     
+    // Gęste symbole wysokich wersji skanują się wolno - dłuższa treść
+    // jest dzielona na serię mniejszych symboli (Structured Append)
+    QFormLayout* symbolLayout = new QFormLayout();
+    m_maxVersionSpin = new QSpinBox();
+    m_maxVersionSpin->setRange(1, 40);
+    m_maxVersionSpin->setValue(20);
+    m_maxVersionSpin->setToolTip("Treść niemieszcząca się w symbolu tej wersji zostanie podzielona "
+                                 "na maks. 16 symboli Structured Append");
+    symbolLayout->addRow("Maks. wersja symbolu:", m_maxVersionSpin);
+    layout->addLayout(symbolLayout);
+    
     // Przyciski akcji
     QHBoxLayout* buttonLayout = new QHBoxLayout();
     
@@ -281,4 +375,9 @@ void QRGenerator::setupQRPanel(QWidget* parent)
     connect(m_saveImageButton, &QPushButton::clicked, this, &QRGenerator::saveQRImage);
     connect(m_copyButton, &QPushButton::clicked, this, &QRGenerator::copyToClipboard);
     connect(m_clearButton, &QPushButton::clicked, this, &QRGenerator::clearQR);
+    connect(m_maxVersionSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this]() {
+        if (!m_previewData.isEmpty()) {
+            generateQRCode(m_previewData);
+        }
+    });
 }
@@ -1,5 +1,7 @@
 #include "qrgenerator.h"
 
+#include <fstream>
+
 // Implementacja pozostałych metod
 
 void QRGenerator::saveQRImage()
@@ -12,14 +14,40 @@ void QRGenerator::saveQRImage()
     QString fileName = QFileDialog::getSaveFileName(this,
         "Zapisz kod QR",
         QStandardPaths::writableLocation(QStandardPaths::PicturesLocation) + "/qr_code.png",
-        "Pliki PNG (*.png)");
+        "Pliki PNG (*.png);;TIFF CCITT G4 (*.tif *.tiff);;Grafika wektorowa SVG (*.svg);;Dokument PDF (*.pdf);;PostScript EPS (*.eps)");
+    
+    if (fileName.isEmpty()) {
+        return;
+    }
     
-    if (!fileName.isEmpty()) {
-        if (m_currentQR.save(fileName, "PNG")) {
-            showInfo("Kod QR został zapisany jako: " + QFileInfo(fileName).fileName());
-        } else {
-            showError("Nie można zapisać pliku");
+    // Formaty wektorowe i 1-bitowe rastry powstają wprost z macierzy modułów
+    bool saved = false;
+    const std::string path = fileName.toStdString();
+    qrcore::VectorFormat vectorFormat;
+    qrcore::BitmapFormat bitmapFormat;
+    if (m_currentMatrix && qrcore::vectorFormatForPath(path, vectorFormat)) {
+        std::ofstream output(QFile::encodeName(fileName).toStdString(), std::ios::binary | std::ios::trunc);
+        saved = output && qrcore::writeVector(*m_currentMatrix, vectorFormat, output);
+    } else if (m_currentMatrix) {
+        if (!qrcore::bitmapFormatForPath(path, bitmapFormat)) {
+            bitmapFormat = qrcore::BitmapFormat::Png;
         }
+        std::ofstream output(QFile::encodeName(fileName).toStdString(), std::ios::binary | std::ios::trunc);
+        saved = output && qrcore::writeBitmap(*m_currentMatrix, bitmapFormat, output);
+    } else {
+        // Seria Structured Append nie ma jednej macierzy - jest tylko złożony
+        // obraz podglądu, więc inne formaty zawierałyby dane PNG
+        if (QFileInfo(fileName).suffix().compare("png", Qt::CaseInsensitive) != 0) {
+            showError("Seria kodów Structured Append może być zapisana tylko jako PNG");
+            return;
+        }
+        saved = m_currentQR.save(fileName, "PNG");
+    }
+    
+    if (saved) {
+        showInfo("Kod QR został zapisany jako: " + QFileInfo(fileName).fileName());
+    } else {
+        showError("Nie można zapisać pliku");
     }
 }
 
@@ -56,9 +84,17 @@ void QRGenerator::copyToClipboard()
 
 void QRGenerator::clearQR()
 {
+    // Unieważnij oczekujące i trwające renderowanie podglądu
+    ++m_previewRequestId;
+    m_previewPending = false;
+    m_pendingPreviewData.clear();
+    m_previewData.clear();
+    
     m_qrLabel->clear();
+    m_qrLabel->setToolTip(QString());
     m_qrLabel->setText("Kod QR pojawi się tutaj");
     m_currentQR = QPixmap();
+    m_currentMatrix.reset();
 }
 
 void QRGenerator::copyResult()
@@ -90,45 +126,17 @@ QPixmap QRGenerator::createQRImage(const QString& data, int size)
 {
     // Ta metoda może być używana do tworzenia QR o określonym rozmiarze
     try {
-        QRcode* qrCode = QRcode_encodeString(data.toUtf8().constData(), 
-                                           0, QR_ECLEVEL_M, QR_MODE_8, 1);
+        std::shared_ptr<const qrcore::QRMatrix> matrix = m_symbolCache.encode(data.toUtf8().toStdString());
         
-        if (!qrCode) {
+        if (!matrix) {
             return QPixmap();
         }
         
-        int qrSize = qrCode->width;
-        int scale = size / qrSize;
-        if (scale < 1) scale = 1;
-        
-        int border = 4;
-        int imageSize = (qrSize + 2 * border) * scale;
-        
-        QImage qrImage(imageSize, imageSize, QImage::Format_RGB32);
-        qrImage.fill(Qt::white);
-        
-        for (int y = 0; y < qrSize; y++) {
-            for (int x = 0; x < qrSize; x++) {
-                if (qrCode->data[y * qrSize + x] & 1) {
-                    for (int dy = 0; dy < scale; dy++) {
-                        for (int dx = 0; dx < scale; dx++) {
-                            int px = (x + border) * scale + dx;
-                            int py = (y + border) * scale + dy;
-                            if (px < imageSize && py < imageSize) {
-                                qrImage.setPixel(px, py, qRgb(0, 0, 0));
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        
-        QRcode_free(qrCode);
-        return QPixmap::fromImage(qrImage);
+        qrcore::RenderOptions options;
+        options.scale = qMax(1, size / matrix->size());
+        return QPixmap::fromImage(qrcore::renderImage(*matrix, options));
         
     } catch (...) {
         return QPixmap();
     }
-}
-
-
+}
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include "qrcore/archive_writer.h"
+
+#include "test_support.h"
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace qrcore;
+
+// Wpis odczytany z archiwum: nazwa -> treść po rozpakowaniu
+using Entries = std::map<std::string, std::string>;
+
+std::string readFile(const std::string& path)
+{
+    std::string bytes;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return bytes;
+    }
+    char buffer[65536];
+    size_t count = 0;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.append(buffer, count);
+    }
+    std::fclose(file);
+    return bytes;
+}
+
+uint32_t le(const std::string& bytes, size_t offset, int size)
+{
+    uint32_t value = 0;
+    for (int i = size - 1; i >= 0; i--) {
+        value = value << 8 | static_cast<uint8_t>(bytes[offset + i]);
+    }
+    return value;
+}
+
+bool inflateRaw(const std::string& input, size_t outputSize, std::string& output)
+{
+    output.assign(outputSize, '\0');
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        return false;
+    }
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+    stream.avail_out = static_cast<uInt>(output.size());
+    const int status = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    return status == Z_STREAM_END && stream.avail_out == 0;
+}
+
+// Czytnik ZIP: nagłówki lokalne po kolei, a następnie zgodność katalogu
+// centralnego (liczba wpisów, przesunięcia) z tym, co znaleziono
+bool readZip(const std::string& bytes, Entries& entries, std::vector<std::string>& order)
+{
+    std::vector<uint32_t> offsets;
+    size_t position = 0;
+    while (position + 30 <= bytes.size() && le(bytes, position, 4) == 0x04034b50) {
+        const uint32_t method = le(bytes, position + 8, 2);
+        const uint32_t crc = le(bytes, position + 14, 4);
+        const uint32_t stored = le(bytes, position + 18, 4);
+        const uint32_t size = le(bytes, position + 22, 4);
+        const uint32_t nameLength = le(bytes, position + 26, 2);
+        const uint32_t extraLength = le(bytes, position + 28, 2);
+        const std::string name = bytes.substr(position + 30, nameLength);
+        const std::string data = bytes.substr(position + 30 + nameLength + extraLength, stored);
+
+        std::string contents = data;
+        if (method == 8 && !CHECK(inflateRaw(data, size, contents))) {
+            return false;
+        }
+        if (!CHECK(method == 0 || method == 8) || !CHECK(contents.size() == size) ||
+            !CHECK(crc32(reinterpret_cast<const uint8_t*>(contents.data()), contents.size()) == crc)) {
+            return false;
+        }
+
+        offsets.push_back(static_cast<uint32_t>(position));
+        entries[name] = contents;
+        order.push_back(name);
+        position += 30 + nameLength + extraLength + stored;
+    }
+
+    // Katalog centralny: rekordy w kolejności wpisów, na końcu rekord EOCD
+    const size_t directory = position;
+    for (size_t i = 0; i < offsets.size(); i++) {
+        if (!CHECK(le(bytes, position, 4) == 0x02014b50) || !CHECK(le(bytes, position + 42, 4) == offsets[i])) {
+            return false;
+        }
+        const uint32_t nameLength = le(bytes, position + 28, 2);
+        CHECK(bytes.substr(position + 46, nameLength) == order[i]);
+        position += 46 + nameLength + le(bytes, position + 30, 2) + le(bytes, position + 32, 2);
+    }
+    return CHECK(le(bytes, position, 4) == 0x06054b50) &&
+           CHECK(le(bytes, position + 10, 2) == offsets.size()) &&
+           CHECK(le(bytes, position + 12, 4) == position - directory) &&
+           CHECK(le(bytes, position + 16, 4) == directory) &&
+           CHECK(position + 22 == bytes.size());
+}
+
+// Pole tekstowe nagłówka TAR - do pierwszego bajtu zerowego
+std::string field(const std::string& header, size_t offset, size_t length)
+{
+    const std::string value = header.substr(offset, length);
+    return value.substr(0, value.find('\0'));
+}
+
+// Czytnik TAR (ustar): suma kontrolna nagłówka, nazwa z prefiksem,
+// wyrównanie danych do 512 bajtów i dwa puste bloki na końcu
+bool readTar(const std::string& bytes, Entries& entries, std::vector<std::string>& order)
+{
+    size_t position = 0;
+    while (position + 512 <= bytes.size() && bytes[position] != '\0') {
+        const std::string header = bytes.substr(position, 512);
+        unsigned checksum = 0;
+        for (size_t i = 0; i < 512; i++) {
+            checksum += (i >= 148 && i < 156) ? ' ' : static_cast<uint8_t>(header[i]);
+        }
+        if (!CHECK(std::strtoul(header.c_str() + 148, nullptr, 8) == checksum) ||
+            !CHECK(header.compare(257, 5, "ustar") == 0)) {
+            return false;
+        }
+
+        const std::string shortName = field(header, 0, 100);
+        const std::string prefix = field(header, 345, 155);
+        const std::string name = prefix.empty() ? shortName : prefix + "/" + shortName;
+        const size_t size = std::strtoull(header.c_str() + 124, nullptr, 8);
+
+        entries[name] = bytes.substr(position + 512, size);
+        order.push_back(name);
+        position += 512 + (size + 511) / 512 * 512;
+    }
+    return CHECK(bytes.size() == position + 1024) &&
+           CHECK(bytes.find_first_not_of('\0', position) == std::string::npos);
+}
+
+bool readArchive(ArchiveWriter::Format format, const std::string& path, Entries& entries,
+                 std::vector<std::string>& order)
+{
+    const std::string bytes = readFile(path);
+    return format == ArchiveWriter::Format::Zip ? readZip(bytes, entries, order) : readTar(bytes, entries, order);
+}
+
+std::string archivePath(ArchiveWriter::Format format)
+{
+    return format == ArchiveWriter::Format::Zip ? "archive_writer_test.zip" : "archive_writer_test.tar";
+}
+
+void crcValue()
+{
+    const char check[] = "123456789";
+    CHECK(crc32(reinterpret_cast<const uint8_t*>(check), 9) == 0xCBF43926u);
+    // Liczenie w kawałkach daje ten sam wynik
+    CHECK(crc32(reinterpret_cast<const uint8_t*>(check) + 4, 5, crc32(reinterpret_cast<const uint8_t*>(check), 4)) ==
+          0xCBF43926u);
+}
+
+void formatFromPath()
+{
+    ArchiveWriter::Format format = ArchiveWriter::Format::Tar;
+    CHECK(ArchiveWriter::formatForPath("wyniki/kody.ZIP", format) && format == ArchiveWriter::Format::Zip);
+    CHECK(ArchiveWriter::formatForPath("kody.tar", format) && format == ArchiveWriter::Format::Tar);
+    CHECK(!ArchiveWriter::formatForPath("kody.tar.gz", format));
+    CHECK(!ArchiveWriter::formatForPath("zip", format));
+}
+
+// Zapis i odczyt: treść każdego wpisu, kompresja tylko wtedy, gdy się
+// opłaca (ZIP), długie nazwy w prefiksie ustar i manifest na końcu
+void roundTrip()
+{
+    std::mt19937 random(15);
+    for (ArchiveWriter::Format format : {ArchiveWriter::Format::Zip, ArchiveWriter::Format::Tar}) {
+        Entries expected;
+        std::vector<std::string> names;
+        for (int i = 0; i < 40; i++) {
+            std::string name = "kody/seria_" + std::to_string(i) + (i % 2 ? ".png" : ".svg");
+            if (i == 3) {
+                name = std::string(80, 'k') + "/" + std::string(90, 'p') + ".png";  // ponad 100 znaków
+            }
+            std::string data(static_cast<size_t>(random() % 3000), '\0');
+            for (char& value : data) {
+                value = i % 2 ? static_cast<char>(random()) : "<svg/>"[random() % 6];
+            }
+            expected[name] = data;
+            names.push_back(name);
+        }
+        expected["pusty.txt"] = std::string();
+        names.push_back("pusty.txt");
+
+        ArchiveWriter writer(format);
+        if (!CHECK(writer.open(archivePath(format)))) {
+            return;
+        }
+        for (const std::string& name : names) {
+            const std::string& data = expected[name];
+            const ArchiveWriter::PreparedEntry entry = ArchiveWriter::prepare(
+                name, reinterpret_cast<const uint8_t*>(data.data()), data.size(),
+                ArchiveWriter::Compression::Deflate, format);
+            // Kompresja tylko w ZIP i tylko, gdy wpis się zmniejsza; dane
+            // losowe (.png) zostają bez kompresji
+            const bool text = name.compare(name.size() - 4, 4, ".svg") == 0;
+            CHECK(!entry.deflated || (format == ArchiveWriter::Format::Zip && entry.data.size() < data.size()));
+            if (format == ArchiveWriter::Format::Zip && data.size() >= 1000) {
+                CHECK(entry.deflated == text);
+            }
+            CHECK(writer.add(entry));
+        }
+        CHECK(writer.entryCount() == names.size());
+        if (!CHECK(writer.finish())) {
+            std::fprintf(stderr, "  %s\n", writer.errorString().c_str());
+            return;
+        }
+
+        Entries entries;
+        std::vector<std::string> order;
+        if (!CHECK(readArchive(format, archivePath(format), entries, order))) {
+            return;
+        }
+        if (!CHECK(order.size() == names.size() + 1) || !CHECK(order.back() == "manifest.jsonl")) {
+            return;
+        }
+        for (const std::string& name : names) {
+            CHECK(entries[name] == expected[name]);
+        }
+
+        // Manifest: wiersz JSON na każdy wpis, w kolejności zapisu
+        const std::string& manifest = entries["manifest.jsonl"];
+        size_t line = 0;
+        for (const std::string& name : names) {
+            const size_t end = manifest.find('\n', line);
+            if (!CHECK(end != std::string::npos)) {
+                return;
+            }
+            CHECK(manifest.compare(line, 10 + name.size(), "{\"name\":\"" + name + "\"") == 0);
+            line = end + 1;
+        }
+        CHECK(line == manifest.size());
+        std::remove(archivePath(format).c_str());
+    }
+}
+
+// Wpis o nazwie indeksu nie koliduje z manifestem dopisywanym przez finish()
+void reservedManifestName()
+{
+    for (ArchiveWriter::Format format : {ArchiveWriter::Format::Zip, ArchiveWriter::Format::Tar}) {
+        const std::string data = "{\"id\":\"manifest\"}\n";
+        ArchiveWriter writer(format);
+        if (!CHECK(writer.open(archivePath(format)))) {
+            return;
+        }
+        CHECK(writer.add(ArchiveWriter::prepare("manifest.jsonl", reinterpret_cast<const uint8_t*>(data.data()),
+                                                data.size(), ArchiveWriter::Compression::Store, format)));
+        CHECK(writer.finish());
+
+        Entries entries;
+        std::vector<std::string> order;
+        if (CHECK(readArchive(format, archivePath(format), entries, order))) {
+            CHECK(order == (std::vector<std::string>{"_manifest.jsonl", "manifest.jsonl"}));
+            CHECK(entries["_manifest.jsonl"] == data);
+            CHECK(entries["manifest.jsonl"].find("\"name\":\"_manifest.jsonl\"") != std::string::npos);
+        }
+        std::remove(archivePath(format).c_str());
+    }
+}
+
+// Wpisy przygotowywane i dopisywane z wielu wątków nie przeplatają się
+void concurrentAdd()
+{
+    const int threads = 4;
+    const int perThread = 50;
+    ArchiveWriter writer(ArchiveWriter::Format::Zip);
+    if (!CHECK(writer.open(archivePath(ArchiveWriter::Format::Zip)))) {
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&writer, t]() {
+            for (int i = 0; i < perThread; i++) {
+                const std::string data(static_cast<size_t>(100 + i), static_cast<char>('a' + t));
+                writer.add(ArchiveWriter::prepare("w" + std::to_string(t) + "_" + std::to_string(i),
+                                                  reinterpret_cast<const uint8_t*>(data.data()), data.size(),
+                                                  ArchiveWriter::Compression::Deflate, ArchiveWriter::Format::Zip));
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    CHECK(writer.finish());
+
+    Entries entries;
+    std::vector<std::string> order;
+    if (CHECK(readArchive(ArchiveWriter::Format::Zip, archivePath(ArchiveWriter::Format::Zip), entries, order))) {
+        CHECK(entries.size() == static_cast<size_t>(threads * perThread + 1));
+        for (int t = 0; t < threads; t++) {
+            for (int i = 0; i < perThread; i++) {
+                CHECK(entries["w" + std::to_string(t) + "_" + std::to_string(i)] ==
+                      std::string(static_cast<size_t>(100 + i), static_cast<char>('a' + t)));
+            }
+        }
+    }
+    std::remove(archivePath(ArchiveWriter::Format::Zip).c_str());
+}
+
+} // namespace
+
+int main()
+{
+    test::run("CRC-32", crcValue);
+    test::run("format z rozszerzenia", formatFromPath);
+    test::run("zapis i odczyt ZIP/TAR", roundTrip);
+    test::run("zarezerwowana nazwa manifestu", reservedManifestName);
+    test::run("dopisywanie z wielu wątków", concurrentAdd);
+    return test::finish();
+}
@@ -0,0 +1,620 @@
+#include "qrcore/bitmap_writer.h"
+
+#include "qrcore/qr_encoder.h"
+#include "qrcore/qr_rasterizer.h"
+
+#include "test_support.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace qrcore;
+
+// Raster Mono: wiersze co stride bajtów, MSB pierwszy, bit ustawiony = ciemny
+struct Raster {
+    int size = 0;
+    size_t stride = 0;
+    std::vector<uint8_t> bits;
+
+    Raster() = default;
+    Raster(int side, size_t rowBytes) : size(side), stride(rowBytes), bits(rowBytes * side, 0) {}
+
+    bool pixel(int x, int y) const { return (bits[y * stride + (x >> 3)] >> (7 - (x & 7))) & 1; }
+    void set(int x, int y, bool dark)
+    {
+        uint8_t& byte = bits[y * stride + (x >> 3)];
+        const uint8_t mask = uint8_t(0x80 >> (x & 7));
+        byte = dark ? (byte | mask) : (byte & ~mask);
+    }
+};
+
+bool sameImage(const Raster& a, const Raster& b)
+{
+    if (!CHECK(a.size == b.size)) {
+        return false;
+    }
+    for (int y = 0; y < a.size; y++) {
+        for (int x = 0; x < a.size; x++) {
+            if (a.pixel(x, y) != b.pixel(x, y)) {
+                std::fprintf(stderr, "  piksel (%d, %d)\n", x, y);
+                return CHECK(a.pixel(x, y) == b.pixel(x, y));
+            }
+        }
+    }
+    return true;
+}
+
+// Raster z wierszami różnego rodzaju: powtórzone (filtr Up), puste, z pojedynczymi
+// pikselami (długie ciągi w T.6) i losowe ciągi o różnej średniej długości.
+// Bajty poza szerokością obrazu są wypełnione śmieciami - zapis ma je pomijać.
+Raster randomRaster(std::mt19937& random, int size)
+{
+    Raster raster(size, (static_cast<size_t>(size) + 7) / 8 + 3);
+    for (uint8_t& byte : raster.bits) {
+        byte = static_cast<uint8_t>(random());
+    }
+
+    for (int y = 0; y < size; y++) {
+        const int kind = static_cast<int>(random() % 20);
+        for (int x = 0; x < size; x++) {
+            raster.set(x, y, false);
+        }
+        if (kind < 5 && y > 0) {
+            for (int x = 0; x < size; x++) {
+                raster.set(x, y, raster.pixel(x, y - 1));
+            }
+        } else if (kind < 7) {
+            continue;
+        } else if (kind < 10) {
+            for (int count = 1 + static_cast<int>(random() % 3); count > 0; count--) {
+                raster.set(static_cast<int>(random() % size), y, true);
+            }
+        } else {
+            const int mean = std::vector<int>{1, 3, 20, 200}[random() % 4];
+            bool dark = random() % 2 == 0;
+            for (int x = 0; x < size;) {
+                const int run = 1 + static_cast<int>(random() % (2 * mean));
+                for (int end = std::min(size, x + run); x < end; x++) {
+                    raster.set(x, y, dark);
+                }
+                dark = !dark;
+            }
+        }
+    }
+    return raster;
+}
+
+uint32_t bigEndian32(const std::string& data, size_t offset)
+{
+    return uint32_t(uint8_t(data[offset])) << 24 | uint32_t(uint8_t(data[offset + 1])) << 16 |
+           uint32_t(uint8_t(data[offset + 2])) << 8 | uint32_t(uint8_t(data[offset + 3]));
+}
+
+uint32_t littleEndian(const std::string& data, size_t offset, int bytes)
+{
+    uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        value = value << 8 | uint8_t(data[offset + i]);
+    }
+    return value;
+}
+
+// ---- PNG ----
+
+// Dekoder ograniczony do tego, co zapisuje writeBitmap: bloki z sumami CRC,
+// IHDR 1 bit z paletą, sklejone IDAT rozpakowane zlib, filtry None i Up
+bool decodePng(const std::string& png, Raster& image, uint32_t& pixelsPerMeter)
+{
+    static const char signature[8] = {'\x89', 'P', 'N', 'G', '\r', '\n', '\x1A', '\n'};
+    if (!CHECK(png.size() > 8 && png.compare(0, 8, signature, 8) == 0)) {
+        return false;
+    }
+
+    std::string idat;
+    std::vector<std::string> types;
+    int width = 0;
+    int height = 0;
+    pixelsPerMeter = 0;
+    for (size_t position = 8; position < png.size();) {
+        if (!CHECK(position + 12 <= png.size())) {
+            return false;
+        }
+        const uint32_t length = bigEndian32(png, position);
+        const std::string type = png.substr(position + 4, 4);
+        if (!CHECK(position + 12 + length <= png.size())) {
+            return false;
+        }
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(png.data()) + position + 4;
+        CHECK(bigEndian32(png, position + 8 + length) == ::crc32(0L, bytes, length + 4));
+
+        const std::string data = png.substr(position + 8, length);
+        if (type == "IHDR" && CHECK(length == 13)) {
+            width = static_cast<int>(bigEndian32(data, 0));
+            height = static_cast<int>(bigEndian32(data, 4));
+            CHECK(data.compare(8, 5, std::string("\x01\x03\x00\x00\x00", 5)) == 0);
+        } else if (type == "PLTE") {
+            CHECK(data == std::string("\xFF\xFF\xFF\x00\x00\x00", 6));
+        } else if (type == "pHYs" && CHECK(length == 9)) {
+            pixelsPerMeter = bigEndian32(data, 0);
+            CHECK(bigEndian32(data, 4) == pixelsPerMeter && data[8] == 1);
+        } else if (type == "IDAT") {
+            idat += data;
+        }
+        types.push_back(type);
+        position += 12 + length;
+    }
+    CHECK(types.size() >= 4 && types.front() == "IHDR" && types[1] == "PLTE" && types.back() == "IEND");
+    if (!CHECK(width > 0 && width == height)) {
+        return false;
+    }
+
+    const size_t lineBytes = (static_cast<size_t>(width) + 7) / 8;
+    std::vector<uint8_t> filtered((lineBytes + 1) * height + 1);
+    uLongf filteredSize = static_cast<uLongf>(filtered.size());
+    if (!CHECK(uncompress(filtered.data(), &filteredSize, reinterpret_cast<const Bytef*>(idat.data()),
+                          static_cast<uLong>(idat.size())) == Z_OK)) {
+        return false;
+    }
+    if (!CHECK(filteredSize == (lineBytes + 1) * height)) {
+        return false;
+    }
+
+    image = Raster(width, lineBytes);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* line = filtered.data() + y * (lineBytes + 1);
+        uint8_t* row = image.bits.data() + y * lineBytes;
+        if (!CHECK(line[0] == 0 || (line[0] == 2 && y > 0))) {
+            return false;
+        }
+        for (size_t i = 0; i < lineBytes; i++) {
+            row[i] = line[0] == 2 ? uint8_t(line[1 + i] + row[i - lineBytes]) : line[1 + i];
+        }
+    }
+    return true;
+}
+
+// ---- TIFF / CCITT Group 4 ----
+
+// Kody długości ciągów z ITU-T T.4 (tablice 2 i 3) w zapisie bitowym
+struct RunCode {
+    const char* bits;
+    int run;
+};
+
+const RunCode kWhiteRuns[] = {
+    {"00110101", 0}, {"000111", 1}, {"0111", 2}, {"1000", 3}, {"1011", 4}, {"1100", 5}, {"1110", 6},
+    {"1111", 7}, {"10011", 8}, {"10100", 9}, {"00111", 10}, {"01000", 11}, {"001000", 12}, {"000011", 13},
+    {"110100", 14}, {"110101", 15}, {"101010", 16}, {"101011", 17}, {"0100111", 18}, {"0001100", 19},
+    {"0001000", 20}, {"0010111", 21}, {"0000011", 22}, {"0000100", 23}, {"0101000", 24}, {"0101011", 25},
+    {"0010011", 26}, {"0100100", 27}, {"0011000", 28}, {"00000010", 29}, {"00000011", 30}, {"00011010", 31},
+    {"00011011", 32}, {"00010010", 33}, {"00010011", 34}, {"00010100", 35}, {"00010101", 36},
+    {"00010110", 37}, {"00010111", 38}, {"00101000", 39}, {"00101001", 40}, {"00101010", 41},
+    {"00101011", 42}, {"00101100", 43}, {"00101101", 44}, {"00000100", 45}, {"00000101", 46},
+    {"00001010", 47}, {"00001011", 48}, {"01010010", 49}, {"01010011", 50}, {"01010100", 51},
+    {"01010101", 52}, {"00100100", 53}, {"00100101", 54}, {"01011000", 55}, {"01011001", 56},
+    {"01011010", 57}, {"01011011", 58}, {"01001010", 59}, {"01001011", 60}, {"00110010", 61},
+    {"00110011", 62}, {"00110100", 63},
+    {"11011", 64}, {"10010", 128}, {"010111", 192}, {"0110111", 256}, {"00110110", 320}, {"00110111", 384},
+    {"01100100", 448}, {"01100101", 512}, {"01101000", 576}, {"01100111", 640}, {"011001100", 704},
+    {"011001101", 768}, {"011010010", 832}, {"011010011", 896}, {"011010100", 960}, {"011010101", 1024},
+    {"011010110", 1088}, {"011010111", 1152}, {"011011000", 1216}, {"011011001", 1280},
+    {"011011010", 1344}, {"011011011", 1408}, {"010011000", 1472}, {"010011001", 1536},
+    {"010011010", 1600}, {"011000", 1664}, {"010011011", 1728},
+};
+
+const RunCode kBlackRuns[] = {
+    {"0000110111", 0}, {"010", 1}, {"11", 2}, {"10", 3}, {"011", 4}, {"0011", 5}, {"0010", 6},
+    {"00011", 7}, {"000101", 8}, {"000100", 9}, {"0000100", 10}, {"0000101", 11}, {"0000111", 12},
+    {"00000100", 13}, {"00000111", 14}, {"000011000", 15}, {"0000010111", 16}, {"0000011000", 17},
+    {"0000001000", 18}, {"00001100111", 19}, {"00001101000", 20}, {"00001101100", 21},
+    {"00000110111", 22}, {"00000101000", 23}, {"00000010111", 24}, {"00000011000", 25},
+    {"000011001010", 26}, {"000011001011", 27}, {"000011001100", 28}, {"000011001101", 29},
+    {"000001101000", 30}, {"000001101001", 31}, {"000001101010", 32}, {"000001101011", 33},
+    {"000011010010", 34}, {"000011010011", 35}, {"000011010100", 36}, {"000011010101", 37},
+    {"000011010110", 38}, {"000011010111", 39}, {"000001101100", 40}, {"000001101101", 41},
+    {"000011011010", 42}, {"000011011011", 43}, {"000001010100", 44}, {"000001010101", 45},
+    {"000001010110", 46}, {"000001010111", 47}, {"000001100100", 48}, {"000001100101", 49},
+    {"000001010010", 50}, {"000001010011", 51}, {"000000100100", 52}, {"000000110111", 53},
+    {"000000111000", 54}, {"000000100111", 55}, {"000000101000", 56}, {"000001011000", 57},
+    {"000001011001", 58}, {"000000101011", 59}, {"000000101100", 60}, {"000001011010", 61},
+    {"000001100110", 62}, {"000001100111", 63},
+    {"0000001111", 64}, {"000011001000", 128}, {"000011001001", 192}, {"000001011011", 256},
+    {"000000110011", 320}, {"000000110100", 384}, {"000000110101", 448}, {"0000001101100", 512},
+    {"0000001101101", 576}, {"0000001001010", 640}, {"0000001001011", 704}, {"0000001001100", 768},
+    {"0000001001101", 832}, {"0000001110010", 896}, {"0000001110011", 960}, {"0000001110100", 1024},
+    {"0000001110101", 1088}, {"0000001110110", 1152}, {"0000001110111", 1216}, {"0000001010010", 1280},
+    {"0000001010011", 1344}, {"0000001010100", 1408}, {"0000001010101", 1472}, {"0000001011010", 1536},
+    {"0000001011011", 1600}, {"0000001100100", 1664}, {"0000001100101", 1728},
+};
+
+// Rozszerzone kody uzupełniające, wspólne dla obu kolorów
+const RunCode kExtendedRuns[] = {
+    {"00000001000", 1792}, {"00000001100", 1856}, {"00000001101", 1920}, {"000000010010", 1984},
+    {"000000010011", 2048}, {"000000010100", 2112}, {"000000010101", 2176}, {"000000010110", 2240},
+    {"000000010111", 2304}, {"000000011100", 2368}, {"000000011101", 2432}, {"000000011110", 2496},
+    {"000000011111", 2560},
+};
+
+template <size_t N>
+std::map<std::string, int> runTable(const RunCode (&codes)[N])
+{
+    std::map<std::string, int> table;
+    for (const RunCode& code : codes) {
+        table[code.bits] = code.run;
+    }
+    for (const RunCode& code : kExtendedRuns) {
+        table[code.bits] = code.run;
+    }
+    return table;
+}
+
+// Tryby kodowania dwuwymiarowego (T.4, tablica 4); wartość = przesunięcie
+// a1 względem b1 w trybie pionowym
+enum Mode { Pass = 100, Horizontal, EndOfBlock, Invalid };
+
+class BitReader
+{
+public:
+    BitReader(const std::string& data, size_t offset, size_t size) : m_data(data), m_offset(offset), m_size(size) {}
+
+    // Najkrótszy kod z tablicy pasujący do kolejnych bitów
+    template <typename Table>
+    bool read(const Table& table, int& value)
+    {
+        std::string code;
+        while (code.size() < 13 && m_position < m_size * 8) {
+            const uint8_t byte = uint8_t(m_data[m_offset + m_position / 8]);
+            code += ((byte >> (7 - m_position % 8)) & 1) ? '1' : '0';
+            m_position++;
+            auto it = table.find(code);
+            if (it != table.end()) {
+                value = it->second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Długość ciągu: kody uzupełniające, a po nich kończący
+    bool readRun(const std::map<std::string, int>& table, int& run)
+    {
+        run = 0;
+        for (;;) {
+            int part = 0;
+            if (!read(table, part)) {
+                return false;
+            }
+            run += part;
+            if (part < 64) {
+                return true;
+            }
+        }
+    }
+
+private:
+    const std::string& m_data;
+    size_t m_offset;
+    size_t m_size;
+    size_t m_position = 0;
+};
+
+// Wzorcowy dekoder T.6 jednego pasa (zapisany wprost według definicji
+// elementów zmiany z T.4 4.2.1.3, niezależnie od kodera)
+bool decodeGroup4(const std::string& file, size_t offset, size_t size, int width, int firstRow, int rows,
+                  Raster& image)
+{
+    static const std::map<std::string, int> modes = {
+        {"1", 0}, {"011", 1}, {"000011", 2}, {"0000011", 3}, {"010", -1}, {"000010", -2}, {"0000010", -3},
+        {"0001", Pass}, {"001", Horizontal}, {"000000000001", EndOfBlock},
+    };
+    static const std::map<std::string, int> whiteRuns = runTable(kWhiteRuns);
+    static const std::map<std::string, int> blackRuns = runTable(kBlackRuns);
+
+    BitReader reader(file, offset, size);
+    std::vector<uint8_t> reference(width, 0);
+    std::vector<uint8_t> line(width, 0);
+
+    // Pierwszy element zmiany na koloru color na prawo od a0 (przed wierszem
+    // leży wyimaginowany biały piksel); width, gdy go nie ma
+    auto changing = [&](int a0, int color) {
+        for (int x = std::max(a0 + 1, 0); x < width; x++) {
+            if (reference[x] == color && (x == 0 ? 0 : reference[x - 1]) != color) {
+                return x;
+            }
+        }
+        return width;
+    };
+    auto fill = [&](int from, int to, int color) {
+        if (!CHECK(from <= to && to <= width)) {
+            return false;
+        }
+        std::fill(line.begin() + from, line.begin() + to, uint8_t(color));
+        return true;
+    };
+
+    for (int y = 0; y < rows; y++) {
+        int a0 = -1;
+        int color = 0;
+        while (a0 < width) {
+            int mode = Invalid;
+            if (!CHECK(reader.read(modes, mode) && mode != EndOfBlock)) {
+                return false;
+            }
+            const int start = std::max(a0, 0);
+            const int b1 = changing(a0, !color);
+            const int b2 = b1 < width ? changing(b1, color) : width;
+
+            if (mode == Pass) {
+                if (!fill(start, b2, color)) {
+                    return false;
+                }
+                a0 = b2;
+            } else if (mode == Horizontal) {
+                int first = 0;
+                int second = 0;
+                if (!CHECK(reader.readRun(color ? blackRuns : whiteRuns, first) &&
+                           reader.readRun(color ? whiteRuns : blackRuns, second)) ||
+                    !fill(start, start + first, color) || !fill(start + first, start + first + second, !color)) {
+                    return false;
+                }
+                a0 = start + first + second;
+            } else {
+                const int a1 = b1 + mode;
+                if (!CHECK(a1 >= start) || !fill(start, a1, color)) {
+                    return false;
+                }
+                a0 = a1;
+                color = !color;
+            }
+        }
+
+        for (int x = 0; x < width; x++) {
+            image.set(x, firstRow + y, line[x] != 0);
+        }
+        reference.swap(line);
+        std::fill(line.begin(), line.end(), 0);
+    }
+
+    int end = Invalid;
+    CHECK(reader.read(modes, end) && end == EndOfBlock);
+    CHECK(reader.read(modes, end) && end == EndOfBlock);
+    return true;
+}
+
+// Odczyt pliku TIFF: nagłówek, IFD (znaczniki rosnąco), tablice pasów
+// przylegające do siebie i do końca pliku, rozdzielczość, dane pasów T.6
+bool decodeTiff(const std::string& tiff, Raster& image, double& dpi, size_t& stripCount)
+{
+    if (!CHECK(tiff.size() > 8 && tiff.compare(0, 4, std::string("II*\0", 4)) == 0)) {
+        return false;
+    }
+    const uint32_t ifd = littleEndian(tiff, 4, 4);
+    if (!CHECK(ifd + 2 <= tiff.size())) {
+        return false;
+    }
+
+    struct Entry {
+        uint16_t type;
+        uint32_t count;
+        uint32_t value;
+    };
+    std::map<uint16_t, Entry> entries;
+    const uint16_t entryCount = static_cast<uint16_t>(littleEndian(tiff, ifd, 2));
+    const size_t ifdEnd = ifd + 2 + entryCount * 12u + 4;
+    if (!CHECK(ifdEnd <= tiff.size())) {
+        return false;
+    }
+    uint16_t previousTag = 0;
+    for (uint16_t i = 0; i < entryCount; i++) {
+        const size_t position = ifd + 2 + i * 12u;
+        const uint16_t tag = static_cast<uint16_t>(littleEndian(tiff, position, 2));
+        const uint16_t type = static_cast<uint16_t>(littleEndian(tiff, position + 2, 2));
+        const uint32_t count = littleEndian(tiff, position + 4, 4);
+        const uint32_t value = littleEndian(tiff, position + 8, type == 3 && count == 1 ? 2 : 4);
+        CHECK(tag > previousTag);
+        previousTag = tag;
+        entries[tag] = Entry{type, count, value};
+    }
+    CHECK(littleEndian(tiff, ifdEnd - 4, 4) == 0); // jedno IFD
+
+    auto single = [&](uint16_t tag) { return entries.count(tag) ? entries[tag].value : 0xFFFFFFFFu; };
+    auto array = [&](uint16_t tag) {
+        std::vector<uint32_t> values;
+        const Entry& entry = entries[tag];
+        if (entry.count == 1) {
+            values.push_back(entry.value);
+        } else if (CHECK(entry.type == 4 && entry.value + entry.count * 4u <= tiff.size())) {
+            for (uint32_t i = 0; i < entry.count; i++) {
+                values.push_back(littleEndian(tiff, entry.value + i * 4u, 4));
+            }
+        }
+        return values;
+    };
+
+    const int size = static_cast<int>(single(256));
+    CHECK(single(257) == static_cast<uint32_t>(size));
+    CHECK(single(258) == 1);
+    CHECK(single(259) == 4);
+    CHECK(single(262) == 0);
+    CHECK(single(277) == 1);
+    CHECK(single(293) == 0);
+    CHECK(single(296) == 2);
+
+    const uint32_t rowsPerStrip = single(278);
+    const std::vector<uint32_t> offsets = array(273);
+    const std::vector<uint32_t> counts = array(279);
+    stripCount = offsets.size();
+    if (!CHECK(size > 0 && rowsPerStrip > 0 && offsets.size() == (size + rowsPerStrip - 1) / rowsPerStrip &&
+               counts.size() == offsets.size())) {
+        return false;
+    }
+
+    const uint32_t resolution = single(282);
+    if (!CHECK(single(283) == resolution + 8 && resolution + 16 <= tiff.size())) {
+        return false;
+    }
+    dpi = static_cast<double>(littleEndian(tiff, resolution, 4)) / littleEndian(tiff, resolution + 4, 4);
+
+    // Dane pasów zaraz po metadanych, jeden za drugim, do końca pliku
+    CHECK(offsets.front() >= ifdEnd && offsets.front() >= resolution + 16);
+    for (size_t i = 0; i + 1 < offsets.size(); i++) {
+        CHECK(offsets[i + 1] == offsets[i] + counts[i]);
+    }
+    if (!CHECK(offsets.back() + counts.back() == tiff.size())) {
+        return false;
+    }
+
+    image = Raster(size, (static_cast<size_t>(size) + 7) / 8);
+    for (size_t i = 0; i < offsets.size(); i++) {
+        const int firstRow = static_cast<int>(i * rowsPerStrip);
+        const int rows = std::min<int>(rowsPerStrip, size - firstRow);
+        if (!decodeGroup4(tiff, offsets[i], counts[i], size, firstRow, rows, image)) {
+            std::fprintf(stderr, "  pas %zu\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string written(const Raster& raster, BitmapFormat format, const BitmapOptions& options)
+{
+    std::ostringstream stream;
+    CHECK(writeBitmap(raster.bits.data(), raster.size, raster.stride, format, stream, options));
+    return stream.str();
+}
+
+// Budżet pamięci, przy którym pas ma rowsPerStrip wierszy (planStrips)
+size_t budgetForRows(int size, int rowsPerStrip)
+{
+    return 3 * ((static_cast<size_t>(size) + 7) / 8 + 1) * 8 * rowsPerStrip;
+}
+
+void pngRoundTrip()
+{
+    std::mt19937 random(31);
+    for (int size : {1, 7, 8, 13, 64, 257}) {
+        const Raster raster = randomRaster(random, size);
+
+        BitmapOptions options;
+        const std::string png = written(raster, BitmapFormat::Png, options);
+        Raster decoded;
+        uint32_t pixelsPerMeter = 0;
+        if (!CHECK(decodePng(png, decoded, pixelsPerMeter)) || !sameImage(raster, decoded)) {
+            std::fprintf(stderr, "  bok %d\n", size);
+            return;
+        }
+        CHECK(pixelsPerMeter == 0);
+
+        // Pas na wiersz: każdy pas to osobny blok deflate zakończony Z_FULL_FLUSH,
+        // a sumy adler32 są łączone; wynik nie zależy od równoległości
+        options.memoryBudget = 1;
+        options.compression = 9;
+        options.dpi = 300.0;
+        const std::string strips = written(raster, BitmapFormat::Png, options);
+        CHECK(decodePng(strips, decoded, pixelsPerMeter) && sameImage(raster, decoded));
+        CHECK(pixelsPerMeter == 11811);
+        options.parallel = false;
+        CHECK(written(raster, BitmapFormat::Png, options) == strips);
+    }
+}
+
+void tiffRoundTrip()
+{
+    std::mt19937 random(32);
+    for (int size : {1, 7, 8, 13, 64, 257, 3000}) {
+        const Raster raster = randomRaster(random, size);
+
+        BitmapOptions options;
+        Raster decoded;
+        double dpi = 0.0;
+        size_t strips = 0;
+        if (!CHECK(decodeTiff(written(raster, BitmapFormat::Tiff, options), decoded, dpi, strips)) ||
+            !sameImage(raster, decoded)) {
+            std::fprintf(stderr, "  bok %d\n", size);
+            return;
+        }
+        CHECK(dpi == 72.0);
+    }
+}
+
+// Wiele pasów: tablice StripOffsets/StripByteCounts poza IFD, pasy
+// kodowane niezależnie (każdy od białego wiersza odniesienia)
+void tiffStrips()
+{
+    std::mt19937 random(33);
+    for (int rowsPerStrip : {1, 5, 16}) {
+        const Raster raster = randomRaster(random, 100);
+        BitmapOptions options;
+        options.memoryBudget = budgetForRows(raster.size, rowsPerStrip);
+        options.dpi = 600.5;
+
+        const std::string tiff = written(raster, BitmapFormat::Tiff, options);
+        Raster decoded;
+        double dpi = 0.0;
+        size_t strips = 0;
+        CHECK(decodeTiff(tiff, decoded, dpi, strips) && sameImage(raster, decoded));
+        CHECK(strips == static_cast<size_t>((raster.size + rowsPerStrip - 1) / rowsPerStrip));
+        CHECK(dpi == 600.5);
+
+        options.parallel = false;
+        CHECK(written(raster, BitmapFormat::Tiff, options) == tiff);
+    }
+}
+
+// Zapis z macierzy odpowiada rastrowi StripRasterizer - także przy boku,
+// który nie jest wielokrotnością liczby modułów
+void fromMatrix()
+{
+    EncodeOptions encodeOptions;
+    encodeOptions.backend = EncoderBackend::Native;
+    const QRMatrix matrix = encode("https://example.com/raster", encodeOptions);
+
+    for (int side : {0, 101}) {
+        RasterOptions rasterOptions;
+        rasterOptions.scale = 3;
+        rasterOptions.border = 2;
+        const StripRasterizer rasterizer(matrix, rasterOptions, side);
+        Raster expected(rasterizer.size(), rasterizer.bytesPerLine());
+        rasterizer.render(0, rasterizer.size(), expected.bits.data(), expected.stride);
+
+        BitmapOptions options;
+        options.scale = 3;
+        options.border = 2;
+        options.size = side;
+        options.memoryBudget = budgetForRows(rasterizer.size(), 7);
+        for (BitmapFormat format : {BitmapFormat::Png, BitmapFormat::Tiff}) {
+            std::ostringstream stream;
+            if (!CHECK(writeBitmap(matrix, format, stream, options))) {
+                continue;
+            }
+            Raster decoded;
+            uint32_t pixelsPerMeter = 0;
+            double dpi = 0.0;
+            size_t strips = 0;
+            const bool ok = format == BitmapFormat::Png ? decodePng(stream.str(), decoded, pixelsPerMeter)
+                                                        : decodeTiff(stream.str(), decoded, dpi, strips);
+            CHECK(ok && sameImage(expected, decoded));
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    test::run("PNG: IDAT po rozpakowaniu", pngRoundTrip);
+    test::run("TIFF: dekodowanie G4", tiffRoundTrip);
+    test::run("TIFF: wiele pasów", tiffStrips);
+    test::run("zapis z macierzy", fromMatrix);
+    return test::finish();
+}
@@ -0,0 +1,256 @@
+#include "qrcore/fountain.h"
+
+#include "qrcore/archive_writer.h"
+#include "qrcore/qr_encoder.h"
+
+#include "test_support.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace qrcore;
+
+// Wzorcowe Base45 (RFC 9285, 4) - ramki porównywane są z tym zapisem
+std::string base45(const std::string& bytes)
+{
+    const char charset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+    std::string text;
+    for (size_t i = 0; i < bytes.size(); i += 2) {
+        uint32_t value = static_cast<uint8_t>(bytes[i]);
+        int digits = 2;
+        if (i + 1 < bytes.size()) {
+            value = value * 256 + static_cast<uint8_t>(bytes[i + 1]);
+            digits = 3;
+        }
+        for (int k = 0; k < digits; k++, value /= 45) {
+            text += charset[value % 45];
+        }
+    }
+    return text;
+}
+
+void putBigEndian(std::string& output, uint32_t value, int bytes)
+{
+    for (int i = bytes - 1; i >= 0; i--) {
+        output += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+std::string randomMessage(std::mt19937& random, size_t length)
+{
+    std::string message(length, '\0');
+    for (char& value : message) {
+        value = static_cast<char>(random());
+    }
+    return message;
+}
+
+void base45Examples()
+{
+    CHECK(base45("AB") == "BB8");
+    CHECK(base45("Hello!!") == "%69 VD92EX0");
+    CHECK(base45("base-45") == "UJCLQE7W581");
+    CHECK(base45("ietf!") == "QED8WEX0");
+}
+
+// Ramka systematyczna (numer < K): nagłówek big-endian i blok wprost,
+// zapisane w Base45 po prefiksie "QF:"
+void systematicFrameLayout()
+{
+    const std::string message = "Ramka systematyczna niesie blok wiadomości bez zmian.";
+    const int blockSize = 16;
+    const FountainEncoder encoder(message, blockSize);
+    if (!CHECK(!encoder.isNull())) {
+        return;
+    }
+    CHECK(encoder.transferId() == crc32(reinterpret_cast<const uint8_t*>(message.data()), message.size()));
+    CHECK(encoder.blockCount() == static_cast<int>((message.size() + blockSize - 1) / blockSize));
+
+    for (int seed = 0; seed < encoder.blockCount(); seed++) {
+        std::string payload;
+        putBigEndian(payload, 1, 1);
+        putBigEndian(payload, encoder.transferId(), 4);
+        putBigEndian(payload, static_cast<uint32_t>(message.size()), 4);
+        putBigEndian(payload, blockSize, 2);
+        putBigEndian(payload, static_cast<uint32_t>(seed), 4);
+        putBigEndian(payload, 1, 2);
+        std::string block = message.substr(static_cast<size_t>(seed) * blockSize, blockSize);
+        block.resize(blockSize, '\0');
+        payload += block;
+
+        CHECK(payload.size() == static_cast<size_t>(kFountainHeaderSize + blockSize));
+        CHECK(encoder.frame(static_cast<uint32_t>(seed)) == "QF:" + base45(payload));
+    }
+
+    CHECK(FountainEncoder("", 16).isNull());
+    CHECK(FountainEncoder(message, 0).isNull());
+}
+
+// LT encode/decode: 30% zgubionych klatek i powtórzenia; wiadomość
+// składa się z nieco ponad K ramek
+void lossyRoundTrip()
+{
+    std::mt19937 random(12);
+    std::bernoulli_distribution lost(0.3);
+    for (size_t size : {size_t(1), size_t(100), size_t(815), size_t(10000), size_t(120000)}) {
+        const std::string message = randomMessage(random, size);
+        const FountainEncoder encoder(message, FountainEncoder::blockSizeFor(20, ErrorCorrection::Low));
+
+        FountainDecoder decoder;
+        uint32_t seed = 0;
+        while (!decoder.isComplete()) {
+            if (!CHECK(seed < 10u * encoder.blockCount() + 1000)) {
+                return;
+            }
+            const std::string frame = encoder.frame(seed++);
+            if (lost(random)) {
+                continue;
+            }
+            CHECK(decoder.addFrame(frame) == FountainDecoder::FrameStatus::Accepted);
+            if (random() % 10 == 0) {
+                CHECK(decoder.addFrame(frame) == FountainDecoder::FrameStatus::Duplicate);
+            }
+        }
+
+        std::string output;
+        CHECK(decoder.message(output));
+        CHECK(output == message);
+        CHECK(decoder.acceptedFrames() < static_cast<size_t>(encoder.blockCount()) * 3 / 2 + 20);
+    }
+}
+
+// Odbiorca, który dołączył po ramkach systematycznych, składa wiadomość
+// z samych ramek zakodowanych (XOR wielu bloków)
+void codedFramesOnly()
+{
+    std::mt19937 random(13);
+    const std::string message = randomMessage(random, 50000);
+    const FountainEncoder encoder(message, 500);
+
+    FountainDecoder decoder;
+    uint32_t seed = 100000;
+    while (!decoder.isComplete() && seed < 100000u + 10u * encoder.blockCount()) {
+        decoder.addFrame(encoder.frame(seed++));
+    }
+    std::string output;
+    CHECK(decoder.message(output));
+    CHECK(output == message);
+}
+
+void rejectedFrames()
+{
+    const FountainEncoder first("pierwsza transmisja", 8);
+    const FountainEncoder second("druga transmisja", 8);
+    FountainDecoder decoder;
+
+    CHECK(decoder.addFrame("https://example.com/") == FountainDecoder::FrameStatus::NotFountain);
+    CHECK(decoder.addFrame("QF:") == FountainDecoder::FrameStatus::NotFountain);
+    CHECK(decoder.addFrame("QF:abc") == FountainDecoder::FrameStatus::NotFountain);  // małe litery spoza Base45
+    CHECK(!decoder.isStarted());
+
+    const std::string frame = first.frame(0);
+    CHECK(decoder.addFrame(frame.substr(0, frame.size() - 1)) == FountainDecoder::FrameStatus::NotFountain);
+    CHECK(decoder.addFrame(frame.substr(0, frame.size() - 3)) == FountainDecoder::FrameStatus::NotFountain);
+
+    CHECK(decoder.addFrame(frame) == FountainDecoder::FrameStatus::Accepted);
+    CHECK(decoder.addFrame(second.frame(1)) == FountainDecoder::FrameStatus::OtherTransfer);
+    CHECK(decoder.transferId() == first.transferId());
+
+    std::string output;
+    CHECK(!decoder.message(output));
+    decoder.reset();
+    CHECK(!decoder.isStarted());
+    CHECK(decoder.addFrame(second.frame(0)) == FountainDecoder::FrameStatus::Accepted);
+}
+
+// Nagłówek ramki pochodzi z obrazu: wiadomość ponad limit albo zbyt wiele
+// bloków jest odrzucane, zanim odbiorca przydzieli pamięć na stan transmisji
+void hostileHeaders()
+{
+    auto forged = [](uint32_t messageSize, uint32_t blockSize) {
+        std::string payload;
+        putBigEndian(payload, 1, 1);
+        putBigEndian(payload, 0x12345678u, 4);
+        putBigEndian(payload, messageSize, 4);
+        putBigEndian(payload, blockSize, 2);
+        putBigEndian(payload, 0, 4);
+        putBigEndian(payload, 1, 2);
+        payload += std::string(blockSize, 'x');
+        return "QF:" + base45(payload);
+    };
+
+    FountainDecoder decoder;
+    CHECK(decoder.addFrame(forged(0x7FFFFFFFu, 1)) == FountainDecoder::FrameStatus::NotFountain);
+    CHECK(decoder.addFrame(forged(0xFFFFFFFFu, 0xFFFF)) == FountainDecoder::FrameStatus::NotFountain);
+    CHECK(decoder.addFrame(forged(static_cast<uint32_t>(kMaxTransferFileSize), 16)) ==
+          FountainDecoder::FrameStatus::NotFountain);
+    CHECK(!decoder.isStarted());
+
+    // Granica: dokładnie kMaxFountainBlocks bloków jest jeszcze przyjmowane
+    CHECK(decoder.addFrame(forged(kMaxFountainBlocks, 1)) == FountainDecoder::FrameStatus::Accepted);
+    CHECK(decoder.blockCount() == kMaxFountainBlocks);
+
+    CHECK(FountainEncoder(std::string(kMaxFountainBlocks + 1, 'a'), 1).isNull());
+    CHECK(!FountainEncoder(std::string(kMaxFountainBlocks, 'a'), 1).isNull());
+}
+
+// Ramka z największym blokiem mieści się w symbolu danej wersji (tryb
+// alfanumeryczny), ramka z blokiem o bajt większym - już nie
+void blockSizeFitsVersion()
+{
+    std::mt19937 random(14);
+    for (int version : {1, 5, 10, 20, 27, 40}) {
+        for (int level = 0; level < 4; level++) {
+            const ErrorCorrection ecLevel = static_cast<ErrorCorrection>(level);
+            const int blockSize = FountainEncoder::blockSizeFor(version, ecLevel);
+            if (blockSize == 0) {
+                continue;
+            }
+
+            EncodeOptions options;
+            options.backend = EncoderBackend::Native;
+            options.ecLevel = ecLevel;
+            options.version = version;
+            const std::string message = randomMessage(random, 3 * static_cast<size_t>(blockSize) + 1);
+
+            const std::string fits = FountainEncoder(message, blockSize).frame(7);
+            CHECK(!encodeSegments({Segment{SegmentMode::Alphanumeric, fits}}, options).isNull());
+            const std::string overflows = FountainEncoder(message, blockSize + 1).frame(7);
+            CHECK(encodeSegments({Segment{SegmentMode::Alphanumeric, overflows}}, options).isNull());
+        }
+    }
+    CHECK(FountainEncoder::blockSizeFor(0, ErrorCorrection::Low) == 0);
+    CHECK(FountainEncoder::blockSizeFor(41, ErrorCorrection::Low) == 0);
+}
+
+void transferFile()
+{
+    std::string name;
+    std::string contents;
+    const std::string binary("\x00\x01\xFF plik", 8);
+    CHECK(unpackTransferFile(packTransferFile("raport.pdf", binary), name, contents));
+    CHECK(name == "raport.pdf");
+    CHECK(contents == binary);
+
+    CHECK(!unpackTransferFile(std::string(), name, contents));
+    CHECK(!unpackTransferFile(std::string("\x00\x20", 2) + "za krótko", name, contents));
+}
+
+} // namespace
+
+int main()
+{
+    test::run("przykłady Base45 z RFC 9285", base45Examples);
+    test::run("układ ramki systematycznej", systematicFrameLayout);
+    test::run("LT z gubionymi klatkami", lossyRoundTrip);
+    test::run("tylko ramki zakodowane", codedFramesOnly);
+    test::run("odrzucane ramki", rejectedFrames);
+    test::run("wrogie nagłówki ramek", hostileHeaders);
+    test::run("rozmiar bloku a wersja symbolu", blockSizeFitsVersion);
+    test::run("plik w wiadomości", transferFile);
+    return test::finish();
+}
@@ -0,0 +1,146 @@
+#include "qrcore/qr_encoder.h"
+#include "qrcore/symbol_reader.h"
+
+#include "test_support.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace qrcore;
+
+EncodeOptions nativeOptions(ErrorCorrection level, int version = 0)
+{
+    EncodeOptions options;
+    options.backend = EncoderBackend::Native;
+    options.ecLevel = level;
+    options.version = version;
+    return options;
+}
+
+std::string randomBytes(std::mt19937& random, size_t length)
+{
+    std::string bytes(length, '\0');
+    for (char& value : bytes) {
+        value = static_cast<char>(random());
+    }
+    return bytes;
+}
+
+// encode -> readSymbol: treść, wersja i poziom korekcji odczytane z siatki
+// modułów zgadzają się z kodowanymi, a korekcja RS nie ma nic do poprawienia
+void byteRoundTrip()
+{
+    std::mt19937 random(4);
+    for (int trial = 0; trial < 200; trial++) {
+        const ErrorCorrection level = static_cast<ErrorCorrection>(trial % 4);
+        const size_t length = 1 + random() % (trial % 10 == 0 ? 1200 : 80);
+        const std::string data = randomBytes(random, length);
+
+        const QRMatrix matrix = encodeSegments({Segment{SegmentMode::Byte, data}}, nativeOptions(level));
+        if (!CHECK(!matrix.isNull())) {
+            return;
+        }
+        CHECK(matrix.size() == 17 + 4 * matrix.version());
+
+        SymbolContent content;
+        if (!CHECK(readSymbol(matrix, content))) {
+            return;
+        }
+        CHECK(content.text == data);
+        CHECK(content.version == matrix.version());
+        CHECK(content.ecLevel == level);
+        CHECK(content.mask >= 0 && content.mask < 8);
+        CHECK(content.correctedCodewords == 0);
+    }
+}
+
+// Każda wersja 1-40 na każdym poziomie: rozmieszczenie bloków i wzorców
+// wyrównania jest inne dla niemal każdej wersji
+void everyVersion()
+{
+    for (int version = 1; version <= 40; version++) {
+        for (int level = 0; level < 4; level++) {
+            const std::string data = "QRCORE-" + std::to_string(version * 10 + level);
+            const QRMatrix matrix = encodeSegments({Segment{SegmentMode::Alphanumeric, data}},
+                                                   nativeOptions(static_cast<ErrorCorrection>(level), version));
+            if (!CHECK(matrix.version() == version)) {
+                return;
+            }
+
+            SymbolContent content;
+            CHECK(readSymbol(matrix, content));
+            CHECK(content.text == data);
+        }
+    }
+}
+
+// Moduły przekłamane w obszarze danych są poprawiane przez korekcję RS
+void damagedModules()
+{
+    std::mt19937 random(5);
+    const std::string data = "https://example.com/item/0123456789";
+    QRMatrix matrix = encodeSegments({Segment{SegmentMode::Byte, data}}, nativeOptions(ErrorCorrection::High));
+    if (!CHECK(!matrix.isNull())) {
+        return;
+    }
+
+    for (int k = 0; k < 6; k++) {
+        const int x = 9 + static_cast<int>(random() % (matrix.size() - 18));
+        const int y = 9 + static_cast<int>(random() % (matrix.size() - 18));
+        matrix.setModule(x, y, !matrix.module(x, y));
+    }
+
+    SymbolContent content;
+    CHECK(readSymbol(matrix, content));
+    CHECK(content.text == data);
+    CHECK(content.correctedCodewords > 0);
+}
+
+// Równoległa ocena masek wybiera tę samą maskę co sekwencyjna
+void parallelMasks()
+{
+    std::mt19937 random(6);
+    for (int trial = 0; trial < 20; trial++) {
+        const std::vector<Segment> segments = {Segment{SegmentMode::Byte, randomBytes(random, 1 + random() % 300)}};
+        EncodeOptions options = nativeOptions(static_cast<ErrorCorrection>(trial % 4));
+        const QRMatrix serial = encodeSegments(segments, options);
+        options.parallelMasks = true;
+        const QRMatrix parallel = encodeSegments(segments, options);
+
+        if (!CHECK(serial.size() == parallel.size())) {
+            return;
+        }
+        for (int y = 0; y < serial.size(); y++) {
+            for (int x = 0; x < serial.size(); x++) {
+                CHECK(serial.module(x, y) == parallel.module(x, y));
+            }
+        }
+    }
+}
+
+void capacityLimits()
+{
+    // 2953 bajty to pojemność wersji 40-L
+    CHECK(encodeSegments({Segment{SegmentMode::Byte, std::string(2953, 'a')}},
+                         nativeOptions(ErrorCorrection::Low)).version() == 40);
+    CHECK(encodeSegments({Segment{SegmentMode::Byte, std::string(2954, 'a')}},
+                         nativeOptions(ErrorCorrection::Low)).isNull());
+    // Wymuszona wersja, w której dane się nie mieszczą
+    CHECK(encodeSegments({Segment{SegmentMode::Byte, std::string(100, 'a')}},
+                         nativeOptions(ErrorCorrection::Medium, 2)).isNull());
+}
+
+} // namespace
+
+int main()
+{
+    test::run("encode -> readSymbol", byteRoundTrip);
+    test::run("wersje 1-40", everyVersion);
+    test::run("uszkodzone moduły", damagedModules);
+    test::run("równoległy wybór maski", parallelMasks);
+    test::run("granice pojemności", capacityLimits);
+    return test::finish();
+}
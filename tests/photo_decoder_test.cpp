@@ -0,0 +1,150 @@
+#include "qrcore/photo_decoder.h"
+
+#include "qrcore/multi_decoder.h"
+#include "qrcore/qr_encoder.h"
+
+#include "test_support.h"
+
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace qrcore;
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Tło zdjęcia bez kodu: plamy jasności (papier, blat) i szum matrycy
+cv::Mat texturedScene(const cv::Size& size)
+{
+    cv::Mat coarse(size.height / 16, size.width / 16, CV_32F);
+    cv::randn(coarse, 150.0, 40.0);
+    cv::Mat scene;
+    cv::resize(coarse, scene, size, 0, 0, cv::INTER_CUBIC);
+    cv::Mat noise(size, CV_32F);
+    cv::randn(noise, 0.0, 6.0);
+    scene += noise;
+    scene.convertTo(scene, CV_8U);
+    return scene;
+}
+
+// Symbol o module moduleSize pikseli z lewym górnym rogiem w origin,
+// na białej strefie ciszy (4 moduły)
+void drawCode(cv::Mat& scene, const QRMatrix& matrix, const cv::Point& origin, int moduleSize)
+{
+    const int quiet = 4 * moduleSize;
+    const int side = matrix.size() * moduleSize;
+    scene(cv::Rect(origin.x - quiet, origin.y - quiet, side + 2 * quiet, side + 2 * quiet)).setTo(cv::Scalar(255));
+    for (int y = 0; y < matrix.size(); y++) {
+        for (int x = 0; x < matrix.size(); x++) {
+            if (matrix.module(x, y)) {
+                scene(cv::Rect(origin.x + x * moduleSize, origin.y + y * moduleSize, moduleSize, moduleSize))
+                    .setTo(cv::Scalar(0));
+            }
+        }
+    }
+}
+
+std::vector<uint8_t> encodeJpeg(const cv::Mat& image)
+{
+    std::vector<uint8_t> data;
+    cv::imencode(".jpg", image, data, {cv::IMWRITE_JPEG_QUALITY, 90});
+    return data;
+}
+
+void sizeFromHeader()
+{
+    const std::vector<uint8_t> data = encodeJpeg(texturedScene(cv::Size(640, 480)));
+    cv::Size size;
+    CHECK(jpegSize(data.data(), data.size(), size));
+    CHECK(size == cv::Size(640, 480));
+
+    CHECK(!jpegSize(data.data(), 2, size));
+    std::vector<uint8_t> png;
+    cv::imencode(".png", texturedScene(cv::Size(64, 48)), png);
+    CHECK(!jpegSize(png.data(), png.size(), size));
+}
+
+// 24 Mpx, kod o boku ~1400 px: odczyt już w pierwszym przebiegu (1/4),
+// narożniki w układzie pełnego obrazu
+void codeInReducedPass()
+{
+    const std::string text = "https://example.com/paczka/2024/000123";
+    const QRMatrix matrix = encode(text);
+    if (!CHECK(!matrix.isNull())) {
+        return;
+    }
+
+    cv::Mat scene = texturedScene(cv::Size(6000, 4000));
+    const int moduleSize = 1400 / matrix.size();
+    const cv::Point origin(2000, 1200);
+    drawCode(scene, matrix, origin, moduleSize);
+
+    PhotoDecodeInfo info;
+    const std::vector<DecodeResult> found = decodePhoto(encodeJpeg(scene), PhotoDecodeOptions(), &info);
+    if (!CHECK(found.size() == 1)) {
+        return;
+    }
+    CHECK(found[0].text == text);
+    CHECK(info.reduction == 4);
+    CHECK(info.passes == 1);
+    CHECK(info.fullSize == scene.size());
+
+    cv::Point2f center(0.0f, 0.0f);
+    for (const cv::Point2f& point : found[0].corners) {
+        center += point * 0.25f;
+    }
+    const float expected = matrix.size() * moduleSize * 0.5f;
+    CHECK(std::abs(center.x - (origin.x + expected)) < moduleSize);
+    CHECK(std::abs(center.y - (origin.y + expected)) < moduleSize);
+}
+
+// Zdjęcie bez kodu przechodzi wszystkie przebiegi, ale przeszukanie kadru
+// w kafelkach wykonuje tylko ostatni - całość kosztuje niewiele więcej niż
+// jedno pełne przeszukanie (dekompresja + decodeMulti)
+void noCodeTiming()
+{
+    const std::vector<uint8_t> data = encodeJpeg(texturedScene(cv::Size(6000, 4000)));
+
+    double photoMs = 0.0;
+    double fullMs = 0.0;
+    for (int run = 0; run < 2; run++) {
+        PhotoDecodeInfo info;
+        Clock::time_point start = Clock::now();
+        CHECK(decodePhoto(data, PhotoDecodeOptions(), &info).empty());
+        const double photo = millisecondsSince(start);
+        CHECK(info.passes == 3);
+        CHECK(info.fullSize == cv::Size(6000, 4000));
+
+        start = Clock::now();
+        CHECK(decodeMulti(cv::imdecode(data, cv::IMREAD_GRAYSCALE)).empty());
+        const double full = millisecondsSince(start);
+
+        photoMs = run == 0 ? photo : std::min(photoMs, photo);
+        fullMs = run == 0 ? full : std::min(fullMs, full);
+    }
+
+    std::fprintf(stderr, "bez kodu, 24 Mpx: decodePhoto %.0f ms, pełny kadr %.0f ms\n", photoMs, fullMs);
+    CHECK(photoMs < 1.5 * fullMs);
+}
+
+} // namespace
+
+int main()
+{
+    test::run("wymiary z nagłówka JPEG", sizeFromHeader);
+    test::run("kod w pomniejszeniu", codeInReducedPass);
+    test::run("czas zdjęcia bez kodu", noCodeTiming);
+    return test::finish();
+}
@@ -0,0 +1,134 @@
+#include "qrcore/reed_solomon.h"
+
+#include "test_support.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace qrcore;
+
+// Długości bloków korekcyjnych używane przez poziomy QR (wersje 1-40)
+const int kEcLengths[] = {7, 10, 13, 15, 16, 17, 18, 20, 22, 24, 26, 28, 30};
+
+std::vector<uint8_t> encodeBlock(const std::vector<uint8_t>& data, int ecLength)
+{
+    std::vector<uint8_t> block(data);
+    block.resize(data.size() + ecLength);
+    CHECK(rsEncode(data.data(), data.size(), ecLength, block.data() + data.size()));
+    return block;
+}
+
+// Przykład z ISO/IEC 18004 (załącznik I): "01234567", wersja 1-M
+void knownCodewords()
+{
+    const std::vector<uint8_t> data = {16, 32, 12, 86, 97, 128, 236, 17, 236, 17, 236, 17, 236, 17, 236, 17};
+    const std::vector<uint8_t> expected = {165, 36, 212, 193, 237, 54, 199, 135, 44, 85};
+
+    const std::vector<uint8_t> block = encodeBlock(data, 10);
+    CHECK(std::vector<uint8_t>(block.begin() + data.size(), block.end()) == expected);
+}
+
+void unsupportedLength()
+{
+    const uint8_t data[4] = {1, 2, 3, 4};
+    uint8_t ec[kMaxEcCodewords] = {};
+    CHECK(!rsEncode(data, sizeof(data), 11, ec));
+    CHECK(!rsEncode(data, sizeof(data), kMaxEcCodewords + 2, ec));
+}
+
+void cleanBlock()
+{
+    std::mt19937 random(1);
+    for (int ecLength : kEcLengths) {
+        std::vector<uint8_t> data(40);
+        for (uint8_t& value : data) {
+            value = static_cast<uint8_t>(random());
+        }
+        std::vector<uint8_t> block = encodeBlock(data, ecLength);
+        const std::vector<uint8_t> original = block;
+        CHECK(rsDecode(block.data(), block.size(), ecLength) == 0);
+        CHECK(block == original);
+    }
+}
+
+// Do ecLength/2 przekłamanych słów w losowych miejscach - blok wraca do
+// pierwotnej postaci, a wynik to liczba poprawionych słów
+void correctsInjectedErrors()
+{
+    std::mt19937 random(2);
+    for (int trial = 0; trial < 2000; trial++) {
+        const int ecLength = kEcLengths[trial % (sizeof(kEcLengths) / sizeof(kEcLengths[0]))];
+        const int dataLength = 1 + static_cast<int>(random() % (255 - ecLength));
+        std::vector<uint8_t> data(dataLength);
+        for (uint8_t& value : data) {
+            value = static_cast<uint8_t>(random());
+        }
+        const std::vector<uint8_t> original = encodeBlock(data, ecLength);
+
+        std::vector<uint8_t> block = original;
+        const int errors = static_cast<int>(random() % (ecLength / 2 + 1));
+        std::vector<bool> used(block.size(), false);
+        for (int k = 0; k < errors;) {
+            const size_t position = random() % block.size();
+            if (used[position]) {
+                continue;
+            }
+            used[position] = true;
+            block[position] ^= static_cast<uint8_t>(1 + random() % 255);
+            k++;
+        }
+
+        if (!CHECK(rsDecode(block.data(), block.size(), ecLength) == errors)) {
+            return;
+        }
+        CHECK(block == original);
+    }
+}
+
+// Więcej błędów niż ecLength/2: korekcja może się nie udać (-1, blok bez
+// zmian) albo dać inne poprawne słowo kodowe - nigdy nie zostawia bloku
+// zmienionego bez zgłoszenia porażki
+void rejectsTooManyErrors()
+{
+    std::mt19937 random(3);
+    int rejected = 0;
+    for (int trial = 0; trial < 500; trial++) {
+        const int ecLength = 10;
+        std::vector<uint8_t> data(16);
+        for (uint8_t& value : data) {
+            value = static_cast<uint8_t>(random());
+        }
+        const std::vector<uint8_t> original = encodeBlock(data, ecLength);
+
+        std::vector<uint8_t> block = original;
+        for (int k = 0; k < ecLength / 2 + 1; k++) {
+            block[k * 4] ^= static_cast<uint8_t>(1 + random() % 255);
+        }
+        const std::vector<uint8_t> corrupted = block;
+
+        const int corrected = rsDecode(block.data(), block.size(), ecLength);
+        if (corrected < 0) {
+            CHECK(block == corrupted);
+            rejected++;
+        } else {
+            CHECK(block != original);
+            CHECK(encodeBlock(std::vector<uint8_t>(block.begin(), block.begin() + data.size()), ecLength) == block);
+        }
+    }
+    CHECK(rejected > 0);
+}
+
+} // namespace
+
+int main()
+{
+    test::run("znane słowa korekcyjne", knownCodewords);
+    test::run("nieobsługiwana długość", unsupportedLength);
+    test::run("blok bez błędów", cleanBlock);
+    test::run("korekcja wstrzykniętych błędów", correctsInjectedErrors);
+    test::run("zbyt wiele błędów", rejectsTooManyErrors);
+    return test::finish();
+}
@@ -0,0 +1,197 @@
+#include "qrcore/segmenter.h"
+#include "qrcore/symbol_reader.h"
+
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace qrcore;
+
+const char kAlphanumeric[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+
+std::string joined(const SegmentPlan& plan)
+{
+    std::string data;
+    for (const Segment& segment : plan.segments) {
+        data += segment.data;
+    }
+    return data;
+}
+
+// Długość strumienia bitów segmentów w wersjach 1-9 (ISO/IEC 18004, 7.4)
+long bitLength(const std::vector<Segment>& segments)
+{
+    long bits = 0;
+    for (const Segment& segment : segments) {
+        const long length = static_cast<long>(segment.data.size());
+        switch (segment.mode) {
+            case SegmentMode::Numeric:
+                bits += 4 + 10 + length / 3 * 10 + (length % 3 == 2 ? 7 : length % 3 == 1 ? 4 : 0);
+                break;
+            case SegmentMode::Alphanumeric:
+                bits += 4 + 9 + length / 2 * 11 + (length % 2) * 6;
+                break;
+            default:
+                bits += 4 + 8 + length * 8;
+                break;
+        }
+    }
+    return bits;
+}
+
+bool fitsMode(char c, SegmentMode mode)
+{
+    switch (mode) {
+        case SegmentMode::Numeric:
+            return c >= '0' && c <= '9';
+        case SegmentMode::Alphanumeric:
+            return c != '\0' && std::strchr(kAlphanumeric, c) != nullptr;
+        default:
+            return true;
+    }
+}
+
+void singleModes()
+{
+    SegmentPlan plan = planSegments("01234567");
+    CHECK(plan.segments.size() == 1 && plan.segments[0].mode == SegmentMode::Numeric);
+    CHECK(plan.bits == 41);
+    CHECK(plan.version == 1);
+
+    plan = planSegments("HELLO WORLD");
+    CHECK(plan.segments.size() == 1 && plan.segments[0].mode == SegmentMode::Alphanumeric);
+    CHECK(plan.bits == 74);
+
+    plan = planSegments("hello");
+    CHECK(plan.segments.size() == 1 && plan.segments[0].mode == SegmentMode::Byte);
+    CHECK(plan.bits == 52);
+
+    plan = planSegments("");
+    CHECK(plan.segments.empty());
+    CHECK(plan.version == 0);
+}
+
+// Dla krótkich tekstów wynik porównywany z przeglądem wszystkich
+// przypisań trybów Numeric/Alphanumeric/Byte do kolejnych znaków
+void optimalAgainstBruteForce()
+{
+    const char pool[] = {'0', '7', 'A', 'Z', ' ', '%', 'a', '~'};
+    std::mt19937 random(7);
+    for (int trial = 0; trial < 1500; trial++) {
+        const int length = 1 + static_cast<int>(random() % 8);
+        std::string data;
+        for (int i = 0; i < length; i++) {
+            data += pool[random() % sizeof(pool)];
+        }
+
+        long best = -1;
+        int assignments = 1;
+        for (int i = 0; i < length; i++) {
+            assignments *= 3;
+        }
+        for (int code = 0; code < assignments; code++) {
+            std::vector<Segment> segments;
+            bool valid = true;
+            int rest = code;
+            for (int i = 0; i < length && valid; i++, rest /= 3) {
+                const SegmentMode mode = static_cast<SegmentMode>(rest % 3);
+                valid = fitsMode(data[i], mode);
+                if (segments.empty() || segments.back().mode != mode) {
+                    segments.push_back(Segment{mode, std::string()});
+                }
+                segments.back().data += data[i];
+            }
+            if (valid) {
+                const long bits = bitLength(segments);
+                best = best < 0 ? bits : std::min(best, bits);
+            }
+        }
+
+        const SegmentPlan plan = planSegments(data);
+        if (!CHECK(plan.bits == best)) {
+            std::fprintf(stderr, "  \"%s\": %ld zamiast %ld\n", data.c_str(), plan.bits, best);
+            return;
+        }
+        CHECK(plan.bits == bitLength(plan.segments));
+        CHECK(joined(plan) == data);
+    }
+}
+
+// Plan mieści się w wybranej wersji, ale nie w poprzedniej, a symbol
+// zakodowany z planu odczytuje się jako pierwotny tekst
+void smallestVersionRoundTrip()
+{
+    std::mt19937 random(8);
+    for (int trial = 0; trial < 150; trial++) {
+        std::string data;
+        const int runs = 1 + static_cast<int>(random() % 12);
+        for (int run = 0; run < runs; run++) {
+            const int kind = static_cast<int>(random() % 3);
+            const int length = 1 + static_cast<int>(random() % (trial % 10 == 0 ? 400 : 30));
+            for (int i = 0; i < length; i++) {
+                if (kind == 0) {
+                    data += static_cast<char>('0' + random() % 10);
+                } else if (kind == 1) {
+                    data += kAlphanumeric[random() % 45];
+                } else {
+                    data += "\xC5\xBC";  // "ż" w UTF-8 - tylko tryb Byte
+                }
+            }
+        }
+
+        EncodeOptions options;
+        options.backend = EncoderBackend::Native;
+        options.ecLevel = static_cast<ErrorCorrection>(trial % 4);
+        const SegmentPlan plan = planSegments(data, options);
+        if (!CHECK(plan.version > 0)) {
+            continue;
+        }
+
+        options.version = plan.version;
+        const QRMatrix matrix = encodeSegments(plan.segments, options);
+        SymbolContent content;
+        CHECK(readSymbol(matrix, content));
+        CHECK(content.text == data);
+
+        if (plan.version > 1) {
+            options.version = plan.version - 1;
+            CHECK(encodeSegments(plan.segments, options).isNull());
+        }
+    }
+}
+
+void versionOptions()
+{
+    const std::string digits(3000, '1');
+    EncodeOptions options;
+    CHECK(planSegments(digits, options).version > 20);
+
+    // Wymuszona wersja bez miejsca na dane
+    options.version = 5;
+    CHECK(planSegments(digits, options).version == 0);
+
+    // Bity zarezerwowane (np. nagłówek Structured Append) podnoszą wersję
+    options = EncodeOptions();
+    options.ecLevel = ErrorCorrection::Low;
+    const std::string data(17, 'a');  // dokładnie pojemność wersji 1-L w trybie Byte
+    CHECK(planSegments(data, options).version == 1);
+    CHECK(planSegments(data, options, 20).version == 2);
+}
+
+} // namespace
+
+int main()
+{
+    test::run("pojedyncze tryby", singleModes);
+    test::run("optymalność podziału", optimalAgainstBruteForce);
+    test::run("najmniejsza wersja i odczyt", smallestVersionRoundTrip);
+    test::run("wersja wymuszona i bity zarezerwowane", versionOptions);
+    return test::finish();
+}
@@ -0,0 +1,231 @@
+#include "qrcore/structured_append.h"
+#include "qrcore/symbol_reader.h"
+
+#include "test_support.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace qrcore;
+
+EncodeOptions nativeOptions(ErrorCorrection level)
+{
+    EncodeOptions options;
+    options.backend = EncoderBackend::Native;
+    options.ecLevel = level;
+    return options;
+}
+
+// Tekst z przebiegami cyfr, znaków alfanumerycznych, małych liter
+// i wielobajtowych znaków UTF-8 - granice części muszą wypadać między znakami
+std::string mixedText(std::mt19937& random, size_t length)
+{
+    const char alphanumeric[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+    std::string text;
+    while (text.size() < length) {
+        const int kind = static_cast<int>(random() % 4);
+        const int run = 1 + static_cast<int>(random() % 30);
+        for (int i = 0; i < run; i++) {
+            switch (kind) {
+                case 0:
+                    text += static_cast<char>('0' + random() % 10);
+                    break;
+                case 1:
+                    text += alphanumeric[random() % 45];
+                    break;
+                case 2:
+                    text += static_cast<char>('a' + random() % 26);
+                    break;
+                default:
+                    text += "\xE2\x82\xAC";  // "€"
+                    break;
+            }
+        }
+    }
+    return text;
+}
+
+QRMatrix transposed(const QRMatrix& matrix)
+{
+    QRMatrix result(matrix.size(), matrix.version());
+    for (int y = 0; y < matrix.size(); y++) {
+        for (int x = 0; x < matrix.size(); x++) {
+            result.setModule(y, x, matrix.module(x, y));
+        }
+    }
+    return result;
+}
+
+// Odczyt każdej części (także z uszkodzonymi modułami i odbitej lustrzanie)
+// - wyniki dekodowania w przypadkowej kolejności
+std::vector<DecodeResult> readSeries(const std::vector<QRMatrix>& symbols, std::mt19937& random)
+{
+    std::vector<DecodeResult> results;
+    for (size_t i = 0; i < symbols.size(); i++) {
+        QRMatrix matrix = symbols[i];
+        const int flips = static_cast<int>(random() % 3);
+        for (int k = 0; k < flips; k++) {
+            const int x = 9 + static_cast<int>(random() % (matrix.size() - 18));
+            const int y = 9 + static_cast<int>(random() % (matrix.size() - 18));
+            matrix.setModule(x, y, !matrix.module(x, y));
+        }
+        if (random() % 3 == 0) {
+            matrix = transposed(matrix);
+        }
+
+        SymbolContent content;
+        if (!CHECK(readSymbol(matrix, content))) {
+            return {};
+        }
+        CHECK(content.structuredAppend.index == static_cast<int>(i));
+        CHECK(content.structuredAppend.total == static_cast<int>(symbols.size()));
+
+        DecodeResult result;
+        result.text = content.text;
+        result.structuredAppend = content.structuredAppend;
+        result.corners = {cv::Point2f(static_cast<float>(i), 0.0f)};
+        results.push_back(result);
+    }
+    std::shuffle(results.begin(), results.end(), random);
+    return results;
+}
+
+void seriesRoundTrip()
+{
+    std::mt19937 random(9);
+    int series = 0;
+    for (int trial = 0; trial < 120; trial++) {
+        const EncodeOptions options = nativeOptions(static_cast<ErrorCorrection>(trial % 4));
+        const int maxVersion = 1 + static_cast<int>(random() % 12);
+        const std::string data = mixedText(random, 1 + random() % 2000);
+
+        const std::vector<SegmentPlan> plans = splitStructuredAppend(data, maxVersion, options);
+        const std::vector<QRMatrix> symbols = encodeStructuredAppend(data, maxVersion, options);
+        if (plans.empty()) {
+            CHECK(symbols.empty());
+            continue;
+        }
+        if (!CHECK(symbols.size() == plans.size())) {
+            return;
+        }
+        for (const QRMatrix& symbol : symbols) {
+            CHECK(symbol.version() <= maxVersion);
+        }
+        series += symbols.size() > 1;
+
+        const std::vector<DecodeResult> results = readSeries(symbols, random);
+        const std::vector<DecodeResult> merged = mergeStructuredAppend(results);
+        if (CHECK(merged.size() == 1)) {
+            CHECK(merged[0].text == data);
+            CHECK(merged[0].corners == std::vector<cv::Point2f>{cv::Point2f(0.0f, 0.0f)});
+        }
+    }
+    CHECK(series > 20);
+}
+
+// Powtórzone części nie zmieniają stanu serii; wiadomość pojawia się
+// dopiero po ostatniej brakującej części
+void collectorDuplicates()
+{
+    std::mt19937 random(10);
+    const std::string data = mixedText(random, 600);
+    const std::vector<QRMatrix> symbols = encodeStructuredAppend(data, 4, nativeOptions(ErrorCorrection::Medium));
+    if (!CHECK(symbols.size() > 2)) {
+        return;
+    }
+
+    const std::vector<DecodeResult> results = readSeries(symbols, random);
+    StructuredAppendCollector collector;
+    DecodeResult message;
+    for (size_t i = 0; i < results.size(); i++) {
+        const StructuredAppendCollector::Progress first = collector.add(results[i]);
+        const StructuredAppendCollector::Progress again = collector.add(results[i]);
+        CHECK(first.received == static_cast<int>(i) + 1);
+        CHECK(again.received == first.received);
+        CHECK(first.total == static_cast<int>(symbols.size()));
+        CHECK(collector.takeComplete(message) == (i + 1 == results.size()));
+    }
+    CHECK(message.text == data);
+    CHECK(!collector.takeComplete(message));
+
+    DecodeResult plain;
+    plain.text = "bez nagłówka";
+    const StructuredAppendCollector::Progress progress = collector.add(plain);
+    CHECK(progress.received == 0 && progress.total == 0);
+}
+
+// Seria z częścią o innych bajtach danych nie przechodzi kontroli parzystości,
+// a niekompletna seria zostaje w wynikach jako osobne części
+void parityAndIncompleteSeries()
+{
+    std::mt19937 random(11);
+    const std::string data = mixedText(random, 500);
+    const std::vector<QRMatrix> symbols = encodeStructuredAppend(data, 3, nativeOptions(ErrorCorrection::Low));
+    if (!CHECK(symbols.size() > 2)) {
+        return;
+    }
+
+    std::vector<DecodeResult> results = readSeries(symbols, random);
+    results[0].structuredAppend.dataParity ^= 0x5A;
+    StructuredAppendCollector collector;
+    DecodeResult message;
+    for (const DecodeResult& result : results) {
+        collector.add(result);
+    }
+    CHECK(!collector.takeComplete(message));
+
+    results = readSeries(symbols, random);
+    results.pop_back();
+    CHECK(mergeStructuredAppend(results).size() == results.size());
+}
+
+void tooManySymbols()
+{
+    const std::string data(17 * 2 * (kMaxStructuredAppendSymbols + 1), 'a');
+    CHECK(splitStructuredAppend(data, 1, nativeOptions(ErrorCorrection::Low)).empty());
+    CHECK(encodeStructuredAppend(data, 1, nativeOptions(ErrorCorrection::Low)).empty());
+}
+
+// Obraz "straight" (piksel na moduł) z powrotem w siatkę modułów
+void straightImage()
+{
+    const QRMatrix matrix = encode("https://example.com/", nativeOptions(ErrorCorrection::Quartile));
+    if (!CHECK(!matrix.isNull())) {
+        return;
+    }
+
+    cv::Mat straight(matrix.size(), matrix.size(), CV_8UC1);
+    for (int y = 0; y < matrix.size(); y++) {
+        uint8_t* row = straight.ptr<uint8_t>(y);
+        for (int x = 0; x < matrix.size(); x++) {
+            row[x] = matrix.module(x, y) ? 20 : 235;
+        }
+    }
+
+    const QRMatrix grid = gridFromStraight(straight);
+    if (!CHECK(grid.size() == matrix.size() && grid.version() == matrix.version())) {
+        return;
+    }
+    SymbolContent content;
+    CHECK(readSymbol(grid, content));
+    CHECK(content.text == "https://example.com/");
+    CHECK(!content.structuredAppend.isValid());
+
+    CHECK(gridFromStraight(cv::Mat(22, 22, CV_8UC1)).isNull());
+}
+
+} // namespace
+
+int main()
+{
+    test::run("seria -> readSymbol -> złożenie", seriesRoundTrip);
+    test::run("powtórzone części", collectorDuplicates);
+    test::run("parzystość i niekompletna seria", parityAndIncompleteSeries);
+    test::run("ponad 16 symboli", tooManySymbols);
+    test::run("obraz straight", straightImage);
+    return test::finish();
+}
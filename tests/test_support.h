@@ -0,0 +1,51 @@
+#ifndef QRCORE_TEST_SUPPORT_H
+#define QRCORE_TEST_SUPPORT_H
+
+#include <cstdio>
+#include <string>
+
+// Minimalne wsparcie testów: bez zewnętrznego frameworka, każdy plik testu
+// to osobny program, a jego kod wyjścia odczytuje ctest
+namespace test {
+
+inline int& failures()
+{
+    static int count = 0;
+    return count;
+}
+
+inline bool check(bool condition, const char* expression, const char* file, int line)
+{
+    if (!condition) {
+        std::fprintf(stderr, "%s:%d: niespełniony warunek: %s\n", file, line, expression);
+        ++failures();
+    }
+    return condition;
+}
+
+// Uruchamia przypadek testowy; zwraca false, gdy którykolwiek warunek zawiódł
+template <typename Function>
+bool run(const char* name, Function function)
+{
+    const int before = failures();
+    function();
+    const bool passed = failures() == before;
+    std::fprintf(stderr, "[%s] %s\n", passed ? " OK " : "BŁĄD", name);
+    return passed;
+}
+
+inline int finish()
+{
+    if (failures() > 0) {
+        std::fprintf(stderr, "Niespełnione warunki: %d\n", failures());
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace test
+
+// Warunek testu; wartość wyrażenia pozwala przerwać przypadek: if (!CHECK(...)) return;
+#define CHECK(condition) ::test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+#endif // QRCORE_TEST_SUPPORT_H
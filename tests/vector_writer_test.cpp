@@ -0,0 +1,230 @@
+#include "qrcore/vector_writer.h"
+
+#include "qrcore/qr_encoder.h"
+
+#include "test_support.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace qrcore;
+
+using Polygon = std::vector<OutlinePoint>;
+
+QRMatrix fromRows(const std::vector<std::string>& rows)
+{
+    QRMatrix matrix(static_cast<int>(rows.size()), 0);
+    for (int y = 0; y < matrix.size(); y++) {
+        for (int x = 0; x < matrix.size(); x++) {
+            matrix.setModule(x, y, rows[y][x] == '#');
+        }
+    }
+    return matrix;
+}
+
+std::vector<Polygon> outlines(const QRMatrix& matrix)
+{
+    std::vector<Polygon> polygons;
+    traceOutlines(matrix, [&](const Polygon& corners) { polygons.push_back(corners); });
+    return polygons;
+}
+
+// Liczba obrotów konturów wokół środka modułu (x + 1/2, y + 1/2): półprosta
+// w prawo przecina tylko krawędzie pionowe; krawędź w dół liczy się +1, więc
+// obrys zgodny z ruchem wskazówek zegara (oś Y w dół) daje +1
+int winding(const std::vector<Polygon>& polygons, int x, int y)
+{
+    int count = 0;
+    for (const Polygon& polygon : polygons) {
+        for (size_t i = 0; i < polygon.size(); i++) {
+            const OutlinePoint& from = polygon[i];
+            const OutlinePoint& to = polygon[(i + 1) % polygon.size()];
+            if (from.x != to.x || from.x <= x) {
+                continue;
+            }
+            if (from.y <= y && y < to.y) {
+                count++;
+            } else if (to.y <= y && y < from.y) {
+                count--;
+            }
+        }
+    }
+    return count;
+}
+
+// Wielokąty wypełnione z powrotem w siatkę modułów muszą dać macierz:
+// liczba obrotów 1 dla modułu ciemnego, 0 dla jasnego (także poza symbolem).
+// Każdy wielokąt ma same narożniki: krawędzie na przemian poziome i pionowe.
+bool fillsBack(const QRMatrix& matrix)
+{
+    const std::vector<Polygon> polygons = outlines(matrix);
+    bool ok = true;
+    for (const Polygon& polygon : polygons) {
+        ok &= CHECK(polygon.size() >= 4 && polygon.size() % 2 == 0);
+        for (size_t i = 0; i < polygon.size(); i++) {
+            const OutlinePoint& a = polygon[i];
+            const OutlinePoint& b = polygon[(i + 1) % polygon.size()];
+            const OutlinePoint& c = polygon[(i + 2) % polygon.size()];
+            ok &= CHECK((a.x == b.x) != (a.y == b.y));
+            ok &= CHECK((a.x == b.x) != (b.x == c.x));
+            ok &= CHECK(a.x >= 0 && a.y >= 0 && a.x <= matrix.size() && a.y <= matrix.size());
+        }
+    }
+
+    for (int y = -1; y <= matrix.size(); y++) {
+        for (int x = -1; x <= matrix.size(); x++) {
+            const bool dark = x >= 0 && y >= 0 && x < matrix.size() && y < matrix.size() && matrix.module(x, y);
+            if (!CHECK(winding(polygons, x, y) == (dark ? 1 : 0))) {
+                std::fprintf(stderr, "  moduł (%d, %d)\n", x, y);
+                return false;
+            }
+        }
+    }
+    return ok;
+}
+
+void singleShapes()
+{
+    CHECK(outlines(QRMatrix()).empty());
+    CHECK(outlines(fromRows({"...", "...", "..."})).empty());
+
+    const std::vector<Polygon> single = outlines(fromRows({"#"}));
+    if (CHECK(single.size() == 1 && single[0].size() == 4)) {
+        // Zgodnie z ruchem wskazówek zegara od lewego górnego narożnika
+        CHECK(single[0][0].x == 0 && single[0][0].y == 0);
+        CHECK(single[0][1].x == 1 && single[0][1].y == 0);
+        CHECK(single[0][2].x == 1 && single[0][2].y == 1);
+        CHECK(single[0][3].x == 0 && single[0][3].y == 1);
+    }
+
+    // Pierścień: obrys zewnętrzny i otwór, wyspa w otworze
+    const QRMatrix ring = fromRows({"#####", "#...#", "#.#.#", "#...#", "#####"});
+    CHECK(outlines(ring).size() == 3);
+    fillsBack(ring);
+    fillsBack(fromRows({"####", "####", "####", "####"}));
+    fillsBack(fromRows({"##..", "#...", "...#", "..##"}));
+}
+
+// Moduły stykające się tylko narożnikiem są osobnymi wielokątami - kontur
+// nie przechodzi przez wspólny wierzchołek na drugą stronę
+void diagonalTouch()
+{
+    const QRMatrix diagonal = fromRows({"#..", ".#.", "..#"});
+    CHECK(outlines(diagonal).size() == 3);
+    fillsBack(diagonal);
+
+    const QRMatrix antiDiagonal = fromRows({"..#", ".#.", "#.."});
+    CHECK(outlines(antiDiagonal).size() == 3);
+    fillsBack(antiDiagonal);
+
+    // Otwory stykające się narożnikiem wewnątrz ciemnego obszaru
+    fillsBack(fromRows({"#####", "#.###", "##.##", "###.#", "#####"}));
+    fillsBack(fromRows({"####", "#.##", "##.#", "####"}));
+}
+
+void checkerboard()
+{
+    for (int size : {2, 5, 8}) {
+        QRMatrix board(size, 0);
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                board.setModule(x, y, (x + y) % 2 == 0);
+            }
+        }
+        CHECK(outlines(board).size() == static_cast<size_t>((size * size + 1) / 2));
+        fillsBack(board);
+    }
+}
+
+void randomMatrices()
+{
+    std::mt19937 random(21);
+    for (int size : {1, 2, 3, 7, 21, 64, 65, 177}) {
+        for (int density : {10, 50, 90}) {
+            QRMatrix matrix(size, 0);
+            for (int y = 0; y < size; y++) {
+                for (int x = 0; x < size; x++) {
+                    matrix.setModule(x, y, static_cast<int>(random() % 100) < density);
+                }
+            }
+            if (!fillsBack(matrix)) {
+                std::fprintf(stderr, "  bok %d, gęstość %d%%\n", size, density);
+                return;
+            }
+        }
+    }
+
+    EncodeOptions options;
+    options.backend = EncoderBackend::Native;
+    fillsBack(encode("https://example.com/kontury", options));
+}
+
+// Przesunięcia w tablicy xref wskazują nagłówki obiektów, /Length (obiekt 5)
+// to dokładna długość strumienia, startxref wskazuje tablicę
+void pdfBookkeeping()
+{
+    EncodeOptions encodeOptions;
+    encodeOptions.backend = EncoderBackend::Native;
+    const QRMatrix matrix = encode("PDF z tablicą xref", encodeOptions);
+
+    for (bool background : {true, false}) {
+        VectorOptions options;
+        options.background = background;
+        options.moduleSize = 2.5;
+        std::ostringstream stream;
+        if (!CHECK(writeVector(matrix, VectorFormat::Pdf, stream, options))) {
+            return;
+        }
+        const std::string pdf = stream.str();
+
+        const size_t startxref = pdf.rfind("startxref\n");
+        if (!CHECK(startxref != std::string::npos)) {
+            return;
+        }
+        const size_t xref = std::strtoull(pdf.c_str() + startxref + 10, nullptr, 10);
+        if (!CHECK(pdf.compare(xref, 9, "xref\n0 6\n") == 0)) {
+            return;
+        }
+
+        // Wpisy po 20 bajtów: obiekt 0 wolny, 1-5 w użyciu
+        const size_t entries = xref + 9;
+        CHECK(pdf.compare(entries, 20, "0000000000 65535 f \n") == 0);
+        for (int object = 1; object <= 5; object++) {
+            const std::string entry = pdf.substr(entries + 20 * object, 20);
+            CHECK(entry.compare(10, 10, " 00000 n \n") == 0);
+            const size_t offset = std::strtoull(entry.c_str(), nullptr, 10);
+            const std::string header = std::to_string(object) + " 0 obj\n";
+            CHECK(pdf.compare(offset, header.size(), header) == 0);
+        }
+        CHECK(pdf.compare(entries + 120, 8, "trailer\n") == 0);
+        CHECK(pdf.find("/Size 6 /Root 1 0 R") != std::string::npos);
+
+        const size_t streamStart = pdf.find("stream\n") + 7;
+        const size_t streamEnd = pdf.find("\nendstream");
+        const size_t lengthObject = pdf.find("5 0 obj\n");
+        if (!CHECK(streamEnd != std::string::npos && lengthObject != std::string::npos)) {
+            return;
+        }
+        const size_t length = std::strtoull(pdf.c_str() + lengthObject + 8, nullptr, 10);
+        CHECK(length == streamEnd - streamStart);
+        CHECK(pdf.compare(pdf.size() - 6, 6, "%%EOF\n") == 0);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    test::run("proste kształty", singleShapes);
+    test::run("moduły stykające się narożnikiem", diagonalTouch);
+    test::run("szachownica", checkerboard);
+    test::run("losowe macierze i symbol", randomMatrices);
+    test::run("tablica xref i /Length w PDF", pdfBookkeeping);
+    return test::finish();
+}